@@ -26,16 +26,32 @@ OUTPUT_PATH="../build_resources/$PLATFORM/core_resources/shaders"
 
 echo "Start compiling shaders for ${PLATFORM} ${BACKENDS}"
 
+SHADERS=()
+
 Compile()
 {
     outputPath="$OUTPUT_PATH/$1"
     inputPath="$INPUT_PATH/$1.hlsl"
 
+    if [[ ! " ${SHADERS[*]} " =~ " $1 " ]]; then
+        SHADERS+=("$1")
+    fi
+
     for backend in "${BACKENDS[@]}"; do
         $EXECUTABLE "-backend" $backend "-output" $outputPath "-input" $inputPath "-defines" $2
     done
 }
 
+# each package is written once, after all variants of the shader are compiled
+Package()
+{
+    for shader in "${SHADERS[@]}"; do
+        for backend in "${BACKENDS[@]}"; do
+            $EXECUTABLE "-backend" $backend "-output" "$OUTPUT_PATH/$shader" "-package"
+        done
+    done
+}
+
 Compile blit
 
 Compile fallback
@@ -127,6 +143,8 @@ Compile ui/maskStencil
 
 Compile post_process
 
+Package
+
 echo "Finished compiling shaders for ${PLATFORM} ${BACKENDS}";
 if [ -z "$1" ]; then
     read _
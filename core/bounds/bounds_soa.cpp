@@ -0,0 +1,56 @@
+#include "bounds_soa.h"
+#include "bounds.h"
+
+void BoundsSoA::Add(const Bounds& bounds)
+{
+    MinX.push_back(bounds.Min.x);
+    MinY.push_back(bounds.Min.y);
+    MinZ.push_back(bounds.Min.z);
+    MaxX.push_back(bounds.Max.x);
+    MaxY.push_back(bounds.Max.y);
+    MaxZ.push_back(bounds.Max.z);
+}
+
+void BoundsSoA::Set(size_t index, const Bounds& bounds)
+{
+    MinX[index] = bounds.Min.x;
+    MinY[index] = bounds.Min.y;
+    MinZ[index] = bounds.Min.z;
+    MaxX[index] = bounds.Max.x;
+    MaxY[index] = bounds.Max.y;
+    MaxZ[index] = bounds.Max.z;
+}
+
+void BoundsSoA::RemoveSwapBack(size_t index)
+{
+    for (std::vector<float>* values : {&MinX, &MinY, &MinZ, &MaxX, &MaxY, &MaxZ})
+    {
+        (*values)[index] = values->back();
+        values->pop_back();
+    }
+}
+
+void BoundsSoA::Reserve(size_t count)
+{
+    MinX.reserve(count);
+    MinY.reserve(count);
+    MinZ.reserve(count);
+    MaxX.reserve(count);
+    MaxY.reserve(count);
+    MaxZ.reserve(count);
+}
+
+void BoundsSoA::Clear()
+{
+    MinX.clear();
+    MinY.clear();
+    MinZ.clear();
+    MaxX.clear();
+    MaxY.clear();
+    MaxZ.clear();
+}
+
+size_t BoundsSoA::Size() const
+{
+    return MinX.size();
+}
@@ -0,0 +1,28 @@
+#ifndef RENDER_ENGINE_BOUNDS_SOA_H
+#define RENDER_ENGINE_BOUNDS_SOA_H
+
+#include <cstddef>
+#include <vector>
+
+struct Bounds;
+
+// Bounds stored as separate component arrays for batched processing
+struct BoundsSoA
+{
+    std::vector<float> MinX;
+    std::vector<float> MinY;
+    std::vector<float> MinZ;
+    std::vector<float> MaxX;
+    std::vector<float> MaxY;
+    std::vector<float> MaxZ;
+
+    void Add(const Bounds& bounds);
+    void Set(size_t index, const Bounds& bounds);
+    // moves last bounds to index, order of bounds is not preserved
+    void RemoveSwapBack(size_t index);
+    void Reserve(size_t count);
+    void Clear();
+    size_t Size() const;
+};
+
+#endif //RENDER_ENGINE_BOUNDS_SOA_H
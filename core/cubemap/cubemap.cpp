@@ -1,7 +1,7 @@
 #include "cubemap.h"
 
-Cubemap::Cubemap(const GraphicsBackendTextureDescriptor& descriptor, const std::string& name) :
-        Texture(TextureType::TEXTURE_CUBEMAP, descriptor, name)
+Cubemap::Cubemap(const GraphicsBackendTextureDescriptor& descriptor, const std::string& name, uint32_t residentMip) :
+        Texture(TextureType::TEXTURE_CUBEMAP, descriptor, name, residentMip)
 {
 }
 
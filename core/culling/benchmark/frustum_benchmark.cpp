@@ -0,0 +1,127 @@
+#include "culling/frustum.h"
+#include "bounds/bounds.h"
+#include "bounds/bounds_soa.h"
+#include "matrix4x4/matrix4x4.h"
+#include "quaternion/quaternion.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// compares per bounds scalar frustum tests with batched SoA tests used by culling
+namespace FrustumBenchmarkLocal
+{
+    constexpr size_t k_BoundsCounts[] = {1000, 10000, 100000};
+    constexpr size_t k_TestsPerRun = 20000000;
+    constexpr int k_CascadesCount = 4;
+
+    volatile uint64_t s_Sink = 0;
+
+    template<typename Func>
+    double MeasureNsPerBounds(size_t boundsCount, Func func)
+    {
+        const size_t iterations = std::max<size_t>(k_TestsPerRun / boundsCount, 1);
+
+        // warm up caches and branch predictors before measuring
+        func();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            func();
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations * boundsCount);
+    }
+
+    void GetVisibilityMaskScalar(const Frustum& frustum, const std::vector<Bounds>& bounds, std::vector<uint64_t>& outVisibilityMask)
+    {
+        outVisibilityMask.assign((bounds.size() + 63) / 64, 0);
+        for (size_t i = 0; i < bounds.size(); ++i)
+        {
+            if (frustum.IsVisible(bounds[i]))
+                outVisibilityMask[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+
+    void FillBounds(size_t count, std::vector<Bounds>& outBounds, BoundsSoA& outBoundsSoA)
+    {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> position(-100, 100);
+        std::uniform_real_distribution<float> extents(0.1f, 3);
+
+        outBounds.clear();
+        outBoundsSoA.Clear();
+        outBoundsSoA.Reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Vector3 center{position(random), position(random), position(random)};
+            const Vector3 extent{extents(random), extents(random), extents(random)};
+            const Bounds bounds{center - extent, center + extent};
+            outBounds.push_back(bounds);
+            outBoundsSoA.Add(bounds);
+        }
+    }
+}
+
+int main()
+{
+    using namespace FrustumBenchmarkLocal;
+
+    const Matrix4x4 projection = Matrix4x4::Perspective(60, 16.0f / 9.0f, 0.5f, 150.0f);
+    Frustum frustums[k_CascadesCount];
+    for (int i = 0; i < k_CascadesCount; ++i)
+        frustums[i] = Frustum(projection * Matrix4x4::Rotation(Quaternion::AngleAxis(90.0f * i, Vector3{0, 1, 0})));
+
+    std::vector<Bounds> bounds;
+    BoundsSoA boundsSoA;
+    std::vector<uint64_t> scalarMask;
+    std::vector<uint64_t> masks[k_CascadesCount];
+
+    printf("%10s %14s %14s %8s %18s %18s %8s\n", "bounds", "scalar ns", "soa ns", "speedup", "scalar x4 ns", "soa x4 ns", "speedup");
+    for (size_t count : k_BoundsCounts)
+    {
+        FillBounds(count, bounds, boundsSoA);
+
+        // both paths have to produce the same visibility before they are compared
+        for (int i = 0; i < k_CascadesCount; ++i)
+        {
+            GetVisibilityMaskScalar(frustums[i], bounds, scalarMask);
+            frustums[i].GetVisibilityMask(boundsSoA, masks[i]);
+            if (scalarMask != masks[i])
+            {
+                printf("visibility mismatch for %zu bounds\n", count);
+                return 1;
+            }
+        }
+
+        const double scalar = MeasureNsPerBounds(count, [&]()
+        {
+            GetVisibilityMaskScalar(frustums[0], bounds, scalarMask);
+            s_Sink = s_Sink + scalarMask[0];
+        });
+        const double soa = MeasureNsPerBounds(count, [&]()
+        {
+            frustums[0].GetVisibilityMask(boundsSoA, masks[0]);
+            s_Sink = s_Sink + masks[0][0];
+        });
+        const double scalarCascades = MeasureNsPerBounds(count, [&]()
+        {
+            for (int i = 0; i < k_CascadesCount; ++i)
+            {
+                GetVisibilityMaskScalar(frustums[i], bounds, scalarMask);
+                s_Sink = s_Sink + scalarMask[0];
+            }
+        });
+        const double soaCascades = MeasureNsPerBounds(count, [&]()
+        {
+            Frustum::GetVisibilityMasks(frustums, boundsSoA, masks);
+            s_Sink = s_Sink + masks[0][0];
+        });
+
+        printf("%10zu %14.2f %14.2f %7.1fx %18.2f %18.2f %7.1fx\n", count, scalar, soa, scalar / soa, scalarCascades, soaCascades, scalarCascades / soaCascades);
+    }
+
+    return 0;
+}
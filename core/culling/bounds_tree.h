@@ -0,0 +1,433 @@
+#ifndef RENDER_ENGINE_BOUNDS_TREE_H
+#define RENDER_ENGINE_BOUNDS_TREE_H
+
+#include "bounds/bounds.h"
+#include "culling/frustum.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Dynamic AABB tree. Leaves are inserted with enlarged (fat) bounds, so small movements do not change tree structure
+template<typename T>
+class BoundsTree
+{
+public:
+    struct QueryResult
+    {
+        T* Item;
+        // bit is set for every frustum item is visible from
+        uint32_t FrustumsMask;
+    };
+
+    static constexpr int32_t NullProxy = -1;
+    static constexpr size_t MaxQueryFrustums = 8;
+
+    BoundsTree() = default;
+
+    BoundsTree(const BoundsTree&) = delete;
+    BoundsTree(BoundsTree&&) = delete;
+
+    BoundsTree& operator=(const BoundsTree&) = delete;
+    BoundsTree& operator=(BoundsTree&&) = delete;
+
+    int32_t Insert(const Bounds& bounds, T* item)
+    {
+        const int32_t leaf = AllocateNode();
+
+        Node& node = m_Nodes[leaf];
+        node.TightBounds = bounds;
+        node.FatBounds = GetFatBounds(bounds);
+        node.Item = item;
+        node.Height = 0;
+
+        InsertLeaf(leaf);
+        ++m_LeavesCount;
+        return leaf;
+    }
+
+    void Remove(int32_t proxy)
+    {
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --m_LeavesCount;
+    }
+
+    // returns true if leaf had to be reinserted
+    bool Update(int32_t proxy, const Bounds& bounds)
+    {
+        Node& node = m_Nodes[proxy];
+        node.TightBounds = bounds;
+        if (Contains(node.FatBounds, bounds))
+            return false;
+
+        RemoveLeaf(proxy);
+        m_Nodes[proxy].FatBounds = GetFatBounds(bounds);
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    // collects items visible from any of the frustums. Subtrees fully inside a frustum are not tested against its planes anymore
+    void Query(std::span<const Frustum> frustums, uint32_t planesBits, std::vector<QueryResult>& outResults) const
+    {
+        assert(frustums.size() <= MaxQueryFrustums);
+
+        outResults.clear();
+        if (m_Root == NullProxy || frustums.empty())
+            return;
+
+        // 8 bits of state per frustum: planes left to test and a bit that frustum is still active
+        uint64_t rootState = 0;
+        for (size_t i = 0; i < frustums.size(); ++i)
+            rootState |= static_cast<uint64_t>(k_FrustumActiveBit | (planesBits & Frustum::AllPlanesBits)) << (i * 8);
+
+        thread_local std::vector<std::pair<int32_t, uint64_t>> stack;
+        stack.clear();
+        stack.emplace_back(m_Root, rootState);
+
+        while (!stack.empty())
+        {
+            const auto [nodeIndex, state] = stack.back();
+            stack.pop_back();
+
+            const Node& node = m_Nodes[nodeIndex];
+            const bool isLeaf = node.IsLeaf();
+            const Bounds& bounds = isLeaf ? node.TightBounds : node.FatBounds;
+
+            uint64_t nodeState = 0;
+            for (size_t i = 0; i < frustums.size(); ++i)
+            {
+                const uint32_t frustumState = (state >> (i * 8)) & 0xFF;
+                if (frustumState == 0)
+                    continue;
+
+                uint32_t planes = frustumState & Frustum::AllPlanesBits;
+                if (planes != 0 && !frustums[i].IsVisible(bounds, planes, planes))
+                    continue;
+
+                nodeState |= static_cast<uint64_t>(k_FrustumActiveBit | planes) << (i * 8);
+            }
+
+            if (nodeState == 0)
+                continue;
+
+            if (isLeaf)
+            {
+                uint32_t frustumsMask = 0;
+                for (size_t i = 0; i < frustums.size(); ++i)
+                {
+                    if ((nodeState >> (i * 8)) & k_FrustumActiveBit)
+                        frustumsMask |= 1 << i;
+                }
+
+                outResults.push_back({node.Item, frustumsMask});
+            }
+            else
+            {
+                stack.emplace_back(node.Child2, nodeState);
+                stack.emplace_back(node.Child1, nodeState);
+            }
+        }
+    }
+
+    size_t Size() const
+    {
+        return m_LeavesCount;
+    }
+
+    int32_t GetHeight() const
+    {
+        return m_Root == NullProxy ? 0 : m_Nodes[m_Root].Height;
+    }
+
+private:
+    struct Node
+    {
+        Bounds FatBounds;
+        Bounds TightBounds;
+        T* Item = nullptr;
+
+        // next free node if node is not used
+        int32_t Parent = NullProxy;
+        int32_t Child1 = NullProxy;
+        int32_t Child2 = NullProxy;
+
+        // 0 for leaves, -1 for free nodes
+        int32_t Height = -1;
+
+        bool IsLeaf() const
+        {
+            return Height == 0;
+        }
+    };
+
+    static constexpr uint32_t k_FrustumActiveBit = 1 << 7;
+    static constexpr float k_FatBoundsMargin = 0.1f;
+    static constexpr float k_MinFatBoundsMargin = 0.05f;
+
+    std::vector<Node> m_Nodes;
+    int32_t m_Root = NullProxy;
+    int32_t m_FreeList = NullProxy;
+    size_t m_LeavesCount = 0;
+
+    int32_t AllocateNode()
+    {
+        if (m_FreeList == NullProxy)
+        {
+            m_Nodes.emplace_back();
+            return static_cast<int32_t>(m_Nodes.size() - 1);
+        }
+
+        const int32_t index = m_FreeList;
+        m_FreeList = m_Nodes[index].Parent;
+        m_Nodes[index] = Node();
+        return index;
+    }
+
+    void FreeNode(int32_t index)
+    {
+        Node& node = m_Nodes[index];
+        node.Item = nullptr;
+        node.Height = -1;
+        node.Parent = m_FreeList;
+        m_FreeList = index;
+    }
+
+    void InsertLeaf(int32_t leaf)
+    {
+        if (m_Root == NullProxy)
+        {
+            m_Root = leaf;
+            m_Nodes[leaf].Parent = NullProxy;
+            return;
+        }
+
+        // find the cheapest sibling by surface area heuristic
+        const Bounds leafBounds = m_Nodes[leaf].FatBounds;
+        int32_t index = m_Root;
+        while (!m_Nodes[index].IsLeaf())
+        {
+            const Node& node = m_Nodes[index];
+
+            const float area = GetSurfaceArea(node.FatBounds);
+            const float combinedArea = GetSurfaceArea(node.FatBounds.Combine(leafBounds));
+
+            // cost of creating new parent for this node and the leaf
+            const float cost = 2 * combinedArea;
+            // minimum cost of pushing the leaf further down
+            const float inheritanceCost = 2 * (combinedArea - area);
+
+            const float cost1 = GetInsertionCost(node.Child1, leafBounds) + inheritanceCost;
+            const float cost2 = GetInsertionCost(node.Child2, leafBounds) + inheritanceCost;
+            if (cost < cost1 && cost < cost2)
+                break;
+
+            index = cost1 < cost2 ? node.Child1 : node.Child2;
+        }
+
+        const int32_t sibling = index;
+        const int32_t oldParent = m_Nodes[sibling].Parent;
+        const int32_t newParent = AllocateNode();
+
+        Node& parentNode = m_Nodes[newParent];
+        parentNode.Parent = oldParent;
+        parentNode.FatBounds = leafBounds.Combine(m_Nodes[sibling].FatBounds);
+        parentNode.Height = m_Nodes[sibling].Height + 1;
+        parentNode.Child1 = sibling;
+        parentNode.Child2 = leaf;
+
+        m_Nodes[sibling].Parent = newParent;
+        m_Nodes[leaf].Parent = newParent;
+
+        if (oldParent != NullProxy)
+            ReplaceChild(oldParent, sibling, newParent);
+        else
+            m_Root = newParent;
+
+        RefitAncestors(m_Nodes[leaf].Parent);
+    }
+
+    void RemoveLeaf(int32_t leaf)
+    {
+        if (leaf == m_Root)
+        {
+            m_Root = NullProxy;
+            return;
+        }
+
+        const int32_t parent = m_Nodes[leaf].Parent;
+        const int32_t grandParent = m_Nodes[parent].Parent;
+        const int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+        FreeNode(parent);
+
+        if (grandParent != NullProxy)
+        {
+            ReplaceChild(grandParent, parent, sibling);
+            m_Nodes[sibling].Parent = grandParent;
+            RefitAncestors(grandParent);
+        }
+        else
+        {
+            m_Root = sibling;
+            m_Nodes[sibling].Parent = NullProxy;
+        }
+    }
+
+    void RefitAncestors(int32_t index)
+    {
+        while (index != NullProxy)
+        {
+            index = Balance(index);
+
+            Node& node = m_Nodes[index];
+            const Node& child1 = m_Nodes[node.Child1];
+            const Node& child2 = m_Nodes[node.Child2];
+
+            node.Height = 1 + std::max(child1.Height, child2.Height);
+            node.FatBounds = child1.FatBounds.Combine(child2.FatBounds);
+
+            index = node.Parent;
+        }
+    }
+
+    // performs a left or right rotation if node A is imbalanced, returns index of the new subtree root
+    int32_t Balance(int32_t iA)
+    {
+        Node& A = m_Nodes[iA];
+        if (A.IsLeaf() || A.Height < 2)
+            return iA;
+
+        const int32_t iB = A.Child1;
+        const int32_t iC = A.Child2;
+        Node& B = m_Nodes[iB];
+        Node& C = m_Nodes[iC];
+
+        const int32_t balance = C.Height - B.Height;
+
+        // rotate C up
+        if (balance > 1)
+        {
+            const int32_t iF = C.Child1;
+            const int32_t iG = C.Child2;
+            Node& F = m_Nodes[iF];
+            Node& G = m_Nodes[iG];
+
+            C.Child1 = iA;
+            C.Parent = A.Parent;
+            A.Parent = iC;
+
+            if (C.Parent != NullProxy)
+                ReplaceChild(C.Parent, iA, iC);
+            else
+                m_Root = iC;
+
+            if (F.Height > G.Height)
+            {
+                C.Child2 = iF;
+                A.Child2 = iG;
+                G.Parent = iA;
+                A.FatBounds = B.FatBounds.Combine(G.FatBounds);
+                C.FatBounds = A.FatBounds.Combine(F.FatBounds);
+                A.Height = 1 + std::max(B.Height, G.Height);
+                C.Height = 1 + std::max(A.Height, F.Height);
+            }
+            else
+            {
+                C.Child2 = iG;
+                A.Child2 = iF;
+                F.Parent = iA;
+                A.FatBounds = B.FatBounds.Combine(F.FatBounds);
+                C.FatBounds = A.FatBounds.Combine(G.FatBounds);
+                A.Height = 1 + std::max(B.Height, F.Height);
+                C.Height = 1 + std::max(A.Height, G.Height);
+            }
+
+            return iC;
+        }
+
+        // rotate B up
+        if (balance < -1)
+        {
+            const int32_t iD = B.Child1;
+            const int32_t iE = B.Child2;
+            Node& D = m_Nodes[iD];
+            Node& E = m_Nodes[iE];
+
+            B.Child1 = iA;
+            B.Parent = A.Parent;
+            A.Parent = iB;
+
+            if (B.Parent != NullProxy)
+                ReplaceChild(B.Parent, iA, iB);
+            else
+                m_Root = iB;
+
+            if (D.Height > E.Height)
+            {
+                B.Child2 = iD;
+                A.Child1 = iE;
+                E.Parent = iA;
+                A.FatBounds = C.FatBounds.Combine(E.FatBounds);
+                B.FatBounds = A.FatBounds.Combine(D.FatBounds);
+                A.Height = 1 + std::max(C.Height, E.Height);
+                B.Height = 1 + std::max(A.Height, D.Height);
+            }
+            else
+            {
+                B.Child2 = iE;
+                A.Child1 = iD;
+                D.Parent = iA;
+                A.FatBounds = C.FatBounds.Combine(D.FatBounds);
+                B.FatBounds = A.FatBounds.Combine(E.FatBounds);
+                A.Height = 1 + std::max(C.Height, D.Height);
+                B.Height = 1 + std::max(A.Height, E.Height);
+            }
+
+            return iB;
+        }
+
+        return iA;
+    }
+
+    void ReplaceChild(int32_t parent, int32_t oldChild, int32_t newChild)
+    {
+        Node& node = m_Nodes[parent];
+        if (node.Child1 == oldChild)
+            node.Child1 = newChild;
+        else
+            node.Child2 = newChild;
+    }
+
+    float GetInsertionCost(int32_t index, const Bounds& leafBounds) const
+    {
+        const Node& node = m_Nodes[index];
+        const float combinedArea = GetSurfaceArea(leafBounds.Combine(node.FatBounds));
+        return node.IsLeaf() ? combinedArea : combinedArea - GetSurfaceArea(node.FatBounds);
+    }
+
+    static float GetSurfaceArea(const Bounds& bounds)
+    {
+        const Vector3 size = bounds.GetSize();
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+
+    static bool Contains(const Bounds& outer, const Bounds& inner)
+    {
+        return outer.Min.x <= inner.Min.x && outer.Min.y <= inner.Min.y && outer.Min.z <= inner.Min.z &&
+               inner.Max.x <= outer.Max.x && inner.Max.y <= outer.Max.y && inner.Max.z <= outer.Max.z;
+    }
+
+    static Bounds GetFatBounds(const Bounds& bounds)
+    {
+        const Vector3 size = bounds.GetSize();
+        const float margin = std::max(std::max(size.x, size.y), size.z) * k_FatBoundsMargin + k_MinFatBoundsMargin;
+        const Vector3 offset = Vector3(margin, margin, margin);
+        return Bounds{bounds.Min - offset, bounds.Max + offset};
+    }
+};
+
+#endif //RENDER_ENGINE_BOUNDS_TREE_H
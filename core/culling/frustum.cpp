@@ -1,7 +1,130 @@
 #include "frustum.h"
+#include "bounds/bounds_soa.h"
+
+#include <bit>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define RENDER_ENGINE_CULLING_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RENDER_ENGINE_CULLING_SSE 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RENDER_ENGINE_CULLING_NEON 1
+#endif
 
 namespace FrustumLocal
 {
+    struct CullingPlane
+    {
+        float A;
+        float B;
+        float C;
+        float D;
+
+        // components of the box corner which is the farthest along the plane normal
+        const float* X;
+        const float* Y;
+        const float* Z;
+    };
+
+    int GetCullingPlanes(const Vector4* planes, const BoundsSoA& bounds, size_t begin, uint32_t planesBits, CullingPlane* outPlanes)
+    {
+        int count = 0;
+        for (int i = 0; i < Frustum::Plane::COUNT; ++i)
+        {
+            if (((1 << i) & planesBits) == 0)
+                continue;
+
+            const Vector4& plane = planes[i];
+            outPlanes[count++] = CullingPlane{
+                    plane.x, plane.y, plane.z, plane.w,
+                    (plane.x >= 0 ? bounds.MaxX.data() : bounds.MinX.data()) + begin,
+                    (plane.y >= 0 ? bounds.MaxY.data() : bounds.MinY.data()) + begin,
+                    (plane.z >= 0 ? bounds.MaxZ.data() : bounds.MinZ.data()) + begin
+            };
+        }
+        return count;
+    }
+
+    uint64_t CullScalar(const CullingPlane* planes, int planesCount, size_t index)
+    {
+        for (int i = 0; i < planesCount; ++i)
+        {
+            const CullingPlane& plane = planes[i];
+            const float distance = plane.A * plane.X[index] + plane.B * plane.Y[index] + plane.C * plane.Z[index] + plane.D;
+            if (distance < 0)
+                return 0;
+        }
+        return 1;
+    }
+
+#if RENDER_ENGINE_CULLING_AVX
+    constexpr size_t k_CullingBatchSize = 8;
+
+    uint64_t CullBatch(const CullingPlane* planes, int planesCount, size_t index)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        __m256 culled = zero;
+        for (int i = 0; i < planesCount; ++i)
+        {
+            const CullingPlane& plane = planes[i];
+            __m256 distance = _mm256_mul_ps(_mm256_set1_ps(plane.A), _mm256_loadu_ps(plane.X + index));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.B), _mm256_loadu_ps(plane.Y + index)));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.C), _mm256_loadu_ps(plane.Z + index)));
+            distance = _mm256_add_ps(distance, _mm256_set1_ps(plane.D));
+            culled = _mm256_or_ps(culled, _mm256_cmp_ps(distance, zero, _CMP_LT_OQ));
+        }
+        return ~static_cast<uint64_t>(_mm256_movemask_ps(culled)) & 0xFF;
+    }
+#elif RENDER_ENGINE_CULLING_SSE
+    constexpr size_t k_CullingBatchSize = 4;
+
+    uint64_t CullBatch(const CullingPlane* planes, int planesCount, size_t index)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        __m128 culled = zero;
+        for (int i = 0; i < planesCount; ++i)
+        {
+            const CullingPlane& plane = planes[i];
+            __m128 distance = _mm_mul_ps(_mm_set1_ps(plane.A), _mm_loadu_ps(plane.X + index));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.B), _mm_loadu_ps(plane.Y + index)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.C), _mm_loadu_ps(plane.Z + index)));
+            distance = _mm_add_ps(distance, _mm_set1_ps(plane.D));
+            culled = _mm_or_ps(culled, _mm_cmplt_ps(distance, zero));
+        }
+        return ~static_cast<uint64_t>(_mm_movemask_ps(culled)) & 0xF;
+    }
+#elif RENDER_ENGINE_CULLING_NEON
+    constexpr size_t k_CullingBatchSize = 4;
+
+    uint64_t CullBatch(const CullingPlane* planes, int planesCount, size_t index)
+    {
+        const float32x4_t zero = vdupq_n_f32(0);
+        uint32x4_t culled = vdupq_n_u32(0);
+        for (int i = 0; i < planesCount; ++i)
+        {
+            const CullingPlane& plane = planes[i];
+            float32x4_t distance = vmulq_n_f32(vld1q_f32(plane.X + index), plane.A);
+            distance = vaddq_f32(distance, vmulq_n_f32(vld1q_f32(plane.Y + index), plane.B));
+            distance = vaddq_f32(distance, vmulq_n_f32(vld1q_f32(plane.Z + index), plane.C));
+            distance = vaddq_f32(distance, vdupq_n_f32(plane.D));
+            culled = vorrq_u32(culled, vcltq_f32(distance, zero));
+        }
+
+        static const uint32_t laneBits[4] = {1, 2, 4, 8};
+        return ~static_cast<uint64_t>(vaddvq_u32(vandq_u32(culled, vld1q_u32(laneBits)))) & 0xF;
+    }
+#else
+    constexpr size_t k_CullingBatchSize = 1;
+
+    uint64_t CullBatch(const CullingPlane* planes, int planesCount, size_t index)
+    {
+        return CullScalar(planes, planesCount, index);
+    }
+#endif
+
     Vector4 NormalizeFrustumPlane(float a, float b, float c, float d)
     {
         Vector3 dir = {a, b, c};
@@ -76,4 +199,94 @@ bool Frustum::IsVisible(const Bounds& bounds, uint32_t planesBits) const
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+bool Frustum::IsVisible(const Bounds& bounds, uint32_t planesBits, uint32_t& outIntersectedPlanesBits) const
+{
+    outIntersectedPlanesBits = 0;
+
+    for (int i = 0; i < Plane::COUNT; ++i)
+    {
+        if (((1 << i) & planesBits) == 0)
+            continue;
+
+        const Vector4& plane = Planes[i];
+
+        Vector3 p = {
+                plane.x >= 0 ? bounds.Max.x : bounds.Min.x,
+                plane.y >= 0 ? bounds.Max.y : bounds.Min.y,
+                plane.z >= 0 ? bounds.Max.z : bounds.Min.z
+        };
+
+        if (Vector3::Dot(plane, p) + plane.w < 0)
+            return false;
+
+        Vector3 n = {
+                plane.x >= 0 ? bounds.Min.x : bounds.Max.x,
+                plane.y >= 0 ? bounds.Min.y : bounds.Max.y,
+                plane.z >= 0 ? bounds.Min.z : bounds.Max.z
+        };
+
+        if (Vector3::Dot(plane, n) + plane.w < 0)
+            outIntersectedPlanesBits |= 1 << i;
+    }
+
+    return true;
+}
+
+void Frustum::GetVisibilityMask(const BoundsSoA& bounds, std::vector<uint64_t>& outVisibilityMask, uint32_t planesBits) const
+{
+    GetVisibilityMasks(std::span<const Frustum>(this, 1), bounds, std::span<std::vector<uint64_t>>(&outVisibilityMask, 1), planesBits);
+}
+
+void Frustum::GetVisibilityMasks(std::span<const Frustum> frustums, const BoundsSoA& bounds, std::span<std::vector<uint64_t>> outVisibilityMasks, uint32_t planesBits)
+{
+    GetVisibilityMasks(frustums, bounds, 0, bounds.Size(), outVisibilityMasks, planesBits);
+}
+
+void Frustum::GetVisibilityMasks(std::span<const Frustum> frustums, const BoundsSoA& bounds, size_t begin, size_t count, std::span<std::vector<uint64_t>> outVisibilityMasks, uint32_t planesBits)
+{
+    const size_t frustumsCount = frustums.size();
+
+    thread_local std::vector<FrustumLocal::CullingPlane> planes;
+    thread_local std::vector<int> planesCounts;
+    planes.resize(frustumsCount * Plane::COUNT);
+    planesCounts.resize(frustumsCount);
+
+    for (size_t i = 0; i < frustumsCount; ++i)
+    {
+        planesCounts[i] = FrustumLocal::GetCullingPlanes(frustums[i].Planes, bounds, begin, planesBits, &planes[i * Plane::COUNT]);
+        outVisibilityMasks[i].assign((count + 63) / 64, 0);
+    }
+
+    // all frustums are tested while batch of bounds is still in cache, so bounds are read from memory only once
+    const size_t batchedCount = count - count % FrustumLocal::k_CullingBatchSize;
+    for (size_t i = 0; i < batchedCount; i += FrustumLocal::k_CullingBatchSize)
+    {
+        for (size_t j = 0; j < frustumsCount; ++j)
+            outVisibilityMasks[j][i / 64] |= FrustumLocal::CullBatch(&planes[j * Plane::COUNT], planesCounts[j], i) << (i % 64);
+    }
+
+    for (size_t i = batchedCount; i < count; ++i)
+    {
+        for (size_t j = 0; j < frustumsCount; ++j)
+            outVisibilityMasks[j][i / 64] |= FrustumLocal::CullScalar(&planes[j * Plane::COUNT], planesCounts[j], i) << (i % 64);
+    }
+}
+
+void Frustum::GetVisibleIndices(const BoundsSoA& bounds, std::vector<uint32_t>& outVisibleIndices, uint32_t planesBits) const
+{
+    thread_local std::vector<uint64_t> visibilityMask;
+    GetVisibilityMask(bounds, visibilityMask, planesBits);
+
+    outVisibleIndices.clear();
+    for (size_t word = 0; word < visibilityMask.size(); ++word)
+    {
+        uint64_t bits = visibilityMask[word];
+        while (bits != 0)
+        {
+            outVisibleIndices.push_back(static_cast<uint32_t>(word * 64 + std::countr_zero(bits)));
+            bits &= bits - 1;
+        }
+    }
+}
@@ -6,6 +6,10 @@
 #include "bounds/bounds.h"
 
 #include <cstdint>
+#include <span>
+#include <vector>
+
+struct BoundsSoA;
 
 struct Frustum
 {
@@ -30,6 +34,17 @@ struct Frustum
     explicit Frustum(const Matrix4x4& viewProjectionMatrix);
 
     bool IsVisible(const Bounds& bounds, uint32_t planesBits = AllPlanesBits) const;
+    // same as above, additionally writes planes that intersect bounds. Bounds are fully inside frustum if none of them are left
+    bool IsVisible(const Bounds& bounds, uint32_t planesBits, uint32_t& outIntersectedPlanesBits) const;
+
+    // writes one bit per bounds, bit is set if bounds are visible
+    void GetVisibilityMask(const BoundsSoA& bounds, std::vector<uint64_t>& outVisibilityMask, uint32_t planesBits = AllPlanesBits) const;
+    void GetVisibleIndices(const BoundsSoA& bounds, std::vector<uint32_t>& outVisibleIndices, uint32_t planesBits = AllPlanesBits) const;
+
+    // tests bounds against several frustums in a single pass, writes one visibility mask per frustum
+    static void GetVisibilityMasks(std::span<const Frustum> frustums, const BoundsSoA& bounds, std::span<std::vector<uint64_t>> outVisibilityMasks, uint32_t planesBits = AllPlanesBits);
+    // same as above for bounds in range [begin, begin + count), bit 0 of each mask corresponds to bounds at begin
+    static void GetVisibilityMasks(std::span<const Frustum> frustums, const BoundsSoA& bounds, size_t begin, size_t count, std::span<std::vector<uint64_t>> outVisibilityMasks, uint32_t planesBits = AllPlanesBits);
 };
 
 #endif //RENDER_ENGINE_FRUSTUM_H
@@ -33,7 +33,7 @@ void GizmosPass::Prepare(RenderData& renderData)
 
     if (m_Mode == Mode::GIZMOS_3D)
     {
-        for (const std::shared_ptr<Renderer>& renderer : renderData.Renderers)
+        for (Renderer* renderer : renderData.Renderers)
         {
             if (renderer)
             {
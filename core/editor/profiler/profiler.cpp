@@ -3,31 +3,37 @@
 #include "worker/worker.h"
 
 #include <vector>
+#include <deque>
 #include <algorithm>
 
+struct ContextData
+{
+    int Depth = 0;
+    std::mutex Mutex;
+    std::map<uint64_t, Profiler::FrameInfo> Frames;
+};
+
 constexpr int k_MaxFrames = 1000;
-constexpr int k_ContextCount = static_cast<int>(Profiler::MarkerContext::MAX);
 
 bool s_IsEnabled = false;
 
-int s_ContextDepth[k_ContextCount];
-std::mutex s_ContextMutexes[k_ContextCount];
-std::map<uint64_t, Profiler::FrameInfo> s_ContextFrames[k_ContextCount];
+// deque keeps references valid when worker contexts are added
+std::deque<ContextData> s_Contexts(static_cast<int>(Profiler::MarkerContext::WORKER));
 std::vector<Profiler::GPUMarkerInfo> s_PendingGPUMarkers;
 
 int IncrementDepth(Profiler::MarkerContext context)
 {
-    return s_ContextDepth[static_cast<int>(context)]++;
+    return s_Contexts[static_cast<int>(context)].Depth++;
 }
 
 int DecrementDepth(Profiler::MarkerContext context)
 {
-    return s_ContextDepth[static_cast<int>(context)]--;
+    return s_Contexts[static_cast<int>(context)].Depth--;
 }
 
 void SortMarkers(Profiler::MarkerContext context)
 {
-    std::map<uint64_t, Profiler::FrameInfo>& gpuFrames = s_ContextFrames[static_cast<int>(context)];
+    std::map<uint64_t, Profiler::FrameInfo>& gpuFrames = s_Contexts[static_cast<int>(context)].Frames;
     for (auto& pair: gpuFrames)
     {
         Profiler::FrameInfo& gpuFrame = pair.second;
@@ -42,7 +48,7 @@ void SortMarkers(Profiler::MarkerContext context)
 Profiler::MarkerContext GetCPUContext()
 {
     int32_t workerId = Worker::GetWorkerId();
-    return workerId == -1 ? Profiler::MarkerContext::MAIN_THREAD : static_cast<Profiler::MarkerContext>(static_cast<uint32_t>(Profiler::MarkerContext::WORKER_1) + workerId);
+    return workerId == -1 ? Profiler::MarkerContext::MAIN_THREAD : Profiler::GetWorkerContext(workerId);
 }
 
 Profiler::MarkerInfo::MarkerInfo(MarkerType type, const char* name, std::optional<std::string> additionalInfo, int depth, uint64_t frame) :
@@ -117,10 +123,10 @@ void Profiler::BeginNewFrame()
     if (!s_IsEnabled)
         return;
 
-    for (int i = 0; i < k_ContextCount; ++i)
+    for (ContextData& contextData : s_Contexts)
     {
-        std::lock_guard<std::mutex> lock(s_ContextMutexes[i]);
-        std::map<uint64_t, Profiler::FrameInfo>& contextFrames = s_ContextFrames[i];
+        std::lock_guard<std::mutex> lock(contextData.Mutex);
+        std::map<uint64_t, Profiler::FrameInfo>& contextFrames = contextData.Frames;
 
         if (contextFrames.size() >= k_MaxFrames)
             contextFrames.erase(contextFrames.begin());
@@ -130,7 +136,7 @@ void Profiler::BeginNewFrame()
         contextFrames[newFrame.Frame] = std::move(newFrame);
     }
 
-    FrameInfo& newMainThreadFrame = s_ContextFrames[static_cast<int>(MarkerContext::MAIN_THREAD)][GraphicsBackend::Current()->GetFrameNumber()];
+    FrameInfo& newMainThreadFrame = GetContextFrames(MarkerContext::MAIN_THREAD)[GraphicsBackend::Current()->GetFrameNumber()];
     newMainThreadFrame.Markers.emplace_back(MarkerType::SEPARATOR);
 
     Profiler::Marker _("Profiler::BeginNewFrame");
@@ -178,7 +184,7 @@ int32_t Profiler::AddMarkerInfo(MarkerContext context, MarkerInfo& markerInfo, u
         return -1;
 
     std::lock_guard<std::mutex> lock(GetContextMutex(context));
-    std::map<uint64_t, FrameInfo>& contextFrames = s_ContextFrames[static_cast<int>(context)];
+    std::map<uint64_t, FrameInfo>& contextFrames = GetContextFrames(context);
 
     auto it = contextFrames.find(frame);
     if (it != contextFrames.end())
@@ -198,7 +204,7 @@ void Profiler::SetMarkerEndTime(MarkerContext context, uint64_t frame, int32_t m
         return;
 
     std::lock_guard<std::mutex> lock(GetContextMutex(context));
-    std::map<uint64_t, FrameInfo>& contextFrames = s_ContextFrames[static_cast<int>(context)];
+    std::map<uint64_t, FrameInfo>& contextFrames = GetContextFrames(context);
 
     auto it = contextFrames.find(frame);
     if (it != contextFrames.end())
@@ -212,12 +218,50 @@ void Profiler::SetMarkerEndTime(MarkerContext context, uint64_t frame, int32_t m
     }
 }
 
+void Profiler::SetCounter(const char* name, uint64_t value)
+{
+    if (!s_IsEnabled)
+        return;
+
+    std::lock_guard<std::mutex> lock(GetContextMutex(MarkerContext::MAIN_THREAD));
+    std::map<uint64_t, FrameInfo>& contextFrames = GetContextFrames(MarkerContext::MAIN_THREAD);
+
+    auto it = contextFrames.find(GraphicsBackend::Current()->GetFrameNumber());
+    if (it == contextFrames.end())
+        return;
+
+    std::vector<std::pair<const char*, uint64_t>>& counters = it->second.Counters;
+    auto counterIt = std::ranges::find_if(counters, [name](const std::pair<const char*, uint64_t>& counter){ return counter.first == name; });
+    if (counterIt != counters.end())
+        counterIt->second = value;
+    else
+        counters.emplace_back(name, value);
+}
+
+void Profiler::SetWorkersCount(int32_t count)
+{
+    // called before worker threads are started, so contexts are not accessed concurrently
+    const size_t contextCount = static_cast<int>(MarkerContext::WORKER) + count;
+    while (s_Contexts.size() < contextCount)
+        s_Contexts.emplace_back();
+}
+
+int32_t Profiler::GetContextCount()
+{
+    return static_cast<int32_t>(s_Contexts.size());
+}
+
+Profiler::MarkerContext Profiler::GetWorkerContext(int32_t workerId)
+{
+    return static_cast<MarkerContext>(static_cast<int32_t>(MarkerContext::WORKER) + workerId);
+}
+
 std::map<uint64_t, Profiler::FrameInfo>& Profiler::GetContextFrames(MarkerContext context)
 {
-    return s_ContextFrames[static_cast<int>(context)];
+    return s_Contexts[static_cast<int>(context)].Frames;
 }
 
 std::mutex& Profiler::GetContextMutex(Profiler::MarkerContext context)
 {
-    return s_ContextMutexes[static_cast<int>(context)];
+    return s_Contexts[static_cast<int>(context)].Mutex;
 }
@@ -22,13 +22,9 @@ public:
         MAIN_THREAD,
         GPU_RENDER,
         GPU_COPY,
-        WORKER_1,
-        WORKER_2,
-        WORKER_3,
-        WORKER_4,
-        WORKER_5,
 
-        MAX
+        // first worker context, worker contexts are allocated dynamically after it
+        WORKER
     };
 
     struct MarkerInfo
@@ -112,15 +108,22 @@ public:
     struct FrameInfo
     {
         std::vector<MarkerInfo> Markers;
+        std::vector<std::pair<const char*, uint64_t>> Counters;
         uint64_t Frame;
         bool IsSorted;
     };
 
     static void SetEnabled(bool enabled);
     static void BeginNewFrame();
+    static void SetWorkersCount(int32_t count);
+    static int32_t GetContextCount();
+    static MarkerContext GetWorkerContext(int32_t workerId);
     static std::map<uint64_t, FrameInfo>& GetContextFrames(MarkerContext context);
     static std::mutex& GetContextMutex(MarkerContext context);
 
+    // per frame values, shown for the main thread frame
+    static void SetCounter(const char* name, uint64_t value);
+
 private:
     static int32_t AddMarkerInfo(MarkerContext context, MarkerInfo& markerInfo, uint64_t frame);
     static void SetMarkerEndTime(MarkerContext context, uint64_t frame, int32_t frameIndex, std::chrono::system_clock::time_point endTime);
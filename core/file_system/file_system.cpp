@@ -3,6 +3,8 @@
 #include "file_system_implementations/file_system_windows.h"
 #include "file_system_implementations/file_system_apple.h"
 #include "file_system_implementations/file_system_android.h"
+#include "file_system_implementations/file_system_linux.h"
+#include "mapped_file.h"
 #include "editor/profiler/profiler.h"
 
 namespace FileSystem
@@ -17,6 +19,8 @@ namespace FileSystem
         s_FileSystem = new FileSystemApple();
 #elif RENDER_ENGINE_ANDROID
         s_FileSystem = new FileSystemAndroid(fileSystemData);
+#elif RENDER_ENGINE_LINUX
+        s_FileSystem = new FileSystemLinux();
 #endif
     }
 
@@ -38,8 +42,25 @@ namespace FileSystem
         return s_FileSystem->ReadFileBytes(relativePath, bytes);
     }
 
+    void WriteFileBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+    {
+        Profiler::Marker _("FileSystem::WriteFileBytes");
+        s_FileSystem->WriteFileBytes(path, bytes);
+    }
+
+    std::shared_ptr<MappedFile> MapFile(const std::filesystem::path& path)
+    {
+        Profiler::Marker _("FileSystem::MapFile");
+        return s_FileSystem->MapFile(path);
+    }
+
     const std::filesystem::path& GetResourcesPath()
     {
         return s_FileSystem->GetResourcesPath();
     }
+
+    const std::filesystem::path& GetCachePath()
+    {
+        return s_FileSystem->GetCachePath();
+    }
 }
\ No newline at end of file
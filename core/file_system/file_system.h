@@ -4,6 +4,9 @@
 #include <string>
 #include <filesystem>
 #include <vector>
+#include <memory>
+
+class MappedFile;
 
 namespace FileSystem
 {
@@ -13,8 +16,14 @@ namespace FileSystem
     std::string ReadFile(const std::filesystem::path& path);
     bool ReadFileBytes(const std::filesystem::path& path, std::vector<uint8_t>& bytes);
     void WriteFile(const std::filesystem::path& path, const std::string& content);
+    void WriteFileBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes);
+
+    // returns nullptr if file can't be opened
+    std::shared_ptr<MappedFile> MapFile(const std::filesystem::path& path);
 
     const std::filesystem::path& GetResourcesPath();
+    // writable per-user directory for generated data, empty if platform can't write files
+    const std::filesystem::path& GetCachePath();
 }
 
 #endif //RENDER_ENGINE_FILE_SYSTEM_H
@@ -1,6 +1,7 @@
 #if RENDER_ENGINE_ANDROID
 
 #include "file_system_android.h"
+#include "file_system/mapped_file.h"
 
 #include <android/asset_manager.h>
 #include <exception>
@@ -8,6 +9,7 @@
 FileSystemAndroid::FileSystemAndroid(void *fileSystemData) : FileSystemBase(),
     m_AssetManager(static_cast<AAssetManager*>(fileSystemData))
 {
+    // assets are read-only and app's writable directories are not passed by the launcher, so cache path stays empty
 }
 
 bool FileSystemAndroid::FileExists(const std::filesystem::path& path)
@@ -59,4 +61,26 @@ void FileSystemAndroid::WriteFile(const std::filesystem::path& path, const std::
     throw std::runtime_error("Not implemented");
 }
 
+void FileSystemAndroid::WriteFileBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+{
+    throw std::runtime_error("Not implemented");
+}
+
+std::shared_ptr<MappedFile> FileSystemAndroid::MapFile(const std::filesystem::path& path)
+{
+    // uncompressed assets are mapped by asset manager, buffer is valid until asset is closed
+    AAsset* asset = AAssetManager_open(m_AssetManager, path.c_str(), AASSET_MODE_BUFFER);
+    if (!asset)
+        return nullptr;
+
+    const void* data = AAsset_getBuffer(asset);
+    if (!data)
+    {
+        AAsset_close(asset);
+        return nullptr;
+    }
+
+    return std::make_shared<MappedFile>(static_cast<const uint8_t*>(data), AAsset_getLength(asset), [asset]{ AAsset_close(asset); });
+}
+
 #endif
\ No newline at end of file
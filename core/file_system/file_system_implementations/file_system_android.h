@@ -16,6 +16,8 @@ public:
     virtual std::string ReadFile(const std::filesystem::path& path) override;
     virtual bool ReadFileBytes(const std::filesystem::path& path, std::vector<uint8_t>& bytes) override;
     virtual void WriteFile(const std::filesystem::path& path, const std::string& content) override;
+    virtual void WriteFileBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) override;
+    virtual std::shared_ptr<MappedFile> MapFile(const std::filesystem::path& path) override;
 
 private:
     AAssetManager* m_AssetManager;
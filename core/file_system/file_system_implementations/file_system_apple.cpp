@@ -3,9 +3,15 @@
 #include "file_system_apple.h"
 #include <Foundation/NSBundle.hpp>
 
+#include <cstdlib>
+
 FileSystemApple::FileSystemApple() : FileSystemBase()
 {
     m_ResourcesPath = NS::Bundle::mainBundle()->resourcePath()->cString(NS::UTF8StringEncoding);
+
+    // bundle is read-only, home is the app container on iOS and user's home on macOS
+    if (const char* home = std::getenv("HOME"); home && *home)
+        m_CachePath = std::filesystem::path(home) / "Library" / "Caches" / "RenderEngine";
 }
 
 #endif
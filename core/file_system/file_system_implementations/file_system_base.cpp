@@ -1,4 +1,5 @@
 #include "file_system_base.h"
+#include "file_system/mapped_file.h"
 
 #include <cstdio>
 #include <filesystem>
@@ -6,6 +7,13 @@
 #include <string>
 #include <vector>
 
+#if !RENDER_ENGINE_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 bool FileSystemBase::FileExists(const std::filesystem::path& path)
 {
     return std::filesystem::exists(path);
@@ -71,7 +79,60 @@ void FileSystemBase::WriteFile(const std::filesystem::path& path, const std::str
     o.close();
 }
 
+void FileSystemBase::WriteFileBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+{
+    std::ofstream output(path.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+        throw std::runtime_error("[Utils] Can't open file: " + path.string());
+
+    output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    output.close();
+}
+
+std::shared_ptr<MappedFile> FileSystemBase::MapFile(const std::filesystem::path& path)
+{
+#if RENDER_ENGINE_WINDOWS
+    // file is read into memory on platforms without posix mapping, unless platform file system overrides it
+    auto bytes = std::make_shared<std::vector<uint8_t>>();
+    if (!ReadFileBytes(path, *bytes))
+        return nullptr;
+
+    return std::make_shared<MappedFile>(bytes->data(), bytes->size(), [bytes]{});
+#else
+    const int file = open(path.string().c_str(), O_RDONLY);
+    if (file == -1)
+        return nullptr;
+
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0)
+    {
+        close(file);
+        return nullptr;
+    }
+
+    const size_t size = fileStat.st_size;
+    if (size == 0)
+    {
+        close(file);
+        return std::make_shared<MappedFile>(nullptr, 0, nullptr);
+    }
+
+    // mapping stays valid after descriptor is closed
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+        return nullptr;
+
+    return std::make_shared<MappedFile>(static_cast<const uint8_t*>(data), size, [data, size]{ munmap(data, size); });
+#endif
+}
+
 const std::filesystem::path &FileSystemBase::GetResourcesPath()
 {
     return m_ResourcesPath;
 }
+
+const std::filesystem::path &FileSystemBase::GetCachePath()
+{
+    return m_CachePath;
+}
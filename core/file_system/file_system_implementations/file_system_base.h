@@ -3,6 +3,10 @@
 
 #include <string>
 #include <filesystem>
+#include <vector>
+#include <memory>
+
+class MappedFile;
 
 class FileSystemBase
 {
@@ -13,11 +17,15 @@ public:
     virtual std::string ReadFile(const std::filesystem::path& path);
     virtual bool ReadFileBytes(const std::filesystem::path& path, std::vector<uint8_t>& bytes);
     virtual void WriteFile(const std::filesystem::path& path, const std::string& content);
+    virtual void WriteFileBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes);
+    virtual std::shared_ptr<MappedFile> MapFile(const std::filesystem::path& path);
 
     const std::filesystem::path& GetResourcesPath();
+    const std::filesystem::path& GetCachePath();
 
 protected:
     std::filesystem::path m_ResourcesPath;
+    std::filesystem::path m_CachePath;
 };
 
 #endif //RENDER_ENGINE_FILE_SYSTEM_BASE_H
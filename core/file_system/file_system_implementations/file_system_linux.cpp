@@ -0,0 +1,19 @@
+#if RENDER_ENGINE_LINUX
+
+#include "file_system_linux.h"
+
+#include <cstdlib>
+
+FileSystemLinux::FileSystemLinux() : FileSystemBase()
+{
+    m_ResourcesPath = std::filesystem::read_symlink("/proc/self/exe").parent_path();
+
+    if (const char* cacheHome = std::getenv("XDG_CACHE_HOME"); cacheHome && *cacheHome)
+        m_CachePath = std::filesystem::path(cacheHome) / "RenderEngine";
+    else if (const char* home = std::getenv("HOME"); home && *home)
+        m_CachePath = std::filesystem::path(home) / ".cache" / "RenderEngine";
+    else
+        m_CachePath = m_ResourcesPath;
+}
+
+#endif
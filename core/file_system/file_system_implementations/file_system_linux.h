@@ -0,0 +1,16 @@
+#ifndef RENDER_ENGINE_FILE_SYSTEM_LINUX_H
+#define RENDER_ENGINE_FILE_SYSTEM_LINUX_H
+
+#if RENDER_ENGINE_LINUX
+
+#include "file_system_base.h"
+
+class FileSystemLinux : public FileSystemBase
+{
+public:
+    FileSystemLinux();
+};
+
+#endif
+
+#endif //RENDER_ENGINE_FILE_SYSTEM_LINUX_H
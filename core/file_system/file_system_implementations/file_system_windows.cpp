@@ -1,6 +1,8 @@
 #if RENDER_ENGINE_WINDOWS
 
 #include "file_system_windows.h"
+#include "file_system/mapped_file.h"
+
 #include <windows.h>
 
 FileSystemWindows::FileSystemWindows() : FileSystemBase()
@@ -8,6 +10,46 @@ FileSystemWindows::FileSystemWindows() : FileSystemBase()
     char executablePath[MAX_PATH];
     GetModuleFileNameA(NULL, executablePath, MAX_PATH);
     m_ResourcesPath = std::filesystem::path(executablePath).parent_path();
+
+    wchar_t localAppDataPath[MAX_PATH];
+    const DWORD length = GetEnvironmentVariableW(L"LOCALAPPDATA", localAppDataPath, MAX_PATH);
+    if (length > 0 && length < MAX_PATH)
+        m_CachePath = std::filesystem::path(localAppDataPath) / "RenderEngine";
+    else
+        m_CachePath = m_ResourcesPath;
+}
+
+std::shared_ptr<MappedFile> FileSystemWindows::MapFile(const std::filesystem::path& path)
+{
+    const HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    if (fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return std::make_shared<MappedFile>(nullptr, 0, nullptr);
+    }
+
+    // view stays valid after file and mapping handles are closed
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return nullptr;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+        return nullptr;
+
+    return std::make_shared<MappedFile>(static_cast<const uint8_t*>(data), static_cast<size_t>(fileSize.QuadPart), [data]{ UnmapViewOfFile(data); });
 }
 
 #endif
\ No newline at end of file
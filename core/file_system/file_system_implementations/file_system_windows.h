@@ -9,6 +9,8 @@ class FileSystemWindows : public FileSystemBase
 {
 public:
     FileSystemWindows();
+
+    std::shared_ptr<MappedFile> MapFile(const std::filesystem::path& path) override;
 };
 
 #endif
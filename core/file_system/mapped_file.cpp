@@ -0,0 +1,14 @@
+#include "mapped_file.h"
+
+MappedFile::MappedFile(const uint8_t* data, size_t size, std::function<void()> unmap) :
+    m_Data(data),
+    m_Size(size),
+    m_Unmap(std::move(unmap))
+{
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_Unmap)
+        m_Unmap();
+}
@@ -0,0 +1,32 @@
+#ifndef RENDER_ENGINE_MAPPED_FILE_H
+#define RENDER_ENGINE_MAPPED_FILE_H
+
+#include <cstdint>
+#include <functional>
+#include <span>
+
+// Read-only view of a file mapped into memory, file is unmapped when the view is destroyed
+class MappedFile
+{
+public:
+    MappedFile(const uint8_t* data, size_t size, std::function<void()> unmap);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    inline std::span<const uint8_t> GetData() const
+    {
+        return {m_Data, m_Size};
+    }
+
+private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    std::function<void()> m_Unmap;
+};
+
+#endif //RENDER_ENGINE_MAPPED_FILE_H
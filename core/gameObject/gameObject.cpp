@@ -57,13 +57,20 @@ void GameObject::Destroy()
 
 GameObject::GameObject(std::string name, std::shared_ptr<Scene> scene) :
     Name(std::move(name)),
-    m_Scene(scene)
+    m_Scene(scene),
+    m_Transforms(scene->GetTransformHierarchy()),
+    m_TransformHandle(m_Transforms->Create())
 {
     static int uniqueIdCounter = 0;
 
     m_UniqueId = uniqueIdCounter++;
 }
 
+GameObject::~GameObject()
+{
+    m_Transforms->Destroy(m_TransformHandle);
+}
+
 std::shared_ptr<GameObject> GameObject::GetParent() const
 {
     return !m_Parent.expired() ? m_Parent.lock() : nullptr;
@@ -90,6 +97,7 @@ void GameObject::SetParent(const std::shared_ptr<GameObject> &newParent, int _in
     }
 
     m_Parent = newParent;
+    m_Transforms->SetParent(m_TransformHandle, newParent ? newParent->m_TransformHandle : TransformHierarchy::NullHandle);
 
     auto &newCollection = newParent ? newParent->Children : m_Scene.lock()->GetRootGameObjects();
     if (_index < 0 || _index >= newCollection.size())
@@ -113,7 +121,12 @@ void GameObject::AddComponent(std::shared_ptr<Component> component)
 
     std::shared_ptr<Renderer> renderer = std::dynamic_pointer_cast<Renderer>(component);
     if (renderer)
+    {
         m_Renderer = renderer;
+
+        if (std::shared_ptr<Scene> scene = m_Scene.lock())
+            scene->AddRenderer(renderer.get());
+    }
 }
 
 // global
@@ -142,78 +155,40 @@ Vector3 GameObject::GetPosition()
 
 Quaternion GameObject::GetRotation()
 {
-    ValidateTransform();
-    return m_Rotation;
+    return m_Transforms->GetRotation(m_TransformHandle);
 }
 
 Vector3 GameObject::GetLossyScale()
 {
     auto parent = GetParent();
-    return parent ? parent->GetLossyScale() * m_LocalScale : m_LocalScale;
+    return parent ? parent->GetLossyScale() * GetLocalScale() : GetLocalScale();
 }
 
 // local
 
-const Matrix4x4 &GameObject::GetLocalToWorldMatrix()
+Matrix4x4 GameObject::GetLocalToWorldMatrix() const
 {
-    ValidateTransform();
-    return m_LocalToWorldMatrix;
+    return m_Transforms->GetLocalToWorldMatrix(m_TransformHandle);
 }
 
-const Matrix4x4 &GameObject::GetWorldToLocalMatrix()
+Matrix4x4 GameObject::GetWorldToLocalMatrix() const
 {
-    ValidateTransform();
-    return m_WorldToLocalMatrix;
+    return m_Transforms->GetWorldToLocalMatrix(m_TransformHandle);
 }
 
 void GameObject::SetLocalPosition(const Vector3 &_position)
 {
-    m_LocalPosition = _position;
-    InvalidateTransform();
+    m_Transforms->SetLocalPosition(m_TransformHandle, _position);
 }
 
 void GameObject::SetLocalRotation(const Quaternion &_rotation)
 {
-    m_LocalRotation = _rotation;
-    InvalidateTransform();
+    m_Transforms->SetLocalRotation(m_TransformHandle, _rotation);
 }
 
 void GameObject::SetLocalScale(const Vector3 &_scale)
 {
-    m_LocalScale = _scale;
-    InvalidateTransform();
-}
-
-void GameObject::InvalidateTransform()
-{
-    m_DirtyTransform = true;
-
-    std::shared_ptr<Renderer> renderer = GetRenderer();
-    if (renderer)
-        renderer->SetTransformDirty(true);
-
-    for (const auto &child: Children)
-    {
-        if (child)
-            child->InvalidateTransform();
-    }
-}
-
-void GameObject::ValidateTransform()
-{
-    if (!m_DirtyTransform)
-        return;
-
-    m_DirtyTransform     = false;
-    m_LocalToWorldMatrix = Matrix4x4::TRS(m_LocalPosition, m_LocalRotation, m_LocalScale);
-
-    auto parent = GetParent();
-    if (parent)
-        m_LocalToWorldMatrix = parent->GetLocalToWorldMatrix() * m_LocalToWorldMatrix;
-
-    m_WorldToLocalMatrix = m_LocalToWorldMatrix.Invert();
-
-    m_Rotation = parent ? parent->GetRotation() * m_LocalRotation : m_LocalRotation;
+    m_Transforms->SetLocalScale(m_TransformHandle, _scale);
 }
 
 // helpers
@@ -4,6 +4,7 @@
 #include "matrix4x4/matrix4x4.h"
 #include "quaternion/quaternion.h"
 #include "vector3/vector3.h"
+#include "transform_hierarchy.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -18,6 +19,8 @@ public:
     static std::shared_ptr<GameObject> Create(const std::string& name, std::shared_ptr<Scene> scene = nullptr);
     void Destroy();
 
+    ~GameObject();
+
     std::string Name;
     std::vector<std::shared_ptr<GameObject>> Children;
 
@@ -39,22 +42,22 @@ public:
     void SetLocalRotation(const Quaternion &_rotation);
     void SetLocalScale(const Vector3 &_scale);
 
-    const Matrix4x4 &GetLocalToWorldMatrix();
-    const Matrix4x4 &GetWorldToLocalMatrix();
+    Matrix4x4 GetLocalToWorldMatrix() const;
+    Matrix4x4 GetWorldToLocalMatrix() const;
 
-    inline const Vector3 &GetLocalPosition() const
+    inline Vector3 GetLocalPosition() const
     {
-        return m_LocalPosition;
+        return m_Transforms->GetLocalPosition(m_TransformHandle);
     };
 
-    inline const Quaternion &GetLocalRotation() const
+    inline Quaternion GetLocalRotation() const
     {
-        return m_LocalRotation;
+        return m_Transforms->GetLocalRotation(m_TransformHandle);
     };
 
-    inline const Vector3 &GetLocalScale() const
+    inline Vector3 GetLocalScale() const
     {
-        return m_LocalScale;
+        return m_Transforms->GetLocalScale(m_TransformHandle);
     };
 
     inline int GetUniqueID() const
@@ -83,18 +86,10 @@ private:
     std::weak_ptr<Scene> m_Scene;
     std::weak_ptr<Renderer> m_Renderer;
     std::vector<std::shared_ptr<Component>> m_Components;
-    Vector3 m_LocalPosition;
-    Quaternion m_LocalRotation = Quaternion();
-    Quaternion m_Rotation = Quaternion();
-    Vector3 m_LocalScale = Vector3::One();
-    Matrix4x4 m_LocalToWorldMatrix = Matrix4x4::Identity();
-    Matrix4x4 m_WorldToLocalMatrix = Matrix4x4::Identity();
-    bool m_DirtyTransform = true;
+    std::shared_ptr<TransformHierarchy> m_Transforms;
+    uint32_t m_TransformHandle;
     int m_UniqueId = -1;
 
-    void InvalidateTransform();
-    void ValidateTransform();
-
     friend class Scene;
 };
 
@@ -0,0 +1,332 @@
+#include "transform_hierarchy.h"
+#include "renderer/renderer.h"
+#include "editor/profiler/profiler.h"
+#include "worker/worker.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace TransformHierarchyLocal
+{
+    constexpr uint32_t k_TransformsPerTask = 2048;
+
+    template<typename T>
+    void Permute(std::vector<T>& values, const std::vector<uint32_t>& order)
+    {
+        std::vector<T> permuted;
+        permuted.reserve(order.size());
+        for (uint32_t slot : order)
+            permuted.push_back(std::move(values[slot]));
+        values = std::move(permuted);
+    }
+}
+
+uint32_t TransformHierarchy::Create()
+{
+    const uint32_t slot = static_cast<uint32_t>(m_Parents.size());
+
+    m_LocalPositions.emplace_back();
+    m_LocalRotations.emplace_back();
+    m_LocalScales.push_back(Vector3::One());
+    m_Parents.push_back(-1);
+    m_LocalToWorldMatrices.push_back(Matrix4x4::Identity());
+    m_WorldToLocalMatrices.push_back(Matrix4x4::Identity());
+    m_Rotations.emplace_back();
+    m_Versions.push_back(0);
+    m_ParentVersions.push_back(0);
+    m_Flags.push_back(LOCAL_DIRTY);
+    m_Renderers.push_back(nullptr);
+
+    uint32_t handle;
+    if (!m_FreeHandles.empty())
+    {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+        m_HandleSlots[handle] = slot;
+    }
+    else
+    {
+        handle = static_cast<uint32_t>(m_HandleSlots.size());
+        m_HandleSlots.push_back(slot);
+    }
+
+    m_SlotHandles.push_back(handle);
+    m_OrderDirty = true;
+    return handle;
+}
+
+void TransformHierarchy::Destroy(uint32_t handle)
+{
+    // slot is removed on the next reorder, version change makes children recompute themselves as roots until then
+    const uint32_t slot = m_HandleSlots[handle];
+    m_Flags[slot] |= DESTROYED;
+    ++m_Versions[slot];
+    m_Renderers[slot] = nullptr;
+    m_SlotHandles[slot] = NullHandle;
+
+    m_HandleSlots[handle] = NullHandle;
+    m_FreeHandles.push_back(handle);
+    m_OrderDirty = true;
+}
+
+void TransformHierarchy::SetParent(uint32_t handle, uint32_t parentHandle)
+{
+    const uint32_t slot = m_HandleSlots[handle];
+    m_Parents[slot] = parentHandle == NullHandle ? -1 : static_cast<int32_t>(m_HandleSlots[parentHandle]);
+    m_Flags[slot] |= LOCAL_DIRTY;
+    m_OrderDirty = true;
+}
+
+void TransformHierarchy::SetRenderer(uint32_t handle, Renderer* renderer)
+{
+    m_Renderers[m_HandleSlots[handle]] = renderer;
+}
+
+void TransformHierarchy::SetLocalPosition(uint32_t handle, const Vector3& position)
+{
+    const uint32_t slot = m_HandleSlots[handle];
+    m_LocalPositions[slot] = position;
+    m_Flags[slot] |= LOCAL_DIRTY;
+}
+
+void TransformHierarchy::SetLocalRotation(uint32_t handle, const Quaternion& rotation)
+{
+    const uint32_t slot = m_HandleSlots[handle];
+    m_LocalRotations[slot] = rotation;
+    m_Flags[slot] |= LOCAL_DIRTY;
+}
+
+void TransformHierarchy::SetLocalScale(uint32_t handle, const Vector3& scale)
+{
+    const uint32_t slot = m_HandleSlots[handle];
+    m_LocalScales[slot] = scale;
+    m_Flags[slot] |= LOCAL_DIRTY;
+}
+
+Vector3 TransformHierarchy::GetLocalPosition(uint32_t handle) const
+{
+    return m_LocalPositions[m_HandleSlots[handle]];
+}
+
+Quaternion TransformHierarchy::GetLocalRotation(uint32_t handle) const
+{
+    return m_LocalRotations[m_HandleSlots[handle]];
+}
+
+Vector3 TransformHierarchy::GetLocalScale(uint32_t handle) const
+{
+    return m_LocalScales[m_HandleSlots[handle]];
+}
+
+Matrix4x4 TransformHierarchy::GetLocalToWorldMatrix(uint32_t handle) const
+{
+    Matrix4x4 localToWorld;
+    Quaternion rotation;
+    ComputeWorldData(m_HandleSlots[handle], localToWorld, rotation);
+    return localToWorld;
+}
+
+Matrix4x4 TransformHierarchy::GetWorldToLocalMatrix(uint32_t handle) const
+{
+    const uint32_t slot = m_HandleSlots[handle];
+
+    Matrix4x4 localToWorld;
+    Quaternion rotation;
+    return ComputeWorldData(slot, localToWorld, rotation) ? localToWorld.Invert() : m_WorldToLocalMatrices[slot];
+}
+
+Quaternion TransformHierarchy::GetRotation(uint32_t handle) const
+{
+    Matrix4x4 localToWorld;
+    Quaternion rotation;
+    ComputeWorldData(m_HandleSlots[handle], localToWorld, rotation);
+    return rotation;
+}
+
+void TransformHierarchy::Update()
+{
+    Profiler::Marker _("TransformHierarchy::Update");
+
+    if (m_OrderDirty)
+        Reorder();
+
+    // slots of the same level do not depend on each other, so big levels are split between workers
+    for (size_t level = 0; level + 1 < m_LevelOffsets.size(); ++level)
+    {
+        const uint32_t begin = m_LevelOffsets[level];
+        const uint32_t end = m_LevelOffsets[level + 1];
+        const uint32_t chunksCount = (end - begin + TransformHierarchyLocal::k_TransformsPerTask - 1) / TransformHierarchyLocal::k_TransformsPerTask;
+
+        auto ProcessChunk = [this, begin, end](uint32_t chunkIndex)
+        {
+            const uint32_t chunkBegin = begin + chunkIndex * TransformHierarchyLocal::k_TransformsPerTask;
+            UpdateRange(chunkBegin, std::min(chunkBegin + TransformHierarchyLocal::k_TransformsPerTask, end));
+        };
+
+        if (chunksCount > 1)
+        {
+            std::shared_ptr<Worker::Task> chunksTask = std::make_shared<Worker::Task>();
+            for (uint32_t i = 1; i < chunksCount; ++i)
+            {
+                std::shared_ptr<Worker::Task> task = Worker::CreateTask([&ProcessChunk, i] { ProcessChunk(i); }, Worker::Priority::TASK);
+                chunksTask->AddDependency(task);
+                task->Schedule();
+            }
+            chunksTask->Schedule();
+
+            ProcessChunk(0);
+            chunksTask->Wait();
+        }
+        else if (chunksCount == 1)
+            ProcessChunk(0);
+    }
+}
+
+bool TransformHierarchy::ComputeWorldData(uint32_t slot, Matrix4x4& outLocalToWorld, Quaternion& outRotation) const
+{
+    // returns true if cached data is outdated, world data is written in both cases
+    const int32_t parent = m_Parents[slot];
+    const bool hasParent = parent >= 0 && !(m_Flags[parent] & DESTROYED);
+
+    bool outdated = (m_Flags[slot] & LOCAL_DIRTY) || (parent >= 0 && m_ParentVersions[slot] != m_Versions[parent]);
+
+    Matrix4x4 parentLocalToWorld;
+    Quaternion parentRotation;
+    if (hasParent)
+        outdated |= ComputeWorldData(parent, parentLocalToWorld, parentRotation);
+
+    if (!outdated)
+    {
+        outLocalToWorld = m_LocalToWorldMatrices[slot];
+        outRotation = m_Rotations[slot];
+        return false;
+    }
+
+    outLocalToWorld = Matrix4x4::TRS(m_LocalPositions[slot], m_LocalRotations[slot], m_LocalScales[slot]);
+    outRotation = m_LocalRotations[slot];
+    if (hasParent)
+    {
+        outLocalToWorld = parentLocalToWorld * outLocalToWorld;
+        outRotation = parentRotation * outRotation;
+    }
+
+    return true;
+}
+
+void TransformHierarchy::Recompute(uint32_t slot)
+{
+    const int32_t parent = m_Parents[slot];
+
+    Matrix4x4 localToWorld = Matrix4x4::TRS(m_LocalPositions[slot], m_LocalRotations[slot], m_LocalScales[slot]);
+    if (parent >= 0 && !(m_Flags[parent] & DESTROYED))
+    {
+        localToWorld = m_LocalToWorldMatrices[parent] * localToWorld;
+        m_Rotations[slot] = m_Rotations[parent] * m_LocalRotations[slot];
+    }
+    else
+        m_Rotations[slot] = m_LocalRotations[slot];
+
+    if (parent >= 0)
+        m_ParentVersions[slot] = m_Versions[parent];
+
+    m_LocalToWorldMatrices[slot] = localToWorld;
+    m_WorldToLocalMatrices[slot] = localToWorld.Invert();
+
+    ++m_Versions[slot];
+    m_Flags[slot] &= ~LOCAL_DIRTY;
+
+    if (Renderer* renderer = m_Renderers[slot])
+        renderer->SetTransformDirty(true);
+}
+
+void TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end)
+{
+    // parents are placed on previous levels and are already up to date
+    for (uint32_t slot = begin; slot < end; ++slot)
+    {
+        const int32_t parent = m_Parents[slot];
+        if ((m_Flags[slot] & LOCAL_DIRTY) || (parent >= 0 && m_ParentVersions[slot] != m_Versions[parent]))
+            Recompute(slot);
+    }
+}
+
+void TransformHierarchy::Reorder()
+{
+    Profiler::Marker _("TransformHierarchy::Reorder");
+
+    m_OrderDirty = false;
+
+    const uint32_t slotsCount = static_cast<uint32_t>(m_Parents.size());
+
+    // children of destroyed objects become roots
+    for (uint32_t slot = 0; slot < slotsCount; ++slot)
+    {
+        const int32_t parent = m_Parents[slot];
+        if (parent >= 0 && (m_Flags[parent] & DESTROYED))
+        {
+            m_Parents[slot] = -1;
+            m_Flags[slot] |= LOCAL_DIRTY;
+        }
+    }
+
+    std::vector<int32_t> depths(slotsCount, -1);
+    std::function<int32_t(uint32_t)> getDepth = [&](uint32_t slot)
+    {
+        if (depths[slot] < 0)
+            depths[slot] = m_Parents[slot] < 0 ? 0 : getDepth(m_Parents[slot]) + 1;
+        return depths[slot];
+    };
+
+    uint32_t levelsCount = 0;
+    for (uint32_t slot = 0; slot < slotsCount; ++slot)
+    {
+        if (!(m_Flags[slot] & DESTROYED))
+            levelsCount = std::max<uint32_t>(levelsCount, getDepth(slot) + 1);
+    }
+
+    // stable counting sort by depth
+    m_LevelOffsets.assign(levelsCount + 1, 0);
+    for (uint32_t slot = 0; slot < slotsCount; ++slot)
+    {
+        if (!(m_Flags[slot] & DESTROYED))
+            ++m_LevelOffsets[depths[slot] + 1];
+    }
+
+    for (uint32_t level = 0; level < levelsCount; ++level)
+        m_LevelOffsets[level + 1] += m_LevelOffsets[level];
+
+    std::vector<uint32_t> order(m_LevelOffsets.back());
+    std::vector<int32_t> newSlots(slotsCount, -1);
+    std::vector<uint32_t> levelPositions(m_LevelOffsets.begin(), m_LevelOffsets.end() - 1);
+    for (uint32_t slot = 0; slot < slotsCount; ++slot)
+    {
+        if (m_Flags[slot] & DESTROYED)
+            continue;
+
+        const uint32_t newSlot = levelPositions[depths[slot]]++;
+        order[newSlot] = slot;
+        newSlots[slot] = static_cast<int32_t>(newSlot);
+    }
+
+    for (int32_t& parent : m_Parents)
+    {
+        if (parent >= 0)
+            parent = newSlots[parent];
+    }
+
+    TransformHierarchyLocal::Permute(m_LocalPositions, order);
+    TransformHierarchyLocal::Permute(m_LocalRotations, order);
+    TransformHierarchyLocal::Permute(m_LocalScales, order);
+    TransformHierarchyLocal::Permute(m_Parents, order);
+    TransformHierarchyLocal::Permute(m_LocalToWorldMatrices, order);
+    TransformHierarchyLocal::Permute(m_WorldToLocalMatrices, order);
+    TransformHierarchyLocal::Permute(m_Rotations, order);
+    TransformHierarchyLocal::Permute(m_Versions, order);
+    TransformHierarchyLocal::Permute(m_ParentVersions, order);
+    TransformHierarchyLocal::Permute(m_Flags, order);
+    TransformHierarchyLocal::Permute(m_Renderers, order);
+    TransformHierarchyLocal::Permute(m_SlotHandles, order);
+
+    for (uint32_t slot = 0; slot < m_SlotHandles.size(); ++slot)
+        m_HandleSlots[m_SlotHandles[slot]] = slot;
+}
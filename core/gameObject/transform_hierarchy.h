@@ -0,0 +1,88 @@
+#ifndef RENDER_ENGINE_TRANSFORM_HIERARCHY_H
+#define RENDER_ENGINE_TRANSFORM_HIERARCHY_H
+
+#include "matrix4x4/matrix4x4.h"
+#include "quaternion/quaternion.h"
+#include "vector3/vector3.h"
+
+#include <cstdint>
+#include <vector>
+
+class Renderer;
+
+// Stores transforms of all scene objects in contiguous arrays sorted by depth, so parents are always placed before children.
+// Objects are addressed by stable handles, array slots change when hierarchy is reordered
+class TransformHierarchy
+{
+public:
+    static constexpr uint32_t NullHandle = ~0U;
+
+    TransformHierarchy() = default;
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy(TransformHierarchy&&) = delete;
+
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(TransformHierarchy&&) = delete;
+
+    uint32_t Create();
+    void Destroy(uint32_t handle);
+
+    void SetParent(uint32_t handle, uint32_t parentHandle);
+    void SetRenderer(uint32_t handle, Renderer* renderer);
+
+    void SetLocalPosition(uint32_t handle, const Vector3& position);
+    void SetLocalRotation(uint32_t handle, const Quaternion& rotation);
+    void SetLocalScale(uint32_t handle, const Vector3& scale);
+
+    // values are returned by copy, because arrays are reallocated when objects are created or reordered
+    Vector3 GetLocalPosition(uint32_t handle) const;
+    Quaternion GetLocalRotation(uint32_t handle) const;
+    Vector3 GetLocalScale(uint32_t handle) const;
+
+    // world data of outdated objects is computed from the parent chain without caching it, so getters can be called from any thread
+    Matrix4x4 GetLocalToWorldMatrix(uint32_t handle) const;
+    Matrix4x4 GetWorldToLocalMatrix(uint32_t handle) const;
+    Quaternion GetRotation(uint32_t handle) const;
+
+    // recomputes all outdated world matrices, level by level
+    void Update();
+
+private:
+    enum SlotFlags : uint8_t
+    {
+        LOCAL_DIRTY = 1 << 0,
+        DESTROYED = 1 << 1,
+    };
+
+    std::vector<Vector3> m_LocalPositions;
+    std::vector<Quaternion> m_LocalRotations;
+    std::vector<Vector3> m_LocalScales;
+    std::vector<int32_t> m_Parents;
+
+    std::vector<Matrix4x4> m_LocalToWorldMatrices;
+    std::vector<Matrix4x4> m_WorldToLocalMatrices;
+    std::vector<Quaternion> m_Rotations;
+
+    // world data is outdated if parent version changed since it was computed
+    std::vector<uint32_t> m_Versions;
+    std::vector<uint32_t> m_ParentVersions;
+    std::vector<uint8_t> m_Flags;
+
+    std::vector<Renderer*> m_Renderers;
+    std::vector<uint32_t> m_SlotHandles;
+
+    std::vector<uint32_t> m_HandleSlots;
+    std::vector<uint32_t> m_FreeHandles;
+
+    // slots of depth N are placed in [m_LevelOffsets[N], m_LevelOffsets[N + 1])
+    std::vector<uint32_t> m_LevelOffsets;
+    bool m_OrderDirty = false;
+
+    bool ComputeWorldData(uint32_t slot, Matrix4x4& outLocalToWorld, Quaternion& outRotation) const;
+    void Recompute(uint32_t slot);
+    void UpdateRange(uint32_t begin, uint32_t end);
+    void Reorder();
+};
+
+#endif //RENDER_ENGINE_TRANSFORM_HIERARCHY_H
@@ -17,7 +17,7 @@ namespace GlobalConstants
     constexpr int SpotLightShadowMapIndex = 6;
     constexpr int PointLightShadowMapIndex = 7;
 
-    constexpr int MatricesData = 4;
+    constexpr int PerDrawDataIndex = 4;
     constexpr int LightingDataIndex = 5;
     constexpr int CameraDataIndex = 6;
     constexpr int ShadowDataIndex = 7;
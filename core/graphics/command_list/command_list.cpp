@@ -0,0 +1,330 @@
+#include "command_list.h"
+#include "graphics_backend_api.h"
+#include "shader/shader.h"
+#include "editor/profiler/profiler.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace CommandListLocal
+{
+    enum class CommandType : uint8_t
+    {
+        BIND_TEXTURE,
+        BIND_SAMPLER,
+        BIND_BUFFER,
+        BIND_CONSTANT_BUFFER,
+        SET_DEPTH_STATE,
+        SET_RASTERIZER_STATE,
+        SET_BLEND_STATE,
+        SET_STENCIL_STATE,
+        SET_STENCIL_VALUE,
+        USE_PROGRAM,
+        USE_SHADER,
+        DRAW_ARRAYS,
+        DRAW_ELEMENTS,
+    };
+
+    struct BindTextureCommand
+    {
+        static constexpr CommandType Type = CommandType::BIND_TEXTURE;
+        GraphicsBackendTexture Texture;
+        uint32_t Index;
+    };
+
+    struct BindSamplerCommand
+    {
+        static constexpr CommandType Type = CommandType::BIND_SAMPLER;
+        GraphicsBackendSampler Sampler;
+        uint32_t Index;
+    };
+
+    struct BindBufferCommand
+    {
+        static constexpr CommandType Type = CommandType::BIND_BUFFER;
+        GraphicsBackendBufferView BufferView;
+        uint32_t Index;
+    };
+
+    struct BindConstantBufferCommand
+    {
+        static constexpr CommandType Type = CommandType::BIND_CONSTANT_BUFFER;
+        GraphicsBackendBuffer Buffer;
+        uint32_t Index;
+        int Offset;
+        int Size;
+    };
+
+    struct SetDepthStateCommand
+    {
+        static constexpr CommandType Type = CommandType::SET_DEPTH_STATE;
+        GraphicsBackendDepthDescriptor Descriptor;
+    };
+
+    struct SetRasterizerStateCommand
+    {
+        static constexpr CommandType Type = CommandType::SET_RASTERIZER_STATE;
+        GraphicsBackendRasterizerDescriptor Descriptor;
+    };
+
+    struct SetBlendStateCommand
+    {
+        static constexpr CommandType Type = CommandType::SET_BLEND_STATE;
+        GraphicsBackendBlendDescriptor Descriptor;
+    };
+
+    struct SetStencilStateCommand
+    {
+        static constexpr CommandType Type = CommandType::SET_STENCIL_STATE;
+        GraphicsBackendStencilDescriptor Descriptor;
+    };
+
+    struct SetStencilValueCommand
+    {
+        static constexpr CommandType Type = CommandType::SET_STENCIL_VALUE;
+        uint8_t Value;
+    };
+
+    struct UseProgramCommand
+    {
+        static constexpr CommandType Type = CommandType::USE_PROGRAM;
+        GraphicsBackendProgram Program;
+    };
+
+    struct UseShaderCommand
+    {
+        static constexpr CommandType Type = CommandType::USE_SHADER;
+        Shader* Shader;
+        const VertexAttributes* VertexAttributes;
+        PrimitiveType PrimitiveType;
+    };
+
+    struct DrawArraysCommand
+    {
+        static constexpr CommandType Type = CommandType::DRAW_ARRAYS;
+        GraphicsBackendGeometry Geometry;
+        PrimitiveType PrimitiveType;
+        int FirstIndex;
+        int IndicesCount;
+        // 0 for not instanced draw
+        int InstanceCount;
+    };
+
+    struct DrawElementsCommand
+    {
+        static constexpr CommandType Type = CommandType::DRAW_ELEMENTS;
+        GraphicsBackendGeometry Geometry;
+        PrimitiveType PrimitiveType;
+        int ElementsCount;
+        IndicesDataType DataType;
+        // 0 for not instanced draw
+        int InstanceCount;
+    };
+
+    template<typename T>
+    T Read(const uint8_t*& data)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        // commands are not aligned in the stream
+        T command;
+        memcpy(&command, data, sizeof(T));
+        data += sizeof(T);
+        return command;
+    }
+}
+
+template<typename T>
+void CommandList::Add(const T& command)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    const size_t offset = m_Data.size();
+    m_Data.resize(offset + 1 + sizeof(T));
+    m_Data[offset] = static_cast<uint8_t>(T::Type);
+    memcpy(m_Data.data() + offset + 1, &command, sizeof(T));
+
+    ++m_CommandsCount;
+}
+
+void CommandList::Clear()
+{
+    m_Data.clear();
+    m_CommandsCount = 0;
+}
+
+bool CommandList::IsEmpty() const
+{
+    return m_CommandsCount == 0;
+}
+
+uint32_t CommandList::GetCommandsCount() const
+{
+    return m_CommandsCount;
+}
+
+void CommandList::BindTexture(const GraphicsBackendTexture& texture, uint32_t index)
+{
+    Add(CommandListLocal::BindTextureCommand{texture, index});
+}
+
+void CommandList::BindSampler(const GraphicsBackendSampler& sampler, uint32_t index)
+{
+    Add(CommandListLocal::BindSamplerCommand{sampler, index});
+}
+
+void CommandList::BindTextureSampler(const GraphicsBackendTexture& texture, const GraphicsBackendSampler& sampler, uint32_t index)
+{
+    BindTexture(texture, index);
+    BindSampler(sampler, index);
+}
+
+void CommandList::BindBuffer(const GraphicsBackendBufferView& bufferView, uint32_t index)
+{
+    Add(CommandListLocal::BindBufferCommand{bufferView, index});
+}
+
+void CommandList::BindConstantBuffer(const GraphicsBackendBuffer& buffer, uint32_t index, int offset, int size)
+{
+    Add(CommandListLocal::BindConstantBufferCommand{buffer, index, offset, size});
+}
+
+void CommandList::SetDepthState(const GraphicsBackendDepthDescriptor& depthDescriptor)
+{
+    Add(CommandListLocal::SetDepthStateCommand{depthDescriptor});
+}
+
+void CommandList::SetRasterizerState(const GraphicsBackendRasterizerDescriptor& rasterizerDescriptor)
+{
+    Add(CommandListLocal::SetRasterizerStateCommand{rasterizerDescriptor});
+}
+
+void CommandList::SetBlendState(const GraphicsBackendBlendDescriptor& blendDescriptor)
+{
+    Add(CommandListLocal::SetBlendStateCommand{blendDescriptor});
+}
+
+void CommandList::SetStencilState(const GraphicsBackendStencilDescriptor& stencilDescriptor)
+{
+    Add(CommandListLocal::SetStencilStateCommand{stencilDescriptor});
+}
+
+void CommandList::SetStencilValue(uint8_t value)
+{
+    Add(CommandListLocal::SetStencilValueCommand{value});
+}
+
+void CommandList::UseProgram(const GraphicsBackendProgram& program)
+{
+    Add(CommandListLocal::UseProgramCommand{program});
+}
+
+void CommandList::UseShader(Shader* shader, const VertexAttributes* vertexAttributes, PrimitiveType primitiveType)
+{
+    Add(CommandListLocal::UseShaderCommand{shader, vertexAttributes, primitiveType});
+}
+
+void CommandList::DrawArrays(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int firstIndex, int indicesCount)
+{
+    Add(CommandListLocal::DrawArraysCommand{geometry, primitiveType, firstIndex, indicesCount, 0});
+}
+
+void CommandList::DrawArraysInstanced(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int firstIndex, int indicesCount, int instanceCount)
+{
+    Add(CommandListLocal::DrawArraysCommand{geometry, primitiveType, firstIndex, indicesCount, instanceCount});
+}
+
+void CommandList::DrawElements(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int elementsCount, IndicesDataType dataType)
+{
+    Add(CommandListLocal::DrawElementsCommand{geometry, primitiveType, elementsCount, dataType, 0});
+}
+
+void CommandList::DrawElementsInstanced(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int elementsCount, IndicesDataType dataType, int instanceCount)
+{
+    Add(CommandListLocal::DrawElementsCommand{geometry, primitiveType, elementsCount, dataType, instanceCount});
+}
+
+void CommandList::Execute() const
+{
+    using namespace CommandListLocal;
+
+    Profiler::Marker _("CommandList::Execute");
+
+    GraphicsBackendBase* backend = GraphicsBackend::Current();
+
+    const uint8_t* data = m_Data.data();
+    const uint8_t* end = data + m_Data.size();
+    while (data < end)
+    {
+        const CommandType type = static_cast<CommandType>(*data++);
+        switch (type)
+        {
+            case CommandType::BIND_TEXTURE:
+            {
+                const BindTextureCommand command = Read<BindTextureCommand>(data);
+                backend->BindTexture(command.Texture, command.Index);
+                break;
+            }
+            case CommandType::BIND_SAMPLER:
+            {
+                const BindSamplerCommand command = Read<BindSamplerCommand>(data);
+                backend->BindSampler(command.Sampler, command.Index);
+                break;
+            }
+            case CommandType::BIND_BUFFER:
+            {
+                const BindBufferCommand command = Read<BindBufferCommand>(data);
+                backend->BindBuffer(command.BufferView, command.Index);
+                break;
+            }
+            case CommandType::BIND_CONSTANT_BUFFER:
+            {
+                const BindConstantBufferCommand command = Read<BindConstantBufferCommand>(data);
+                backend->BindConstantBuffer(command.Buffer, command.Index, command.Offset, command.Size);
+                break;
+            }
+            case CommandType::SET_DEPTH_STATE:
+                backend->SetDepthState(Read<SetDepthStateCommand>(data).Descriptor);
+                break;
+            case CommandType::SET_RASTERIZER_STATE:
+                backend->SetRasterizerState(Read<SetRasterizerStateCommand>(data).Descriptor);
+                break;
+            case CommandType::SET_BLEND_STATE:
+                backend->SetBlendState(Read<SetBlendStateCommand>(data).Descriptor);
+                break;
+            case CommandType::SET_STENCIL_STATE:
+                backend->SetStencilState(Read<SetStencilStateCommand>(data).Descriptor);
+                break;
+            case CommandType::SET_STENCIL_VALUE:
+                backend->SetStencilValue(Read<SetStencilValueCommand>(data).Value);
+                break;
+            case CommandType::USE_PROGRAM:
+                backend->UseProgram(Read<UseProgramCommand>(data).Program);
+                break;
+            case CommandType::USE_SHADER:
+            {
+                const UseShaderCommand command = Read<UseShaderCommand>(data);
+                backend->UseProgram(command.Shader->GetProgram(*command.VertexAttributes, command.PrimitiveType));
+                break;
+            }
+            case CommandType::DRAW_ARRAYS:
+            {
+                const DrawArraysCommand command = Read<DrawArraysCommand>(data);
+                if (command.InstanceCount > 0)
+                    backend->DrawArraysInstanced(command.Geometry, command.PrimitiveType, command.FirstIndex, command.IndicesCount, command.InstanceCount);
+                else
+                    backend->DrawArrays(command.Geometry, command.PrimitiveType, command.FirstIndex, command.IndicesCount);
+                break;
+            }
+            case CommandType::DRAW_ELEMENTS:
+            {
+                const DrawElementsCommand command = Read<DrawElementsCommand>(data);
+                if (command.InstanceCount > 0)
+                    backend->DrawElementsInstanced(command.Geometry, command.PrimitiveType, command.ElementsCount, command.DataType, command.InstanceCount);
+                else
+                    backend->DrawElements(command.Geometry, command.PrimitiveType, command.ElementsCount, command.DataType);
+                break;
+            }
+        }
+    }
+}
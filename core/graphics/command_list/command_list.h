@@ -0,0 +1,64 @@
+#ifndef RENDER_ENGINE_COMMAND_LIST_H
+#define RENDER_ENGINE_COMMAND_LIST_H
+
+#include "types/graphics_backend_texture.h"
+#include "types/graphics_backend_sampler.h"
+#include "types/graphics_backend_buffer.h"
+#include "types/graphics_backend_buffer_view.h"
+#include "types/graphics_backend_geometry.h"
+#include "types/graphics_backend_program.h"
+#include "types/graphics_backend_depth_descriptor.h"
+#include "types/graphics_backend_stencil_descriptor.h"
+#include "types/graphics_backend_rasterizer_descriptor.h"
+#include "types/graphics_backend_blend_descriptor.h"
+
+#include <cstdint>
+#include <vector>
+
+class Shader;
+class VertexAttributes;
+enum class PrimitiveType;
+enum class IndicesDataType;
+
+// Records draw commands of a pass on any thread, so they can be executed later on the main thread inside the pass.
+// Render pass setup and buffer uploads are not recorded and stay on the main thread. Resources must stay alive until the list is executed
+class CommandList
+{
+public:
+    void Clear();
+    bool IsEmpty() const;
+    uint32_t GetCommandsCount() const;
+
+    void BindTexture(const GraphicsBackendTexture& texture, uint32_t index);
+    void BindSampler(const GraphicsBackendSampler& sampler, uint32_t index);
+    void BindTextureSampler(const GraphicsBackendTexture& texture, const GraphicsBackendSampler& sampler, uint32_t index);
+    void BindBuffer(const GraphicsBackendBufferView& bufferView, uint32_t index);
+    void BindConstantBuffer(const GraphicsBackendBuffer& buffer, uint32_t index, int offset, int size);
+
+    void SetDepthState(const GraphicsBackendDepthDescriptor& depthDescriptor);
+    void SetRasterizerState(const GraphicsBackendRasterizerDescriptor& rasterizerDescriptor);
+    void SetBlendState(const GraphicsBackendBlendDescriptor& blendDescriptor);
+    void SetStencilState(const GraphicsBackendStencilDescriptor& stencilDescriptor);
+    void SetStencilValue(uint8_t value);
+
+    void UseProgram(const GraphicsBackendProgram& program);
+    // program is selected on execution, because it depends on render targets and states set at that moment
+    void UseShader(Shader* shader, const VertexAttributes* vertexAttributes, PrimitiveType primitiveType);
+
+    void DrawArrays(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int firstIndex, int indicesCount);
+    void DrawArraysInstanced(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int firstIndex, int indicesCount, int instanceCount);
+    void DrawElements(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int elementsCount, IndicesDataType dataType);
+    void DrawElementsInstanced(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int elementsCount, IndicesDataType dataType, int instanceCount);
+
+    void Execute() const;
+
+private:
+    // commands are stored as a type byte followed by command data
+    std::vector<uint8_t> m_Data;
+    uint32_t m_CommandsCount = 0;
+
+    template<typename T>
+    void Add(const T& command);
+};
+
+#endif //RENDER_ENGINE_COMMAND_LIST_H
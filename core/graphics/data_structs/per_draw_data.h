@@ -0,0 +1,15 @@
+#ifndef RENDER_ENGINE_PER_DRAW_DATA_H
+#define RENDER_ENGINE_PER_DRAW_DATA_H
+
+#include <cstdint>
+
+// Keep in-sync with shaders/common/per_draw_data.h
+struct PerDrawData
+{
+    uint32_t MatricesEntry = 0;
+    uint32_t Padding0 = 0;
+    uint32_t Padding1 = 0;
+    uint32_t Padding2 = 0;
+};
+
+#endif //RENDER_ENGINE_PER_DRAW_DATA_H
@@ -3,10 +3,8 @@
 
 #include "bounds/bounds.h"
 #include "matrix4x4/matrix4x4.h"
-#include "graphics_buffer/graphics_buffer_view.h"
 
 #include <cstdint>
-#include <vector>
 
 class DrawableGeometry;
 class Material;
@@ -15,12 +13,16 @@ struct DrawCallInfo
 {
     const DrawableGeometry* Geometry = nullptr;
     const Material* Material = nullptr;
-    std::vector<std::shared_ptr<GraphicsBufferView>> MatricesBufferViews;
     Bounds AABB{};
+    // index of object matrices in render queue matrices buffer
+    uint32_t MatricesEntry = 0;
+    // range of instances entries in render queue, filled when draw calls are batched
+    uint32_t InstancesOffset = 0;
+    uint32_t InstancesCount = 1;
     bool CastShadows = false;
     bool Instanced = false;
     uint8_t StencilValue = 0;
-    std::shared_ptr<GraphicsBufferView> InstancedMatricesEntriesView;
+    uint64_t SortKey = 0;
 };
 
 #endif
\ No newline at end of file
@@ -38,6 +38,9 @@
 #include "passes/post_process_pass.h"
 #include "developer_console/developer_console.h"
 #include "arguments.h"
+#include "memory/frame_allocator.h"
+#include "shader/pipeline_cache/pipeline_cache.h"
+#include "texture_streamer/texture_streamer.h"
 
 #include <cassert>
 
@@ -127,7 +130,7 @@ namespace Graphics
 #endif
     }
 
-    void SetLightingData(const std::vector<Light*>& lights, const std::shared_ptr<Texture>& skybox)
+    void SetLightingData(std::span<Light* const> lights, const std::shared_ptr<Texture>& skybox)
     {
         const std::shared_ptr<Texture> reflectionCube = skybox ? skybox : Cubemap::White();
 
@@ -136,7 +139,7 @@ namespace Graphics
         lightingData.PointLightsCount = 0;
         lightingData.SpotLightsCount = 0;
         lightingData.HasDirectionalLight = -1;
-        lightingData.ReflectionCubeMips = reflectionCube->GetMipLevels();
+        lightingData.ReflectionCubeMips = reflectionCube->GetResidentMipLevels();
 
         for (Light* light : lights)
         {
@@ -170,6 +173,9 @@ namespace Graphics
 
         GraphicsBackend::Current()->BindTextureSampler(reflectionCube->GetBackendTexture(), reflectionCube->GetBackendSampler(), GlobalConstants::ReflectionCubeIndex);
 
+        // reflections of any roughness can be visible, so all mips are required
+        TextureStreamer::RequestMip(*reflectionCube, 0);
+
         s_LightingDataBuffer->SetData(&lightingData, 0, sizeof(lightingData));
         GraphicsBackend::Current()->BindConstantBuffer(s_LightingDataBuffer->GetBackendBuffer(), GlobalConstants::LightingDataIndex, 0, sizeof(lightingData));
     }
@@ -181,6 +187,11 @@ namespace Graphics
 
         Profiler::Marker marker("Graphics::Prepare");
 
+        // render data and draw calls of previous frame are stored in frame memory, it is reused only after all its users are finished
+        if (s_PrepareTask)
+            s_PrepareTask->Wait();
+        FrameAllocator::BeginFrame();
+
         s_ScreenWidth = width;
         s_ScreenHeight = height;
 
@@ -246,10 +257,14 @@ namespace Graphics
 
         Profiler::Marker marker("Graphics::Render");
 
+        // streamed textures are replaced only when render queues referencing them are recorded
+        TextureStreamer::Update();
+
         GraphicsBackend::Current()->SetClearColor(0, 0, 0, 0);
         GraphicsBackend::Current()->SetClearDepth(1);
 
         SetLightingData(s_RenderData.Lights, s_RenderData.Skybox);
+        RenderQueue::UploadMatrices();
 
     	s_ShadowCasterPass->Execute(s_RenderData);
         s_ForwardRenderPass->Execute(s_RenderData);
@@ -265,6 +280,34 @@ namespace Graphics
 #endif
         s_FinalBlitPass->Execute(s_RenderData);
 
+        const FrameAllocator::Stats frameAllocatorStats = FrameAllocator::GetStats();
+        Profiler::SetCounter("FrameAllocator.Allocations", frameAllocatorStats.Allocations);
+        Profiler::SetCounter("FrameAllocator.Bytes", frameAllocatorStats.Bytes);
+        Profiler::SetCounter("FrameAllocator.SlabAllocations", frameAllocatorStats.SlabAllocations);
+
+        const RingBuffer::Stats& cameraDataStats = s_CameraDataBuffer->GetStats();
+        Profiler::SetCounter("CameraData.HighWaterBytes", cameraDataStats.HighWaterBytes);
+        Profiler::SetCounter("CameraData.Blocks", cameraDataStats.BlocksCount);
+
+        const GraphicsBackendBase::BindingStats& bindingStats = GraphicsBackend::Current()->GetBindingStats();
+        Profiler::SetCounter("Backend.BindsIssued", bindingStats.Issued);
+        Profiler::SetCounter("Backend.BindsSkipped", bindingStats.Skipped);
+
+        const PipelineCache::Stats pipelineCacheStats = PipelineCache::GetStats();
+        Profiler::SetCounter("PipelineCache.Hits", pipelineCacheStats.Hits);
+        Profiler::SetCounter("PipelineCache.Misses", pipelineCacheStats.Misses);
+        Profiler::SetCounter("PipelineCache.CompileTimeUs", pipelineCacheStats.CompileTimeUs);
+        Profiler::SetCounter("PipelineCache.PrewarmedPrograms", pipelineCacheStats.PrewarmedPrograms);
+        PipelineCache::ResetFrameStats();
+
+        const TextureStreamer::Stats textureStreamerStats = TextureStreamer::GetStats();
+        Profiler::SetCounter("TextureStreamer.BudgetBytes", textureStreamerStats.BudgetBytes);
+        Profiler::SetCounter("TextureStreamer.ResidentBytes", textureStreamerStats.ResidentBytes);
+        Profiler::SetCounter("TextureStreamer.RequestedBytes", textureStreamerStats.RequestedBytes);
+        Profiler::SetCounter("TextureStreamer.StreamedTextures", textureStreamerStats.StreamedTextures);
+        Profiler::SetCounter("TextureStreamer.PendingUpdates", textureStreamerStats.PendingUpdates);
+        Profiler::SetCounter("TextureStreamer.LoadedMips", textureStreamerStats.LoadedMips);
+        Profiler::SetCounter("TextureStreamer.EvictedMips", textureStreamerStats.EvictedMips);
     }
 
     int GetScreenWidth()
@@ -18,7 +18,7 @@ void DrawRenderersPass::Prepare(RenderData& renderData)
 {
     Profiler::Marker marker("DrawRenderersPass::Prepare");
 
-    m_RenderQueue.Prepare(renderData.ProjectionMatrix * renderData.ViewMatrix, renderData.Renderers, m_RenderSettings);
+    m_RenderQueue.Prepare(renderData.ProjectionMatrix * renderData.ViewMatrix, renderData.CurrentScene, m_RenderSettings);
 }
 
 void DrawRenderersPass::Execute(const RenderData& renderData)
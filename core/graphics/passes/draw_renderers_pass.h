@@ -2,7 +2,7 @@
 #define RENDER_ENGINE_DRAW_RENDERERS_PASS_H
 
 #include "render_pass.h"
-#include "graphics/render_settings/draw_call_comparer.h"
+#include "graphics/render_settings/draw_call_sort.h"
 #include "graphics/render_settings/draw_call_filter.h"
 #include "graphics/render_settings/render_settings.h"
 #include "graphics/render_queue/render_queue.h"
@@ -31,6 +31,7 @@ PostProcessPass::PostProcessPass() :
 
     m_PostProcessShader = Shader::Load("core_resources/shaders/post_process", {});
     m_PostProcessDataBuffer = std::make_shared<GraphicsBuffer>(bufferDescriptor, "Post Process Data");
+    m_FullscreenMesh = Mesh::GetFullscreenMesh();
 }
 
 void PostProcessPass::Prepare(RenderData& renderData)
@@ -48,6 +49,14 @@ void PostProcessPass::Prepare(RenderData& renderData)
     }
 
     renderData.PostProcessedTarget = m_PostProcessedTarget;
+
+    // graphics settings are read and uploaded on the main thread in execute, only the draw is recorded
+    m_CommandList.Clear();
+    m_CommandList.BindConstantBuffer(m_PostProcessDataBuffer->GetBackendBuffer(), 0, 0, sizeof(PostProcessPass_Local::Data));
+    m_CommandList.BindTextureSampler(renderData.CameraColorTarget->GetBackendTexture(), renderData.CameraColorTarget->GetBackendSampler(), 0);
+    m_CommandList.SetDepthState(GraphicsBackendDepthDescriptor::Disabled());
+    m_CommandList.UseShader(m_PostProcessShader.get(), &m_FullscreenMesh->GetVertexAttributes(), m_FullscreenMesh->GetPrimitiveType());
+    m_CommandList.DrawElements(m_FullscreenMesh->GetGraphicsBackendGeometry(), m_FullscreenMesh->GetPrimitiveType(), m_FullscreenMesh->GetElementsCount(), m_FullscreenMesh->GetIndicesDataType());
 }
 
 void PostProcessPass::Execute(const RenderData& renderData)
@@ -72,13 +81,7 @@ void PostProcessPass::Execute(const RenderData& renderData)
         Profiler::GPUMarker gpuMarker("PostProcessPass::Execute");
 
         m_PostProcessDataBuffer->SetData(&data, 0, sizeof(data));
-        GraphicsBackend::Current()->BindConstantBuffer(m_PostProcessDataBuffer->GetBackendBuffer(), 0, 0, sizeof(data));
-        GraphicsBackend::Current()->BindTextureSampler(renderData.CameraColorTarget->GetBackendTexture(), renderData.CameraColorTarget->GetBackendSampler(), 0);
-        GraphicsBackend::Current()->SetDepthState(GraphicsBackendDepthDescriptor::Disabled());
-
-        const std::shared_ptr<Mesh> fullscreenMesh = Mesh::GetFullscreenMesh();
-        GraphicsBackend::Current()->UseProgram(m_PostProcessShader->GetProgram(fullscreenMesh));
-        GraphicsBackend::Current()->DrawElements(fullscreenMesh->GetGraphicsBackendGeometry(), fullscreenMesh->GetPrimitiveType(), fullscreenMesh->GetElementsCount(), fullscreenMesh->GetIndicesDataType());
+        m_CommandList.Execute();
     }
     GraphicsBackend::Current()->EndRenderPass();
 }
@@ -2,11 +2,13 @@
 #define RENDER_ENGINE_POST_PROCESS_PASS_H
 
 #include "render_pass.h"
+#include "graphics/command_list/command_list.h"
 
 struct RenderData;
 class Shader;
 class GraphicsBuffer;
 class Texture;
+class Mesh;
 
 class PostProcessPass : public RenderPass
 {
@@ -21,6 +23,10 @@ private:
     std::shared_ptr<Shader> m_PostProcessShader;
     std::shared_ptr<GraphicsBuffer> m_PostProcessDataBuffer;
     std::shared_ptr<Texture> m_PostProcessedTarget;
+    // fullscreen mesh is created lazily, so it is taken on the main thread and not during prepare
+    std::shared_ptr<Mesh> m_FullscreenMesh;
+
+    CommandList m_CommandList;
 };
 
 
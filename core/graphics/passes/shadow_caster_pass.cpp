@@ -2,6 +2,7 @@
 #include "graphics/graphics.h"
 #include "graphics/render_data.h"
 #include "graphics_buffer/graphics_buffer.h"
+#include "graphics_buffer/ring_buffer.h"
 #include "graphics/render_settings/render_settings.h"
 #include "light/light.h"
 #include "renderer/renderer.h"
@@ -129,7 +130,7 @@ void ShadowCasterPass::Prepare(RenderData& renderData)
             const Matrix4x4 viewProj = proj * view;
 
             m_SpotLightCameraData[spotLightIndex] = {view, proj, lightGo->GetPosition().ToVector4(1), farPlane};
-            m_SpotLightRenderQueues[spotLightIndex].Prepare(viewProj, renderData.Renderers, punctualLightRenderSettings);
+            m_SpotLightRenderQueues[spotLightIndex].Prepare(viewProj, renderData.CurrentScene, punctualLightRenderSettings);
             m_ShadowsGPUData.SpotLightsViewProjMatrices[spotLightIndex] = m_BiasMatrix * viewProj;
 
             ++spotLightIndex;
@@ -140,16 +141,23 @@ void ShadowCasterPass::Prepare(RenderData& renderData)
 
             const float farPlane = std::min(light->Range, shadowsDistance);
             const Matrix4x4 proj = Matrix4x4::Perspective(90, 1, 0.01f, farPlane);
+
+            RenderQueue* faceQueues[6];
+            Matrix4x4 faceViewProjMatrices[6];
             for (int i = 0; i < 6; ++i)
             {
                 const Matrix4x4 view = pointLightViewMatrices[i] * Matrix4x4::Translation(-lightGo->GetPosition());
                 const Matrix4x4 viewProj = proj * view;
 
                 m_PointLightCameraData[pointLightsIndex * 6 + i] = {view, proj, lightGo->GetPosition().ToVector4(1), farPlane};
-                m_PointLightsRenderQueues[pointLightsIndex * 6 + i].Prepare(viewProj, renderData.Renderers, punctualLightRenderSettings);
                 m_ShadowsGPUData.PointLightShadows[pointLightsIndex].ViewProjMatrices[i] = m_BiasMatrix * viewProj;
+
+                faceQueues[i] = &m_PointLightsRenderQueues[pointLightsIndex * 6 + i];
+                faceViewProjMatrices[i] = viewProj;
             }
 
+            RenderQueue::Prepare(faceQueues, faceViewProjMatrices, renderData.CurrentScene, punctualLightRenderSettings);
+
             m_ShadowsGPUData.PointLightShadows[pointLightsIndex].Position = lightGo->GetPosition().ToVector4(0);
 
             ++pointLightsIndex;
@@ -158,25 +166,22 @@ void ShadowCasterPass::Prepare(RenderData& renderData)
         {
             Profiler::Marker marker("Prepare Directional Light");
 
-            std::shared_ptr<Worker::Task> cascadesPrepareTask = std::make_shared<Worker::Task>();
-            for (int i = GlobalConstants::ShadowCascadeCount - 1; i > 0; --i)
-            {
-                std::shared_ptr<Worker::Task> task = Worker::CreateTask([this, i, &renderData, &lightGo] { PrepareCascade(i, renderData, lightGo); }, Worker::Priority::TASK);
-                cascadesPrepareTask->AddDependency(task);
+            const RenderSettings dirLightShadowRenderSettings{ DrawCallSortMode::NO_SORTING, DrawCallFilter::ShadowCasters(), m_Material, Frustum::SidePlanesBits };
 
-                if (!Graphics::IsPrepareSynchronous())
-                    task->Schedule();
+            CascadeCullingData cascadesCullingData[GlobalConstants::ShadowCascadeCount];
+            RenderQueue* cascadeQueues[GlobalConstants::ShadowCascadeCount];
+            Matrix4x4 cascadeCullingMatrices[GlobalConstants::ShadowCascadeCount];
+            for (int i = 0; i < GlobalConstants::ShadowCascadeCount; ++i)
+            {
+                cascadesCullingData[i] = GetCascadeCullingData(i, renderData, lightGo);
+                cascadeQueues[i] = &m_DirectionalLightRenderQueues[i];
+                cascadeCullingMatrices[i] = cascadesCullingData[i].CullingViewProjMatrix;
             }
 
-            if (!Graphics::IsPrepareSynchronous())
-                cascadesPrepareTask->Schedule();
-
-            PrepareCascade(0, renderData, lightGo);
+            RenderQueue::Prepare(cascadeQueues, cascadeCullingMatrices, renderData.CurrentScene, dirLightShadowRenderSettings);
 
-            if (Graphics::IsPrepareSynchronous())
-                cascadesPrepareTask->Execute();
-            else
-                cascadesPrepareTask->Wait();
+            for (int i = 0; i < GlobalConstants::ShadowCascadeCount; ++i)
+                FinishCascade(i, cascadesCullingData[i], lightGo);
         }
     }
 }
@@ -215,6 +220,10 @@ void ShadowCasterPass::Execute(const RenderData& renderData)
     GraphicsBackend::Current()->BindTextureSampler(m_DirectionLightShadowMap->GetBackendTexture(), m_DirectionLightShadowMap->GetBackendSampler(), GlobalConstants::DirectionalShadowMapIndex);
     GraphicsBackend::Current()->BindTextureSampler(m_SpotLightShadowMapArray->GetBackendTexture(), m_SpotLightShadowMapArray->GetBackendSampler(), GlobalConstants::SpotLightShadowMapIndex);
     GraphicsBackend::Current()->BindTextureSampler(m_PointLightShadowMap->GetBackendTexture(), m_PointLightShadowMap->GetBackendSampler(), GlobalConstants::PointLightShadowMapIndex);
+
+    const RingBuffer::Stats& passBufferStats = m_ShadowCasterPassBuffer->GetStats();
+    Profiler::SetCounter("ShadowCasterPassBuffer.HighWaterBytes", passBufferStats.HighWaterBytes);
+    Profiler::SetCounter("ShadowCasterPassBuffer.Blocks", passBufferStats.BlocksCount);
 }
 
 void ShadowCasterPass::Render(RenderQueue& renderQueue, const std::shared_ptr<Texture>& target, int targetLayer, const ShadowsCameraData& cameraData, const std::string& passName)
@@ -253,10 +262,8 @@ void ShadowCasterPass::Render(RenderQueue& renderQueue, const std::shared_ptr<Te
     }
 }
 
-void ShadowCasterPass::PrepareCascade(int cascade, RenderData& renderData, const std::shared_ptr<GameObject>& lightGameObject)
+ShadowCasterPass::CascadeCullingData ShadowCasterPass::GetCascadeCullingData(int cascade, const RenderData& renderData, const std::shared_ptr<GameObject>& lightGameObject) const
 {
-    Profiler::Marker _("ShadowCasterPass::PrepareCascade");
-
     const Vector3 corners[8] =
     {
         {-1, -1, -1},
@@ -297,8 +304,16 @@ void ShadowCasterPass::PrepareCascade(int cascade, RenderData& renderData, const
     const float maxExtentViewSpace = std::max(viewExtents.x, viewExtents.y);
     const Matrix4x4 cullingProjMatrix = Matrix4x4::Orthographic(-maxExtentViewSpace, maxExtentViewSpace, -maxExtentViewSpace, maxExtentViewSpace, 0.01f, viewMax.z - viewMin.z);
 
-    const RenderSettings dirLightShadowRenderSettings{ DrawCallSortMode::NO_SORTING, DrawCallFilter::ShadowCasters(), m_Material, Frustum::SidePlanesBits };
-    m_DirectionalLightRenderQueues[cascade].Prepare(cullingProjMatrix * cullingViewMatrix, renderData.Renderers, dirLightShadowRenderSettings);
+    return { rotationViewMatrix, cullingProjMatrix * cullingViewMatrix, viewMin, viewMax, viewOffset, maxExtentViewSpace };
+}
+
+void ShadowCasterPass::FinishCascade(int cascade, const CascadeCullingData& cullingData, const std::shared_ptr<GameObject>& lightGameObject)
+{
+    const Matrix4x4& rotationViewMatrix = cullingData.RotationViewMatrix;
+    const Vector3& viewOffset = cullingData.ViewOffset;
+    const float maxExtentViewSpace = cullingData.MaxExtentViewSpace;
+    Vector3 viewMin = cullingData.ViewMin;
+    Vector3 viewMax = cullingData.ViewMax;
 
     const std::vector<DrawCallInfo>& dirLightShadowDrawCalls = m_DirectionalLightRenderQueues[cascade].GetDrawCalls();
     for (const DrawCallInfo& drawCallInfo : dirLightShadowDrawCalls)
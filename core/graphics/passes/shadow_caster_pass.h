@@ -46,6 +46,16 @@ private:
         float FarPlane;
     };
 
+    struct CascadeCullingData
+    {
+        Matrix4x4 RotationViewMatrix;
+        Matrix4x4 CullingViewProjMatrix;
+        Vector3 ViewMin;
+        Vector3 ViewMax;
+        Vector3 ViewOffset;
+        float MaxExtentViewSpace;
+    };
+
     std::shared_ptr<GraphicsBuffer> m_ShadowsConstantBuffer;
     std::shared_ptr<Texture2DArray> m_SpotLightShadowMapArray;
     std::shared_ptr<Texture2DArray> m_DirectionLightShadowMap;
@@ -67,7 +77,8 @@ private:
     std::shared_ptr<Material> m_Material;
 
     void Render(RenderQueue& renderQueue, const std::shared_ptr<Texture>& target, int targetLayer, const ShadowsCameraData &cameraData, const std::string& passName);
-    void PrepareCascade(int cascade, RenderData& renderData, const std::shared_ptr<GameObject>& lightGameObject);
+    CascadeCullingData GetCascadeCullingData(int cascade, const RenderData& renderData, const std::shared_ptr<GameObject>& lightGameObject) const;
+    void FinishCascade(int cascade, const CascadeCullingData& cullingData, const std::shared_ptr<GameObject>& lightGameObject);
 };
 
 #endif //RENDER_ENGINE_SHADOW_CASTER_PASS_H
@@ -8,45 +8,55 @@
 #include "resources/resources.h"
 #include "types/graphics_backend_buffer_descriptor.h"
 
-std::shared_ptr<Mesh> SkyboxPass::m_Mesh = nullptr;
-
-void SkyboxPass::Prepare(RenderData& renderData)
-{
-    if (!m_Mesh)
-        m_Mesh = Resources::Load<Mesh>("core_resources/models/Cube");
-}
-
-void SkyboxPass::Execute(const RenderData& renderData)
+namespace SkyboxPass_Local
 {
     struct SkyboxData
     {
         Matrix4x4 MVPMatrix;
     };
+}
 
+std::shared_ptr<Mesh> SkyboxPass::m_Mesh = nullptr;
+
+SkyboxPass::SkyboxPass() :
+    RenderPass()
+{
     GraphicsBackendBufferDescriptor bufferDescriptor{};
     bufferDescriptor.AllowCPUWrites = true;
-    bufferDescriptor.Size = sizeof(SkyboxData);
+    bufferDescriptor.Size = sizeof(SkyboxPass_Local::SkyboxData);
 
-    static const std::shared_ptr<Shader> shader = Shader::Load("core_resources/shaders/skybox", {});
-    static const std::shared_ptr<GraphicsBuffer> buffer = std::make_shared<GraphicsBuffer>(bufferDescriptor, "Skybox Data");
+    m_Shader = Shader::Load("core_resources/shaders/skybox", {});
+    m_DataBuffer = std::make_shared<GraphicsBuffer>(bufferDescriptor, "Skybox Data");
+}
 
+void SkyboxPass::Prepare(RenderData& renderData)
+{
+    if (!m_Mesh)
+        m_Mesh = Resources::Load<Mesh>("core_resources/models/Cube");
+
+    m_CommandList.Clear();
     if (m_Mesh == nullptr || renderData.Skybox == nullptr)
         return;
 
-    auto debugGroup = GraphicsBackendDebugGroup("Skybox pass", GPUQueue::RENDER);
+    m_CommandList.BindConstantBuffer(m_DataBuffer->GetBackendBuffer(), 0, 0, sizeof(SkyboxPass_Local::SkyboxData));
+    m_CommandList.BindTextureSampler(renderData.Skybox->GetBackendTexture(), renderData.Skybox->GetBackendSampler(), 0);
+    m_CommandList.SetRasterizerState(GraphicsBackendRasterizerDescriptor::CullFront());
+    m_CommandList.UseShader(m_Shader.get(), &m_Mesh->GetVertexAttributes(), m_Mesh->GetPrimitiveType());
+    m_CommandList.DrawElements(m_Mesh->GetGraphicsBackendGeometry(), m_Mesh->GetPrimitiveType(), m_Mesh->GetElementsCount(), m_Mesh->GetIndicesDataType());
+}
 
-    const Matrix4x4 modelMatrix = Matrix4x4::Translation(renderData.ViewMatrix.Invert().GetPosition());
-    const Matrix4x4 mvpMatrix = renderData.ProjectionMatrix * renderData.ViewMatrix * modelMatrix;
+void SkyboxPass::Execute(const RenderData& renderData)
+{
+    if (m_CommandList.IsEmpty())
+        return;
 
-    SkyboxData data{};
-    data.MVPMatrix = mvpMatrix;
+    auto debugGroup = GraphicsBackendDebugGroup("Skybox pass", GPUQueue::RENDER);
 
-    buffer->SetData(&data, 0, sizeof(data));
-    GraphicsBackend::Current()->BindConstantBuffer(buffer->GetBackendBuffer(), 0, 0, sizeof(data));
+    const Matrix4x4 modelMatrix = Matrix4x4::Translation(renderData.ViewMatrix.Invert().GetPosition());
 
-    GraphicsBackend::Current()->BindTextureSampler(renderData.Skybox->GetBackendTexture(), renderData.Skybox->GetBackendSampler(), 0);
+    SkyboxPass_Local::SkyboxData data{};
+    data.MVPMatrix = renderData.ProjectionMatrix * renderData.ViewMatrix * modelMatrix;
 
-    GraphicsBackend::Current()->SetRasterizerState(GraphicsBackendRasterizerDescriptor::CullFront());
-    GraphicsBackend::Current()->UseProgram(shader->GetProgram(m_Mesh));
-    GraphicsBackend::Current()->DrawElements(m_Mesh->GetGraphicsBackendGeometry(), m_Mesh->GetPrimitiveType(), m_Mesh->GetElementsCount(), m_Mesh->GetIndicesDataType());
+    m_DataBuffer->SetData(&data, 0, sizeof(data));
+    m_CommandList.Execute();
 }
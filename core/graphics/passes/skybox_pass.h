@@ -2,14 +2,17 @@
 #define RENDER_ENGINE_SKYBOX_PASS_H
 
 #include "render_pass.h"
+#include "graphics/command_list/command_list.h"
 
 struct RenderData;
 class Mesh;
+class Shader;
+class GraphicsBuffer;
 
 class SkyboxPass : public RenderPass
 {
 public:
-    SkyboxPass() = default;
+    SkyboxPass();
     ~SkyboxPass() override = default;
 
     void Prepare(RenderData& renderData) override;
@@ -23,6 +26,10 @@ public:
 
 private:
     static std::shared_ptr<Mesh> m_Mesh;
+
+    std::shared_ptr<Shader> m_Shader;
+    std::shared_ptr<GraphicsBuffer> m_DataBuffer;
+    CommandList m_CommandList;
 };
 
 #endif //RENDER_ENGINE_SKYBOX_PASS_H
@@ -4,6 +4,7 @@
 #include "renderer/renderer.h"
 #include "scene/scene.h"
 #include "light/light.h"
+#include "memory/frame_allocator.h"
 
 RenderData RenderData::GetRenderData(int viewportWidth, int viewportHeight)
 {
@@ -24,30 +25,18 @@ RenderData RenderData::GetRenderData(int viewportWidth, int viewportHeight)
     data.ViewMatrix = camera->GetGameObject()->GetWorldToLocalMatrix();
     data.ProjectionMatrix = Matrix4x4::Perspective(data.FoV, data.Viewport.x / data.Viewport.y, camera->GetNearClipPlane(), camera->GetFarClipPlane());
 
-    const std::vector<std::shared_ptr<GameObject>>& gameObjects = Scene::Current->GetRootGameObjects();
-    for (const std::shared_ptr<GameObject>& go : gameObjects)
-        data.CollectRenderers(go);
+    scene->UpdateRenderersBounds();
+    data.CurrentScene = scene;
+    data.Renderers = scene->GetRenderers();
 
+    std::span<Light*> lights = FrameAllocator::AllocateArray<Light*>(Light::s_Lights.size());
+    size_t lightsCount = 0;
     for (Light* light : Light::s_Lights)
     {
         if (light != nullptr)
-            data.Lights.push_back(light);
+            lights[lightsCount++] = light;
     }
+    data.Lights = lights.first(lightsCount);
 
     return data;
 }
-
-void RenderData::CollectRenderers(const std::shared_ptr<GameObject> &gameObject)
-{
-    if (!gameObject)
-        return;
-
-    const std::shared_ptr<Renderer>& renderer = gameObject->GetRenderer();
-    if (renderer)
-    {
-        Renderers.push_back(renderer);
-    }
-
-    for (const std::shared_ptr<GameObject>& child : gameObject->Children)
-        CollectRenderers(child);
-}
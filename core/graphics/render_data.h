@@ -6,20 +6,24 @@
 
 #include <vector>
 #include <memory>
+#include <span>
 
 class Renderer;
 class Light;
 class Texture;
 class Cubemap;
-class GameObject;
+class Scene;
 
 struct RenderData
 {
     static RenderData GetRenderData(int viewportWidth, int viewportHeight);
 
-    std::vector<Light*> Lights;
+    // stored in frame memory
+    std::span<Light* const> Lights;
 
-    std::vector<std::shared_ptr<Renderer>> Renderers;
+    // references renderers registered in the scene, scene is kept alive by render data
+    std::span<Renderer* const> Renderers;
+    std::shared_ptr<Scene> CurrentScene;
 
     Vector2 Viewport;
     float FoV;
@@ -35,9 +39,6 @@ struct RenderData
     std::shared_ptr<Texture> CameraDepthTarget;
 
     std::shared_ptr<Texture> PostProcessedTarget;
-
-private:
-    void CollectRenderers(const std::shared_ptr<GameObject> &gameObject);
 };
 
 #endif //RENDER_ENGINE_CONTEXT_H
@@ -0,0 +1,167 @@
+#include "matrices_pool.h"
+#include "graphics_backend_api.h"
+#include "graphics_buffer/graphics_buffer.h"
+#include "graphics_buffer/graphics_buffer_view.h"
+#include "types/graphics_backend_buffer_descriptor.h"
+#include "types/graphics_backend_buffer_view_descriptor.h"
+#include "editor/profiler/profiler.h"
+
+#include <algorithm>
+
+namespace MatricesPoolLocal
+{
+    uint64_t MakeHead(uint32_t slot, uint32_t tag)
+    {
+        return static_cast<uint64_t>(tag) << 32 | slot;
+    }
+
+    uint32_t GetSlot(uint64_t head)
+    {
+        return static_cast<uint32_t>(head);
+    }
+
+    uint32_t GetTag(uint64_t head)
+    {
+        return static_cast<uint32_t>(head >> 32);
+    }
+}
+
+MatricesPool::MatricesPool(uint32_t slotSize) :
+    m_SlotSize(slotSize),
+    m_FreeHead(MatricesPoolLocal::MakeHead(k_NullSlot, 0))
+{
+    AddPage();
+    UpdateBuffer();
+}
+
+MatricesPool::~MatricesPool() = default;
+
+int32_t MatricesPool::Allocate()
+{
+    uint32_t slot;
+    while (!TryPop(slot))
+    {
+        if (!AddPage())
+            return -1;
+    }
+
+    return static_cast<int32_t>(slot);
+}
+
+void MatricesPool::Free(uint32_t slot)
+{
+    Push(slot, slot);
+}
+
+uint32_t MatricesPool::GetCapacity() const
+{
+    return m_PagesCount.load(std::memory_order_acquire) * SlotsPerPage;
+}
+
+uint32_t MatricesPool::GetSlotSize() const
+{
+    return m_SlotSize;
+}
+
+bool MatricesPool::IsBufferOutdated() const
+{
+    return !m_Buffer || m_Buffer->GetSize() < static_cast<uint64_t>(GetCapacity()) * m_SlotSize;
+}
+
+void MatricesPool::UpdateBuffer()
+{
+    if (!IsBufferOutdated())
+        return;
+
+    const uint64_t requiredSize = static_cast<uint64_t>(GetCapacity()) * m_SlotSize;
+
+    Profiler::Marker _("MatricesPool::UpdateBuffer");
+
+    // buffer grows at least twice, so contents are copied only a few times while scene grows
+    const uint64_t size = std::max(requiredSize, m_Buffer ? m_Buffer->GetSize() * 2 : 0);
+
+    GraphicsBackendBufferDescriptor descriptor{};
+    descriptor.Size = static_cast<uint32_t>(size);
+
+    std::shared_ptr<GraphicsBuffer> buffer = std::make_shared<GraphicsBuffer>(descriptor, "MatricesPool/Buffer");
+    if (m_Buffer)
+        GraphicsBackend::Current()->CopyBufferSubData(m_Buffer->GetBackendBuffer(), buffer->GetBackendBuffer(), 0, 0, m_Buffer->GetSize());
+
+    m_Buffer = std::move(buffer);
+
+    const GraphicsBackendBufferViewDescriptor viewDescriptor = GraphicsBackendBufferViewDescriptor::Structured(size / m_SlotSize, m_SlotSize, 0, false);
+    m_BufferView = std::make_shared<GraphicsBufferView>(m_Buffer, viewDescriptor, "MatricesPool/BufferView");
+}
+
+const std::shared_ptr<GraphicsBuffer>& MatricesPool::GetBuffer() const
+{
+    return m_Buffer;
+}
+
+const std::shared_ptr<GraphicsBufferView>& MatricesPool::GetBufferView() const
+{
+    return m_BufferView;
+}
+
+bool MatricesPool::TryPop(uint32_t& outSlot)
+{
+    uint64_t head = m_FreeHead.load(std::memory_order_acquire);
+    while (true)
+    {
+        const uint32_t slot = MatricesPoolLocal::GetSlot(head);
+        if (slot == k_NullSlot)
+            return false;
+
+        // next slot can be outdated if slot was taken by another thread, then tag is changed and exchange fails
+        const uint32_t next = GetNextFreeSlot(slot).load(std::memory_order_relaxed);
+        const uint64_t newHead = MatricesPoolLocal::MakeHead(next, MatricesPoolLocal::GetTag(head) + 1);
+        if (m_FreeHead.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            outSlot = slot;
+            return true;
+        }
+    }
+}
+
+void MatricesPool::Push(uint32_t first, uint32_t last)
+{
+    uint64_t head = m_FreeHead.load(std::memory_order_relaxed);
+    while (true)
+    {
+        GetNextFreeSlot(last).store(MatricesPoolLocal::GetSlot(head), std::memory_order_relaxed);
+
+        const uint64_t newHead = MatricesPoolLocal::MakeHead(first, MatricesPoolLocal::GetTag(head) + 1);
+        if (m_FreeHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+            return;
+    }
+}
+
+std::atomic<uint32_t>& MatricesPool::GetNextFreeSlot(uint32_t slot)
+{
+    return m_NextFreeSlots[slot / SlotsPerPage][slot % SlotsPerPage];
+}
+
+bool MatricesPool::AddPage()
+{
+    std::lock_guard lock(m_AddPageMutex);
+
+    // another thread could add a page while this one was waiting
+    if (MatricesPoolLocal::GetSlot(m_FreeHead.load(std::memory_order_acquire)) != k_NullSlot)
+        return true;
+
+    const uint32_t page = m_PagesCount.load(std::memory_order_relaxed);
+    if (page == MaxPages)
+        return false;
+
+    const uint32_t firstSlot = page * SlotsPerPage;
+    std::unique_ptr<std::atomic<uint32_t>[]>& nextFreeSlots = m_NextFreeSlots[page];
+    nextFreeSlots = std::make_unique<std::atomic<uint32_t>[]>(SlotsPerPage);
+    for (uint32_t i = 0; i < SlotsPerPage - 1; ++i)
+        nextFreeSlots[i].store(firstSlot + i + 1, std::memory_order_relaxed);
+
+    m_PagesCount.store(page + 1, std::memory_order_release);
+
+    // slots of the page are linked in advance, so the whole page is added to the free list at once
+    Push(firstSlot, firstSlot + SlotsPerPage - 1);
+    return true;
+}
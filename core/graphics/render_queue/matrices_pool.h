@@ -0,0 +1,65 @@
+#ifndef RENDER_ENGINE_MATRICES_POOL_H
+#define RENDER_ENGINE_MATRICES_POOL_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+class GraphicsBuffer;
+class GraphicsBufferView;
+
+// Slots for per object data in a single GPU buffer. Slots are added in fixed size pages and keep their index when pool grows,
+// so objects never need to re-upload their data. Allocation and freeing are lock free, only adding a page takes a lock
+class MatricesPool
+{
+public:
+    static constexpr uint32_t SlotsPerPage = 1024;
+    static constexpr uint32_t MaxPages = 1024;
+
+    explicit MatricesPool(uint32_t slotSize);
+    ~MatricesPool();
+
+    MatricesPool(const MatricesPool&) = delete;
+    MatricesPool(MatricesPool&&) = delete;
+
+    MatricesPool& operator=(const MatricesPool&) = delete;
+    MatricesPool& operator=(MatricesPool&&) = delete;
+
+    // returns -1 if pool is full
+    int32_t Allocate();
+    void Free(uint32_t slot);
+
+    uint32_t GetCapacity() const;
+    uint32_t GetSlotSize() const;
+
+    bool IsBufferOutdated() const;
+
+    // must be called on the main thread inside a copy pass, grows buffer to fit all pages and copies previous contents
+    void UpdateBuffer();
+
+    const std::shared_ptr<GraphicsBuffer>& GetBuffer() const;
+    const std::shared_ptr<GraphicsBufferView>& GetBufferView() const;
+
+private:
+    static constexpr uint32_t k_NullSlot = ~0U;
+
+    const uint32_t m_SlotSize;
+
+    // free slots form a linked list, head keeps change counter in the high bits to avoid ABA problem
+    std::atomic<uint64_t> m_FreeHead;
+    std::array<std::unique_ptr<std::atomic<uint32_t>[]>, MaxPages> m_NextFreeSlots;
+    std::atomic<uint32_t> m_PagesCount = 0;
+    std::mutex m_AddPageMutex;
+
+    std::shared_ptr<GraphicsBuffer> m_Buffer;
+    std::shared_ptr<GraphicsBufferView> m_BufferView;
+
+    bool TryPop(uint32_t& outSlot);
+    void Push(uint32_t first, uint32_t last);
+    std::atomic<uint32_t>& GetNextFreeSlot(uint32_t slot);
+    bool AddPage();
+};
+
+#endif //RENDER_ENGINE_MATRICES_POOL_H
@@ -1,5 +1,6 @@
 #include "render_queue.h"
 #include "renderer/renderer.h"
+#include "scene/scene.h"
 #include "material/material.h"
 #include "shader/shader.h"
 #include "hash.h"
@@ -7,29 +8,42 @@
 #include "graphics_backend_api.h"
 #include "graphics_buffer/ring_buffer.h"
 #include "texture/texture.h"
+#include "texture_streamer/texture_streamer.h"
 #include "drawable_geometry/drawable_geometry.h"
 #include "global_constants.h"
 #include "developer_console/developer_console.h"
 #include "graphics_buffer/graphics_buffer_view.h"
 #include "editor/profiler/profiler.h"
+#include "graphics/graphics.h"
+#include "worker/worker.h"
 #include "debug.h"
+#include "memory/frame_allocator.h"
+#include "math_utils.h"
+#include "graphics/data_structs/per_draw_data.h"
+#include "matrices_pool.h"
+#include "enums/fence_type.h"
+#include "enums/gpu_queue.h"
+#include "types/graphics_backend_buffer_descriptor.h"
+
+#include <algorithm>
+#include <iterator>
+#include <bit>
+#include <cstring>
+#include <limits>
 
 bool RenderQueue::EnableFrustumCulling = true;
 bool RenderQueue::FreezeFrustumCulling = false;
 
 std::mutex RenderQueue::s_PermanentMatricesUpdatesMutex;
-std::shared_mutex RenderQueue::s_PermanentMatricesBufferRecreateMutex;
-std::vector<std::pair<Matrix4x4, uint32_t>> RenderQueue::s_PermanentMatricesUpdates;
-std::shared_ptr<GraphicsBuffer> RenderQueue::s_PermanentMatricesBuffer;
-std::shared_ptr<GraphicsBufferView> RenderQueue::s_PermanentMatricesBufferView;
-
-std::deque<uint32_t> RenderQueue::s_FreeMatricesBufferEntries;
-std::mutex RenderQueue::s_FreeMatricesBufferEntriesMutex;
-uint32_t RenderQueue::s_MatricesBufferCapacity = 1024;
+std::vector<RenderQueue::MatricesUpdate> RenderQueue::s_PermanentMatricesUpdates;
+std::unique_ptr<MatricesPool> RenderQueue::s_MatricesPool;
+std::shared_ptr<RingBuffer> RenderQueue::s_MatricesStagingBuffer;
+GraphicsBackendFence RenderQueue::s_MatricesUploadFence;
 
 namespace RenderQueueLocal
 {
     constexpr uint32_t k_MatricesBufferElementSize = 2 * sizeof(Matrix4x4);
+    constexpr size_t k_RenderersPerSetupChunk = 1024;
 
     std::size_t GetDrawCallInstancingHash(const DrawCallInfo &drawCallInfo)
     {
@@ -42,20 +56,14 @@ namespace RenderQueueLocal
     {
         Profiler::Marker _("RenderQueue::SortDrawCalls");
 
-        const Matrix4x4 invViewProjection = viewProjectionMatrix.Invert();
-        const Vector4 cameraDirection = invViewProjection * Vector4(0, 0, 1, 0);
-
+        Vector3 cameraDirection;
         if (sortMode != DrawCallSortMode::NO_SORTING)
-            std::sort(outDrawCalls.begin(), outDrawCalls.end(), DrawCallComparer {sortMode, cameraDirection});
-    }
-
-    int GetEntryFromBufferView(const std::shared_ptr<GraphicsBufferView>& view)
-    {
-        if (!view || !view->GetBuffer())
-            return -1;
+        {
+            const Matrix4x4 invViewProjection = viewProjectionMatrix.Invert();
+            cameraDirection = invViewProjection * Vector4(0, 0, 1, 0);
+        }
 
-        const GraphicsBackendBufferViewDescriptor& viewDescriptor = view->GetDescriptor();
-        return viewDescriptor.Offset / k_MatricesBufferElementSize;
+        DrawCallSort::Sort(sortMode, cameraDirection, outDrawCalls);
     }
 }
 
@@ -67,22 +75,77 @@ RenderQueue::RenderQueue() :
     DeveloperConsole::AddBoolCommand(L"FrustumCulling.Enabled", &EnableFrustumCulling);
     DeveloperConsole::AddBoolCommand(L"FrustumCulling.Freeze", &FreezeFrustumCulling);
 
-    if (!s_PermanentMatricesBuffer)
-	    CreatePermanentMatricesBuffer();
+    if (!s_MatricesPool)
+    {
+        s_MatricesPool = std::make_unique<MatricesPool>(RenderQueueLocal::k_MatricesBufferElementSize);
+
+        GraphicsBackendBufferDescriptor descriptor{};
+        descriptor.AllowCPUWrites = true;
+        descriptor.Size = RenderQueueLocal::k_MatricesBufferElementSize * MatricesPool::SlotsPerPage;
+        s_MatricesStagingBuffer = std::make_shared<RingBuffer>(descriptor, "RenderQueue/MatricesStagingBuffer");
+
+        s_MatricesUploadFence = GraphicsBackend::Current()->CreateFence(FenceType::COPY_TO_RENDER, "After Matrices Upload");
+    }
 }
 
 void RenderQueue::Prepare(const Matrix4x4& viewProjectionMatrix, const std::vector<std::shared_ptr<Renderer>>& renderers, const RenderSettings& renderSettings)
+{
+    RenderQueue* queue = this;
+    Prepare(std::span<RenderQueue* const>(&queue, 1), std::span<const Matrix4x4>(&viewProjectionMatrix, 1), renderers, renderSettings);
+}
+
+void RenderQueue::Prepare(std::span<RenderQueue* const> queues, std::span<const Matrix4x4> viewProjectionMatrices, const std::vector<std::shared_ptr<Renderer>>& renderers, const RenderSettings& renderSettings)
 {
     Profiler::Marker _("RenderQueue::Prepare");
 
-    Clear();
+    if (queues.empty())
+        return;
 
-    if (!FreezeFrustumCulling)
-        m_Frustum = Frustum(viewProjectionMatrix);
+    BeginPrepare(queues, viewProjectionMatrices);
 
-    SetupDrawCalls(renderers, renderSettings, m_Frustum);
-	BatchDrawCalls();
-    RenderQueueLocal::SortDrawCalls(renderSettings.Sorting, viewProjectionMatrix, m_DrawCalls);
+    std::vector<Renderer*>& sourceRenderers = queues[0]->m_SourceRenderers;
+    sourceRenderers.clear();
+    sourceRenderers.reserve(renderers.size());
+    for (const std::shared_ptr<Renderer>& renderer : renderers)
+        sourceRenderers.push_back(renderer.get());
+
+    SetupDrawCalls(queues, RenderersSource{sourceRenderers, {}}, renderSettings);
+    EndPrepare(queues, viewProjectionMatrices, renderSettings);
+}
+
+void RenderQueue::Prepare(const Matrix4x4& viewProjectionMatrix, const std::shared_ptr<Scene>& scene, const RenderSettings& renderSettings)
+{
+    RenderQueue* queue = this;
+    Prepare(std::span<RenderQueue* const>(&queue, 1), std::span<const Matrix4x4>(&viewProjectionMatrix, 1), scene, renderSettings);
+}
+
+void RenderQueue::Prepare(std::span<RenderQueue* const> queues, std::span<const Matrix4x4> viewProjectionMatrices, const std::shared_ptr<Scene>& scene, const RenderSettings& renderSettings)
+{
+    Profiler::Marker _("RenderQueue::Prepare");
+
+    if (queues.empty())
+        return;
+
+    BeginPrepare(queues, viewProjectionMatrices);
+
+    std::vector<BoundsTree<Renderer>::QueryResult>& culledRenderers = queues[0]->m_CulledRenderers;
+    culledRenderers.clear();
+
+    // tree query supports limited number of frustums, otherwise all registered renderers are culled in chunks using cached scene bounds
+    if (!scene)
+        SetupDrawCalls(queues, RenderersSource{}, renderSettings);
+    else if (EnableFrustumCulling && queues.size() <= BoundsTree<Renderer>::MaxQueryFrustums)
+    {
+        {
+            Profiler::Marker queryMarker("RenderQueue::QueryRenderers");
+            scene->QueryRenderers(queues[0]->m_SetupFrustums, renderSettings.FrustumCullingPlanesBits, culledRenderers);
+        }
+
+        SetupDrawCalls(queues, RenderersSource{{}, culledRenderers}, renderSettings);
+    }
+    else
+        SetupDrawCalls(queues, RenderersSource{scene->GetRenderers(), {}, &scene->GetRenderersBounds()}, renderSettings);
+    EndPrepare(queues, viewProjectionMatrices, renderSettings);
 }
 
 void RenderQueue::Prepare(const Matrix4x4& viewProjectionMatrix, const std::vector<Item>& items, const RenderSettings& renderSettings)
@@ -95,8 +158,12 @@ void RenderQueue::Prepare(const Matrix4x4& viewProjectionMatrix, const std::vect
         m_Frustum = Frustum(viewProjectionMatrix);
 
     SetupDrawCalls(items, renderSettings, m_Frustum);
+    if (!renderSettings.OverrideMaterial)
+        RequestTextureMips(viewProjectionMatrix);
     BatchDrawCalls();
     RenderQueueLocal::SortDrawCalls(renderSettings.Sorting, viewProjectionMatrix, m_DrawCalls);
+    SetupPerDrawData();
+    RecordCommands();
 }
 
 void RenderQueue::Clear()
@@ -109,9 +176,11 @@ void RenderQueue::Clear()
     m_PreviousPrimitiveType = PrimitiveType::LINES;
 
     m_InstancedMatricesEntries.clear();
-    m_InstancedMatricesEntriesCounts.clear();
+    m_PerDrawData.clear();
 
     m_TemporaryMatrices.clear();
+
+    m_CommandList.Clear();
 }
 
 bool RenderQueue::IsEmpty() const
@@ -132,59 +201,194 @@ void RenderQueue::Draw()
     if (!m_TemporaryMatrices.empty())
         m_TemporaryMatricesBuffer->SetData(m_TemporaryMatrices.data(), 0, m_TemporaryMatrices.size() * sizeof(Matrix4x4));
 
-    if (!s_PermanentMatricesUpdates.empty())
+    if (!m_PerDrawData.empty())
+        m_PerDrawDataBuffer->SetData(m_PerDrawData.data(), 0, m_PerDrawData.size());
+
+    if (m_CommandList.IsEmpty())
+        return;
+
+    // matrices pool view can be recreated when matrices are uploaded, so it is bound on submit instead of being recorded
+    const bool useTemporaryMatrices = !m_TemporaryMatrices.empty();
+    GraphicsBackend::Current()->BindBuffer(useTemporaryMatrices ? m_TemporaryMatricesBufferView->GetBackendBufferView() : s_MatricesPool->GetBufferView()->GetBackendBufferView(), GlobalConstants::TransformMatricesData);
+
+    m_CommandList.Execute();
+}
+
+bool RenderQueue::RenderersSource::IsCulled() const
+{
+    return !CulledRenderers.empty();
+}
+
+size_t RenderQueue::RenderersSource::Size() const
+{
+    return IsCulled() ? CulledRenderers.size() : Renderers.size();
+}
+
+void RenderQueue::BeginPrepare(std::span<RenderQueue* const> queues, std::span<const Matrix4x4> viewProjectionMatrices)
+{
+    std::vector<Frustum>& frustums = queues[0]->m_SetupFrustums;
+    frustums.clear();
+
+    for (size_t i = 0; i < queues.size(); ++i)
+    {
+        queues[i]->Clear();
+
+        if (!FreezeFrustumCulling)
+            queues[i]->m_Frustum = Frustum(viewProjectionMatrices[i]);
+
+        frustums.push_back(queues[i]->m_Frustum);
+    }
+}
+
+void RenderQueue::EndPrepare(std::span<RenderQueue* const> queues, std::span<const Matrix4x4> viewProjectionMatrices, const RenderSettings& settings)
+{
+    auto ProcessQueue = [&queues, &viewProjectionMatrices, &settings](size_t queueIndex)
+    {
+        RenderQueue* queue = queues[queueIndex];
+        if (!settings.OverrideMaterial)
+            queue->RequestTextureMips(viewProjectionMatrices[queueIndex]);
+        queue->BatchDrawCalls();
+        RenderQueueLocal::SortDrawCalls(settings.Sorting, viewProjectionMatrices[queueIndex], queue->m_DrawCalls);
+        queue->SetupPerDrawData();
+        queue->RecordCommands();
+    };
+
+    // queues don't share any data after draw calls are set up, so their command lists are recorded in parallel
+    if (queues.size() > 1 && !Graphics::IsPrepareSynchronous())
     {
-        for (const std::pair<Matrix4x4, uint32_t>& pair : s_PermanentMatricesUpdates)
+        std::shared_ptr<Worker::Task> queuesTask = std::make_shared<Worker::Task>();
+        for (size_t i = 1; i < queues.size(); ++i)
         {
-            Matrix4x4 matrices[2];
-            matrices[0] = pair.first;
-            matrices[1] = pair.first.Invert().Transpose();
-            s_PermanentMatricesBuffer->SetData(&matrices[0], pair.second * sizeof(matrices), sizeof(matrices));
+            std::shared_ptr<Worker::Task> task = Worker::CreateTask([&ProcessQueue, i] { ProcessQueue(i); }, Worker::Priority::TASK);
+            queuesTask->AddDependency(task);
+            task->Schedule();
         }
-        s_PermanentMatricesUpdates.clear();
+        queuesTask->Schedule();
+
+        ProcessQueue(0);
+        queuesTask->Wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < queues.size(); ++i)
+            ProcessQueue(i);
     }
+}
 
-    for (const DrawCallInfo& drawCall : m_DrawCalls)
+void RenderQueue::SetupDrawCalls(std::span<RenderQueue* const> queues, const RenderersSource& renderers, const RenderSettings& settings)
+{
+    Profiler::Marker _("RenderQueue::SetupDrawCalls");
+
+    // shared chunk data is stored in the first queue, draw calls - in each queue separately
+    std::vector<SetupChunk>& chunks = queues[0]->m_SetupChunks;
+
+    const size_t chunksCount = (renderers.Size() + RenderQueueLocal::k_RenderersPerSetupChunk - 1) / RenderQueueLocal::k_RenderersPerSetupChunk;
+    if (chunks.size() < chunksCount)
+        chunks.resize(chunksCount);
+
+    for (RenderQueue* queue : queues)
     {
-        const GraphicsBackendGeometry& geom = drawCall.Geometry->GetGraphicsBackendGeometry();
-        const PrimitiveType primitiveType = drawCall.Geometry->GetPrimitiveType();
-        const IndicesDataType indicesDataType = drawCall.Geometry->GetIndicesDataType();
-        const int elementsCount = drawCall.Geometry->GetElementsCount();
-        const bool hasIndices = drawCall.Geometry->HasIndexes();
+        if (queue->m_ChunksDrawCalls.size() < chunksCount)
+            queue->m_ChunksDrawCalls.resize(chunksCount);
+    }
 
-        SetupMatrices(drawCall);
-        SetupShaderPass(drawCall.Material, drawCall.Geometry->GetVertexAttributes(), primitiveType, drawCall.StencilValue);
+    auto ProcessChunk = [&queues, &renderers, &settings, &chunks](size_t chunkIndex)
+    {
+        SetupDrawCallsChunk(queues, renderers, chunkIndex, settings, chunks[chunkIndex]);
+    };
 
-        if (drawCall.Instanced)
+    if (chunksCount > 1 && !Graphics::IsPrepareSynchronous())
+    {
+        std::shared_ptr<Worker::Task> chunksTask = std::make_shared<Worker::Task>();
+        for (size_t i = 1; i < chunksCount; ++i)
         {
-            const int instanceCount = drawCall.MatricesBufferViews.size();
-            if (hasIndices)
-                GraphicsBackend::Current()->DrawElementsInstanced(geom, primitiveType, elementsCount, indicesDataType, instanceCount);
-            else
-                GraphicsBackend::Current()->DrawArraysInstanced(geom, primitiveType, 0, elementsCount, instanceCount);
+            std::shared_ptr<Worker::Task> task = Worker::CreateTask([&ProcessChunk, i] { ProcessChunk(i); }, Worker::Priority::TASK);
+            chunksTask->AddDependency(task);
+            task->Schedule();
         }
-        else
+        chunksTask->Schedule();
+
+        ProcessChunk(0);
+        chunksTask->Wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < chunksCount; ++i)
+            ProcessChunk(i);
+    }
+
+    {
+        Profiler::Marker mergeMarker("RenderQueue::MergeDrawCalls");
+
+        for (RenderQueue* queue : queues)
         {
-            if (hasIndices)
-                GraphicsBackend::Current()->DrawElements(geom, primitiveType, elementsCount, indicesDataType);
-            else
-                GraphicsBackend::Current()->DrawArrays(geom, primitiveType, 0, elementsCount);
+            size_t drawCallsCount = 0;
+            for (size_t i = 0; i < chunksCount; ++i)
+                drawCallsCount += queue->m_ChunksDrawCalls[i].size();
+
+            queue->m_DrawCalls.reserve(drawCallsCount);
+            for (size_t i = 0; i < chunksCount; ++i)
+            {
+                std::vector<DrawCallInfo>& chunkDrawCalls = queue->m_ChunksDrawCalls[i];
+                std::move(chunkDrawCalls.begin(), chunkDrawCalls.end(), std::back_inserter(queue->m_DrawCalls));
+                chunkDrawCalls.clear();
+            }
+        }
+
+        size_t matricesUpdatesCount = 0;
+        for (size_t i = 0; i < chunksCount; ++i)
+            matricesUpdatesCount += chunks[i].MatricesUpdates.size();
+
+        if (matricesUpdatesCount > 0)
+        {
+            std::lock_guard<std::mutex> updatesLock(s_PermanentMatricesUpdatesMutex);
+            s_PermanentMatricesUpdates.reserve(s_PermanentMatricesUpdates.size() + matricesUpdatesCount);
+            for (size_t i = 0; i < chunksCount; ++i)
+            {
+                std::vector<MatricesUpdate>& chunkUpdates = chunks[i].MatricesUpdates;
+                s_PermanentMatricesUpdates.insert(s_PermanentMatricesUpdates.end(), chunkUpdates.begin(), chunkUpdates.end());
+                chunkUpdates.clear();
+            }
         }
     }
 }
 
-void RenderQueue::SetupDrawCalls(const std::vector<std::shared_ptr<Renderer>>& renderers, const RenderSettings& settings, const Frustum& frustum)
+void RenderQueue::SetupDrawCallsChunk(std::span<RenderQueue* const> queues, const RenderersSource& renderers, size_t chunkIndex, const RenderSettings& settings, SetupChunk& chunk)
 {
-    Profiler::Marker _("RenderQueue::SetupDrawCalls");
+    Profiler::Marker _("RenderQueue::SetupDrawCallsChunk");
 
-    m_DrawCalls.reserve(renderers.size());
+    const size_t begin = chunkIndex * RenderQueueLocal::k_RenderersPerSetupChunk;
+    const size_t end = std::min(begin + RenderQueueLocal::k_RenderersPerSetupChunk, renderers.Size());
+    const bool isCulled = renderers.IsCulled();
 
-    CheckMatricesBufferSize();
+    // cached bounds are culled before renderers are touched, so invisible renderers are skipped without reading their data
+    const bool isBoundsCulled = !isCulled && renderers.Bounds && EnableFrustumCulling && queues.size() <= 32;
+    const bool hasFrustumsMasks = isCulled || isBoundsCulled;
 
-    std::shared_lock lock(s_PermanentMatricesBufferRecreateMutex);
+    chunk.Candidates.clear();
+    chunk.CandidatesFrustumsMasks.clear();
+    chunk.CandidatesBounds.Clear();
 
-    for (const std::shared_ptr<Renderer>& renderer : renderers)
+    if (isBoundsCulled)
+    {
+        chunk.SourceVisibilityMasks.resize(queues.size());
+        Frustum::GetVisibilityMasks(queues[0]->m_SetupFrustums, *renderers.Bounds, begin, end - begin, chunk.SourceVisibilityMasks, settings.FrustumCullingPlanesBits);
+    }
+
+    for (size_t i = begin; i < end; ++i)
     {
+        uint32_t frustumsMask = isCulled ? renderers.CulledRenderers[i].FrustumsMask : 0;
+        if (isBoundsCulled)
+        {
+            const size_t index = i - begin;
+            for (size_t j = 0; j < queues.size(); ++j)
+                frustumsMask |= static_cast<uint32_t>((chunk.SourceVisibilityMasks[j][index / 64] >> (index % 64)) & 1) << j;
+
+            if (frustumsMask == 0)
+                continue;
+        }
+
+        Renderer* renderer = isCulled ? renderers.CulledRenderers[i].Item : renderers.Renderers[i];
         if (!renderer)
             continue;
 
@@ -204,43 +408,89 @@ void RenderQueue::SetupDrawCalls(const std::vector<std::shared_ptr<Renderer>>& r
         if (!settings.Filter(info))
             continue;
 
-        if (EnableFrustumCulling && !frustum.IsVisible(renderer->GetAABB(), settings.FrustumCullingPlanesBits))
-            continue;
+        if (hasFrustumsMasks)
+            chunk.CandidatesFrustumsMasks.push_back(frustumsMask);
+        else
+            chunk.CandidatesBounds.Add(info.AABB);
+
+        chunk.Candidates.emplace_back(renderer, std::move(info));
+    }
+
+    const size_t candidatesCount = chunk.Candidates.size();
+    const size_t wordsCount = (candidatesCount + 63) / 64;
+
+    chunk.VisibilityMasks.resize(queues.size());
+    if (hasFrustumsMasks)
+    {
+        for (std::vector<uint64_t>& mask : chunk.VisibilityMasks)
+            mask.assign(wordsCount, 0);
+
+        for (size_t i = 0; i < candidatesCount; ++i)
+        {
+            for (size_t j = 0; j < queues.size(); ++j)
+            {
+                if ((chunk.CandidatesFrustumsMasks[i] >> j) & 1)
+                    chunk.VisibilityMasks[j][i / 64] |= 1ULL << (i % 64);
+            }
+        }
+    }
+    else if (EnableFrustumCulling)
+        Frustum::GetVisibilityMasks(queues[0]->m_SetupFrustums, chunk.CandidatesBounds, chunk.VisibilityMasks, settings.FrustumCullingPlanesBits);
+    else
+    {
+        for (std::vector<uint64_t>& mask : chunk.VisibilityMasks)
+            mask.assign(wordsCount, ~0ULL);
+    }
 
-        std::shared_ptr<GraphicsBufferView> matricesBufferView = nullptr;
+    for (size_t word = 0; word < wordsCount; ++word)
+    {
+        // renderer matrices are set up once, even if it is visible in several queues
+        uint64_t visibleBits = 0;
+        for (const std::vector<uint64_t>& mask : chunk.VisibilityMasks)
+            visibleBits |= mask[word];
+
+        while (visibleBits != 0)
         {
-            std::unique_lock rendererLock(renderer->GetMatricesBufferViewMutex());
+            const int bit = std::countr_zero(visibleBits);
+            visibleBits &= visibleBits - 1;
+
+            const size_t candidateIndex = word * 64 + bit;
+            if (candidateIndex >= candidatesCount)
+                break;
+
+            Renderer* renderer = chunk.Candidates[candidateIndex].first;
+            DrawCallInfo& info = chunk.Candidates[candidateIndex].second;
 
-            bool matricesBufferViewChanged = false;
-            matricesBufferView = renderer->GetMatricesBufferView();
-            if (!matricesBufferView || !matricesBufferView->GetBuffer())
+            int32_t matricesEntry;
             {
-            	const int matricesBufferEntry = GetMatricesEntry();
-                if (matricesBufferEntry >= 0)
+                std::unique_lock rendererLock(renderer->GetMatricesEntryMutex());
+
+                bool matricesEntryChanged = false;
+                matricesEntry = renderer->GetMatricesEntry();
+                if (matricesEntry < 0)
                 {
-                    const GraphicsBackendBufferViewDescriptor viewDescriptor = GraphicsBackendBufferViewDescriptor::Structured(1, RenderQueueLocal::k_MatricesBufferElementSize, matricesBufferEntry * RenderQueueLocal::k_MatricesBufferElementSize, false);
-                    matricesBufferView = std::make_shared<GraphicsBufferView>(s_PermanentMatricesBuffer, viewDescriptor, "RenderQueue/PermanentMatricesBufferSingleView");
-                    matricesBufferViewChanged = true;
+                    matricesEntry = s_MatricesPool->Allocate();
+                    matricesEntryChanged = matricesEntry >= 0;
+                    renderer->SetMatricesEntry(matricesEntry);
                 }
-                else
-                    matricesBufferView = nullptr;
 
-                renderer->SetMatricesBufferView(matricesBufferView);
+                if (matricesEntry >= 0 && (renderer->IsTransformDirty() || matricesEntryChanged))
+                {
+                    chunk.MatricesUpdates.push_back({renderer->GetModelMatrix(), renderer->GetNormalMatrix(), static_cast<uint32_t>(matricesEntry)});
+                    renderer->SetTransformDirty(false);
+                }
             }
 
-            if (matricesBufferView && (renderer->IsTransformDirty() || matricesBufferViewChanged))
+            if (matricesEntry < 0)
+                continue;
+
+            info.MatricesEntry = static_cast<uint32_t>(matricesEntry);
+            for (size_t i = 0; i < queues.size(); ++i)
             {
-                std::lock_guard<std::mutex> updatesLock(s_PermanentMatricesUpdatesMutex);
-                s_PermanentMatricesUpdates.emplace_back(renderer->GetModelMatrix(), RenderQueueLocal::GetEntryFromBufferView(matricesBufferView));
-                renderer->SetTransformDirty(false);
+                if ((chunk.VisibilityMasks[i][word] >> bit) & 1)
+                    queues[i]->m_ChunksDrawCalls[chunkIndex].push_back(info);
             }
         }
-
-        if (matricesBufferView)
-        {
-            info.MatricesBufferViews.push_back(matricesBufferView);
-            m_DrawCalls.push_back(info);
-        }
     }
 }
 
@@ -288,93 +538,213 @@ void RenderQueue::SetupDrawCalls(const std::vector<Item>& items, const RenderSet
         m_TemporaryMatrices.push_back(item.Matrix);
         m_TemporaryMatrices.push_back(item.Matrix.Invert().Transpose());
 
-        const GraphicsBackendBufferViewDescriptor viewDescriptor = GraphicsBackendBufferViewDescriptor::Structured(1, RenderQueueLocal::k_MatricesBufferElementSize, offset++ * RenderQueueLocal::k_MatricesBufferElementSize, false);
-        std::shared_ptr<GraphicsBufferView> view = std::make_shared<GraphicsBufferView>(m_TemporaryMatricesBuffer, viewDescriptor, "RenderQueue/TemporaryMatricesSingleView");
+        info.MatricesEntry = offset++;
 
-        info.MatricesBufferViews.push_back(view);
         m_DrawCalls.push_back(info);
     }
 }
 
+void RenderQueue::RequestTextureMips(const Matrix4x4& viewProjectionMatrix) const
+{
+    Profiler::Marker _("RenderQueue::RequestTextureMips");
+
+    // projected height of bounding sphere in pixels is radius * scale * screen height / w, where scale is the length of clip space y row
+    const Vector3 clipYRow(viewProjectionMatrix.m01, viewProjectionMatrix.m11, viewProjectionMatrix.m21);
+    const float pixelsScale = clipYRow.Length() * static_cast<float>(Graphics::GetScreenHeight());
+
+    auto RequestMaterialTextures = [](const Material* material, float screenSize)
+    {
+        for (const auto& pair : material->GetTextures())
+        {
+            if (pair.second)
+                TextureStreamer::RequestScreenSize(*pair.second, screenSize);
+        }
+    };
+
+    // draw calls are not sorted yet, so draw calls of the same material are usually adjacent and textures are requested once for them
+    const Material* material = nullptr;
+    float materialScreenSize = 0;
+    for (const DrawCallInfo& drawCall : m_DrawCalls)
+    {
+        if (drawCall.Material != material)
+        {
+            if (material)
+                RequestMaterialTextures(material, materialScreenSize);
+
+            material = drawCall.Material;
+            materialScreenSize = 0;
+        }
+
+        const Vector3 center = drawCall.AABB.GetCenter();
+        const float radius = drawCall.AABB.GetExtents().Length();
+        const float w = viewProjectionMatrix.m03 * center.x + viewProjectionMatrix.m13 * center.y + viewProjectionMatrix.m23 * center.z + viewProjectionMatrix.m33;
+
+        // camera is inside of the bounding sphere, so the most detailed mip is required
+        const float screenSize = w > radius ? pixelsScale * radius / w : std::numeric_limits<float>::max();
+        materialScreenSize = std::max(materialScreenSize, screenSize);
+    }
+
+    if (material)
+        RequestMaterialTextures(material, materialScreenSize);
+}
+
 void RenderQueue::BatchDrawCalls()
 {
     Profiler::Marker _("RenderQueue::BatchDrawCalls");
 
-    std::unordered_map<std::size_t, DrawCallInfo*> instancingMap;
+    constexpr uint32_t notInstanced = ~0U;
 
-    for (size_t i = 0; i < m_DrawCalls.size(); ++i)
-    {
-        DrawCallInfo& drawCall = m_DrawCalls[i];
-        if (!drawCall.Material->GetShader()->SupportInstancing())
-            continue;
+    const size_t drawCallsCount = m_DrawCalls.size();
+    std::span<uint32_t> batchIndices = FrameAllocator::AllocateArray<uint32_t>(drawCallsCount);
 
-        const size_t hash = RenderQueueLocal::GetDrawCallInstancingHash(drawCall);
-        const auto it = instancingMap.find(hash);
+    // each instanced batch is represented by its first draw call, other draw calls of the batch are merged into it
+    {
+        FrameUnorderedMap<std::size_t, uint32_t> instancingMap;
+        instancingMap.reserve(drawCallsCount);
 
-        if (it == instancingMap.end())
+        for (size_t i = 0; i < drawCallsCount; ++i)
         {
-            drawCall.Instanced = true;
-            instancingMap[hash] = &drawCall;
-            continue;
-        }
+            DrawCallInfo& drawCall = m_DrawCalls[i];
+            batchIndices[i] = notInstanced;
+            if (!drawCall.Material->GetShader()->SupportInstancing())
+                continue;
 
-        DrawCallInfo* instancedDrawCall = it->second;
-        instancedDrawCall->MatricesBufferViews.push_back(drawCall.MatricesBufferViews[0]);
-        instancedDrawCall->AABB = instancedDrawCall->AABB.Combine(drawCall.AABB);
+            const auto [it, inserted] = instancingMap.try_emplace(RenderQueueLocal::GetDrawCallInstancingHash(drawCall), static_cast<uint32_t>(i));
+            batchIndices[i] = it->second;
+
+            if (inserted)
+            {
+                drawCall.Instanced = true;
+                drawCall.InstancesCount = 1;
+                continue;
+            }
 
-        m_DrawCalls[i] = m_DrawCalls[m_DrawCalls.size() - 1];
-        m_DrawCalls.pop_back();
-        --i;
+            DrawCallInfo& batchDrawCall = m_DrawCalls[it->second];
+            batchDrawCall.AABB = batchDrawCall.AABB.Combine(drawCall.AABB);
+            ++batchDrawCall.InstancesCount;
+        }
     }
 
+    // instances of each batch are placed in a contiguous range of entries, counts are rebuilt while entries are written
     uint32_t totalInstancesCount = 0;
-    for (const DrawCallInfo& info : m_DrawCalls)
+    for (DrawCallInfo& info : m_DrawCalls)
     {
-        if (info.Instanced)
-            totalInstancesCount += info.MatricesBufferViews.size();
+        if (!info.Instanced)
+            continue;
+
+        info.InstancesOffset = totalInstancesCount;
+        totalInstancesCount += info.InstancesCount;
+        info.InstancesCount = 0;
+    }
+
+    m_InstancedMatricesEntries.resize(totalInstancesCount);
+
+    for (size_t i = 0; i < drawCallsCount; ++i)
+    {
+        if (batchIndices[i] == notInstanced)
+            continue;
+
+        DrawCallInfo& batchDrawCall = m_DrawCalls[batchIndices[i]];
+        m_InstancedMatricesEntries[batchDrawCall.InstancesOffset + batchDrawCall.InstancesCount++] = m_DrawCalls[i].MatricesEntry;
+    }
+
+    // merged draw calls are removed preserving order of the rest
+    size_t keptCount = 0;
+    for (size_t i = 0; i < drawCallsCount; ++i)
+    {
+        if (batchIndices[i] != notInstanced && batchIndices[i] != i)
+            continue;
+
+        if (keptCount != i)
+            m_DrawCalls[keptCount] = std::move(m_DrawCalls[i]);
+        ++keptCount;
     }
+    m_DrawCalls.resize(keptCount);
 
     const uint32_t requiredBufferSize = totalInstancesCount * sizeof(uint32_t);
-    if (!m_InstancedMatricesEntriesBuffer || m_InstancedMatricesEntriesBuffer->GetSize() < requiredBufferSize)
+    if (requiredBufferSize > 0 && (!m_InstancedMatricesEntriesBuffer || m_InstancedMatricesEntriesBuffer->GetSize() < requiredBufferSize))
     {
         GraphicsBackendBufferDescriptor descriptor{};
         descriptor.AllowCPUWrites = true;
         descriptor.Size = requiredBufferSize;
 
         m_InstancedMatricesEntriesBuffer = std::make_shared<GraphicsBuffer>(descriptor, "RenderQueue/InstancedMatricesEntries");
+
+        // instanced draws address their range of entries by offset, so one view covers whole buffer
+        const GraphicsBackendBufferViewDescriptor viewDescriptor = GraphicsBackendBufferViewDescriptor::Typed(TextureInternalFormat::R32F, totalInstancesCount, 0, false);
+        m_InstancedMatricesEntriesView = std::make_shared<GraphicsBufferView>(m_InstancedMatricesEntriesBuffer, viewDescriptor, "RenderQueue/InstancedMatricesEntriesView");
     }
+}
 
-    uint32_t instancesEntriesOffset = 0;
-    for (DrawCallInfo& info : m_DrawCalls)
+void RenderQueue::SetupPerDrawData()
+{
+    Profiler::Marker _("RenderQueue::SetupPerDrawData");
+
+    // constant buffer offsets must be aligned, so each draw call data takes a separate aligned block
+    m_PerDrawDataStride = Math::Align(static_cast<int>(sizeof(PerDrawData)), GraphicsBackend::Current()->GetConstantBufferOffsetAlignment());
+    m_PerDrawData.assign(m_DrawCalls.size() * m_PerDrawDataStride, 0);
+
+    for (size_t i = 0; i < m_DrawCalls.size(); ++i)
     {
-        if (!info.Instanced)
-            continue;
+        const DrawCallInfo& drawCall = m_DrawCalls[i];
 
-        const uint32_t instancesCount = info.MatricesBufferViews.size();
+        PerDrawData data{};
+        data.MatricesEntry = drawCall.Instanced ? drawCall.InstancesOffset : drawCall.MatricesEntry;
+        memcpy(m_PerDrawData.data() + i * m_PerDrawDataStride, &data, sizeof(data));
+    }
 
-        m_InstancedMatricesEntries.reserve(instancesCount);
-        m_InstancedMatricesEntriesCounts.push_back(instancesCount);
-        for (const std::shared_ptr<GraphicsBufferView>& view : info.MatricesBufferViews)
-            m_InstancedMatricesEntries.push_back(RenderQueueLocal::GetEntryFromBufferView(view));
-        
-        const GraphicsBackendBufferViewDescriptor descriptor = GraphicsBackendBufferViewDescriptor::Typed(TextureInternalFormat::R32F, instancesCount, instancesEntriesOffset * sizeof(uint32_t), false);
-        info.InstancedMatricesEntriesView = std::make_shared<GraphicsBufferView>(m_InstancedMatricesEntriesBuffer, descriptor, "RenderQueue/InstancedMatricesEntriesView");
+    const uint64_t requiredBufferSize = m_PerDrawData.size();
+    if (requiredBufferSize > 0 && (!m_PerDrawDataBuffer || m_PerDrawDataBuffer->GetSize() < requiredBufferSize))
+    {
+        GraphicsBackendBufferDescriptor descriptor{};
+        descriptor.AllowCPUWrites = true;
+        descriptor.Size = requiredBufferSize;
 
-        instancesEntriesOffset += instancesCount;
+        m_PerDrawDataBuffer = std::make_shared<GraphicsBuffer>(descriptor, "RenderQueue/PerDrawData");
     }
 }
 
-void RenderQueue::SetupMatrices(const DrawCallInfo& drawCallInfo) const
+void RenderQueue::RecordCommands()
 {
-    const bool useTemporaryMatrices = !m_TemporaryMatrices.empty();
+    Profiler::Marker _("RenderQueue::RecordCommands");
 
-    if (drawCallInfo.Instanced)
+    for (size_t i = 0; i < m_DrawCalls.size(); ++i)
     {
-        GraphicsBackend::Current()->BindBuffer(drawCallInfo.InstancedMatricesEntriesView->GetBackendBufferView(), GlobalConstants::InstancingMatricesEntriesData);
-        GraphicsBackend::Current()->BindBuffer(useTemporaryMatrices ? m_TemporaryMatricesBufferView->GetBackendBufferView() : s_PermanentMatricesBufferView->GetBackendBufferView(), GlobalConstants::TransformMatricesData);
+        const DrawCallInfo& drawCall = m_DrawCalls[i];
+        const GraphicsBackendGeometry& geom = drawCall.Geometry->GetGraphicsBackendGeometry();
+        const PrimitiveType primitiveType = drawCall.Geometry->GetPrimitiveType();
+        const IndicesDataType indicesDataType = drawCall.Geometry->GetIndicesDataType();
+        const int elementsCount = drawCall.Geometry->GetElementsCount();
+        const bool hasIndices = drawCall.Geometry->HasIndexes();
+
+        SetupMatrices(drawCall, i);
+        SetupShaderPass(drawCall.Material, drawCall.Geometry->GetVertexAttributes(), primitiveType, drawCall.StencilValue);
+
+        if (drawCall.Instanced)
+        {
+            const int instanceCount = drawCall.InstancesCount;
+            if (hasIndices)
+                m_CommandList.DrawElementsInstanced(geom, primitiveType, elementsCount, indicesDataType, instanceCount);
+            else
+                m_CommandList.DrawArraysInstanced(geom, primitiveType, 0, elementsCount, instanceCount);
+        }
+        else
+        {
+            if (hasIndices)
+                m_CommandList.DrawElements(geom, primitiveType, elementsCount, indicesDataType);
+            else
+                m_CommandList.DrawArrays(geom, primitiveType, 0, elementsCount);
+        }
     }
-    else
-	    GraphicsBackend::Current()->BindBuffer(drawCallInfo.MatricesBufferViews[0]->GetBackendBufferView(), GlobalConstants::TransformMatricesData);
+}
+
+void RenderQueue::SetupMatrices(const DrawCallInfo& drawCallInfo, size_t drawCallIndex)
+{
+    // all draw calls of the queue read matrices from the same buffer by entry index written in per draw data
+    m_CommandList.BindConstantBuffer(m_PerDrawDataBuffer->GetBackendBuffer(), GlobalConstants::PerDrawDataIndex, drawCallIndex * m_PerDrawDataStride, sizeof(PerDrawData));
+
+    if (drawCallInfo.Instanced)
+        m_CommandList.BindBuffer(m_InstancedMatricesEntriesView->GetBackendBufferView(), GlobalConstants::InstancingMatricesEntriesData);
 }
 
 void RenderQueue::SetupShaderPass(const Material* material, const VertexAttributes& vertexAttributes, PrimitiveType primitiveType, uint8_t stencilValue)
@@ -384,7 +754,7 @@ void RenderQueue::SetupShaderPass(const Material* material, const VertexAttribut
         uint32_t perMaterialDataBinding = 0;
         const std::shared_ptr<GraphicsBuffer>& perMaterialDataBuffer = material->GetPerMaterialDataBuffer(perMaterialDataBinding);
         if (perMaterialDataBuffer)
-            GraphicsBackend::Current()->BindConstantBuffer(perMaterialDataBuffer->GetBackendBuffer(), perMaterialDataBinding, 0, perMaterialDataBuffer->GetSize());
+            m_CommandList.BindConstantBuffer(perMaterialDataBuffer->GetBackendBuffer(), perMaterialDataBinding, 0, perMaterialDataBuffer->GetSize());
 
         for (const auto& pair : material->GetTextures())
         {
@@ -397,78 +767,103 @@ void RenderQueue::SetupShaderPass(const Material* material, const VertexAttribut
                 continue;
             }
 
-            GraphicsBackend::Current()->BindTextureSampler(texture->GetBackendTexture(), texture->GetBackendSampler(), binding);
+            m_CommandList.BindTextureSampler(texture->GetBackendTexture(), texture->GetBackendSampler(), binding);
         }
 
-        GraphicsBackend::Current()->SetDepthState(material->DepthDescriptor);
-        GraphicsBackend::Current()->SetRasterizerState(material->RasterizerDescriptor);
-        GraphicsBackend::Current()->SetBlendState(material->BlendDescriptor);
-        GraphicsBackend::Current()->SetStencilState(material->StencilDescriptor);
+        m_CommandList.SetDepthState(material->DepthDescriptor);
+        m_CommandList.SetRasterizerState(material->RasterizerDescriptor);
+        m_CommandList.SetBlendState(material->BlendDescriptor);
+        m_CommandList.SetStencilState(material->StencilDescriptor);
     }
 
     if (material->StencilDescriptor.Enabled)
-        GraphicsBackend::Current()->SetStencilValue(stencilValue);
+        m_CommandList.SetStencilValue(stencilValue);
 
+    // program depends on render targets bound at submit, so only shader is recorded
     if (m_PreviousMaterial != material || m_PreviousVertexAttributesHash != vertexAttributes.GetHash() || m_PreviousPrimitiveType != primitiveType)
-		GraphicsBackend::Current()->UseProgram(material->GetShader()->GetProgram(vertexAttributes, primitiveType));
+        m_CommandList.UseShader(material->GetShader().get(), &vertexAttributes, primitiveType);
 
     m_PreviousMaterial = material;
     m_PreviousVertexAttributesHash = vertexAttributes.GetHash();
     m_PreviousPrimitiveType = primitiveType;
 }
 
-int RenderQueue::GetMatricesEntry()
+void RenderQueue::UploadMatrices()
 {
-    std::lock_guard<std::mutex> lock(s_FreeMatricesBufferEntriesMutex);
+    Profiler::Marker _("RenderQueue::UploadMatrices");
 
-    if (s_FreeMatricesBufferEntries.empty())
-	    return -1;
+    uint64_t uploadedBytes = 0;
+    uint64_t uploadCalls = 0;
 
-    const uint32_t entry = s_FreeMatricesBufferEntries.front();
-    s_FreeMatricesBufferEntries.pop_front();
-    return entry;
-}
+    if (s_MatricesPool && (s_MatricesPool->IsBufferOutdated() || !s_PermanentMatricesUpdates.empty()))
+    {
+        constexpr uint32_t elementSize = RenderQueueLocal::k_MatricesBufferElementSize;
+
+        // sort updates by entry to merge neighbour entries into a single copy, only the last update of an entry is kept
+        FrameVector<uint64_t> sortedUpdates;
+        sortedUpdates.reserve(s_PermanentMatricesUpdates.size());
+        for (uint32_t i = 0; i < s_PermanentMatricesUpdates.size(); ++i)
+            sortedUpdates.push_back(static_cast<uint64_t>(s_PermanentMatricesUpdates[i].Entry) << 32 | i);
+        std::sort(sortedUpdates.begin(), sortedUpdates.end());
+
+        FrameVector<Matrix4x4> stagingData;
+        FrameVector<std::pair<uint32_t, uint32_t>> ranges;
+        stagingData.reserve(sortedUpdates.size() * 2);
+        for (size_t i = 0; i < sortedUpdates.size(); ++i)
+        {
+            const uint32_t entry = sortedUpdates[i] >> 32;
+            if (i + 1 < sortedUpdates.size() && sortedUpdates[i + 1] >> 32 == entry)
+                continue;
 
-void RenderQueue::FreeMatricesEntry(const std::shared_ptr<GraphicsBufferView>& matricesBufferView)
-{
-    const int entry = RenderQueueLocal::GetEntryFromBufferView(matricesBufferView);
-    if (entry < 0)
-        return;
+            const MatricesUpdate& update = s_PermanentMatricesUpdates[static_cast<uint32_t>(sortedUpdates[i])];
+            stagingData.push_back(update.ModelMatrix);
+            stagingData.push_back(update.NormalMatrix);
 
-    std::lock_guard<std::mutex> lock(s_FreeMatricesBufferEntriesMutex);
-    s_FreeMatricesBufferEntries.push_back(entry);
-}
+            if (!ranges.empty() && ranges.back().first + ranges.back().second == entry)
+                ++ranges.back().second;
+            else
+                ranges.emplace_back(entry, 1);
+        }
 
-void RenderQueue::CheckMatricesBufferSize()
-{
-    Profiler::Marker _("RenderQueue::CheckMatricesBufferSize");
+        GraphicsBackend::Current()->BeginCopyPass("Upload Matrices");
+        {
+            Profiler::GPUMarker gpuMarker("RenderQueue::UploadMatrices", GPUQueue::COPY);
 
-    {
-        std::shared_lock lock(s_PermanentMatricesBufferRecreateMutex);
-        if (!s_FreeMatricesBufferEntries.empty())
-            return;
-    }
+            // pool could grow during prepare, new pages are added to buffer before uploading their matrices
+            s_MatricesPool->UpdateBuffer();
+
+            if (!stagingData.empty())
+            {
+                uploadedBytes = stagingData.size() * sizeof(Matrix4x4);
+                const uint64_t stagingOffset = s_MatricesStagingBuffer->SetData(stagingData.data(), 0, uploadedBytes);
+                ++uploadCalls;
 
-    std::unique_lock lock(s_PermanentMatricesBufferRecreateMutex);
+                const GraphicsBackendBuffer& source = s_MatricesStagingBuffer->GetBackendBuffer();
+                const GraphicsBackendBuffer& destination = s_MatricesPool->GetBuffer()->GetBackendBuffer();
 
-    if (s_FreeMatricesBufferEntries.empty())
-    {
-        s_MatricesBufferCapacity *= 2;
-        CreatePermanentMatricesBuffer();
+                uint64_t sourceOffset = stagingOffset;
+                for (const auto& [firstEntry, count] : ranges)
+                {
+                    GraphicsBackend::Current()->CopyBufferSubData(source, destination, sourceOffset, firstEntry * elementSize, count * elementSize);
+                    sourceOffset += count * elementSize;
+                }
+                uploadCalls += ranges.size();
+            }
+        }
+        GraphicsBackend::Current()->EndCopyPass();
+
+        GraphicsBackend::Current()->SignalFence(s_MatricesUploadFence);
+        GraphicsBackend::Current()->WaitForFence(s_MatricesUploadFence);
+
+        s_PermanentMatricesUpdates.clear();
     }
+
+    Profiler::SetCounter("RenderQueue.MatricesUploadBytes", uploadedBytes);
+    Profiler::SetCounter("RenderQueue.MatricesUploadCalls", uploadCalls);
 }
 
-void RenderQueue::CreatePermanentMatricesBuffer()
+void RenderQueue::FreeMatricesEntry(int32_t entry)
 {
-    GraphicsBackendBufferDescriptor bufferDescriptor{};
-    bufferDescriptor.AllowCPUWrites = true;
-    bufferDescriptor.Size = s_MatricesBufferCapacity * RenderQueueLocal::k_MatricesBufferElementSize;
-
-    s_PermanentMatricesBuffer = std::make_shared<GraphicsBuffer>(bufferDescriptor, "RenderQueue/PermanentMatricesBuffer");
-    s_FreeMatricesBufferEntries.resize(s_MatricesBufferCapacity);
-    for (uint32_t i = 0; i < s_MatricesBufferCapacity; ++i)
-        s_FreeMatricesBufferEntries[i] = i;
-
-    GraphicsBackendBufferViewDescriptor viewDescriptor = GraphicsBackendBufferViewDescriptor::Structured(s_MatricesBufferCapacity, RenderQueueLocal::k_MatricesBufferElementSize, 0, false);
-    s_PermanentMatricesBufferView = std::make_shared<GraphicsBufferView>(s_PermanentMatricesBuffer, viewDescriptor, "RenderQueue/PermanentMatricesBufferFullView");
+    if (entry >= 0 && s_MatricesPool)
+        s_MatricesPool->Free(entry);
 }
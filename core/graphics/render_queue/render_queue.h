@@ -3,19 +3,24 @@
 
 #include "graphics/draw_call_info.h"
 #include "culling/frustum.h"
+#include "bounds/bounds_soa.h"
+#include "culling/bounds_tree.h"
 #include "drawable_geometry/vertex_attributes/vertex_attributes.h"
 #include "enums/primitive_type.h"
+#include "types/graphics_backend_fence.h"
+#include "graphics/command_list/command_list.h"
 
 #include <vector>
 #include <memory>
 #include <mutex>
-#include <deque>
-#include <shared_mutex>
+#include <span>
 
 class Renderer;
+class Scene;
 class RingBuffer;
 class GraphicsBuffer;
 class GraphicsBufferView;
+class MatricesPool;
 struct RenderSettings;
 
 class RenderQueue
@@ -34,6 +39,13 @@ public:
 
     void Prepare(const Matrix4x4& viewProjectionMatrix, const std::vector<std::shared_ptr<Renderer>>& renderers, const RenderSettings& renderSettings);
     void Prepare(const Matrix4x4& viewProjectionMatrix, const std::vector<Item>& items, const RenderSettings& renderSettings);
+
+    // prepares several queues with the same settings, renderers are traversed and culled against all frustums at once
+    static void Prepare(std::span<RenderQueue* const> queues, std::span<const Matrix4x4> viewProjectionMatrices, const std::vector<std::shared_ptr<Renderer>>& renderers, const RenderSettings& renderSettings);
+
+    // same as above, but renderers are culled by traversing scene bounds tree
+    void Prepare(const Matrix4x4& viewProjectionMatrix, const std::shared_ptr<Scene>& scene, const RenderSettings& renderSettings);
+    static void Prepare(std::span<RenderQueue* const> queues, std::span<const Matrix4x4> viewProjectionMatrices, const std::shared_ptr<Scene>& scene, const RenderSettings& renderSettings);
     void Clear();
 
     bool IsEmpty() const;
@@ -41,45 +53,87 @@ public:
 
     void Draw();
 
-    static void FreeMatricesEntry(const std::shared_ptr<GraphicsBufferView>& matricesBufferView);
+    // uploads matrices of renderers updated during prepare, must be called on the main thread before queues are drawn
+    static void UploadMatrices();
+    static void FreeMatricesEntry(int32_t entry);
 
     static bool EnableFrustumCulling;
     static bool FreezeFrustumCulling;
 
 private:
+    // renderers to set up draw calls for, either not culled yet or already culled by scene with frustums mask per renderer
+    struct RenderersSource
+    {
+        std::span<Renderer* const> Renderers;
+        std::span<const BoundsTree<Renderer>::QueryResult> CulledRenderers;
+        // optional world bounds of not culled renderers, placed at the same indices
+        const BoundsSoA* Bounds = nullptr;
+
+        bool IsCulled() const;
+        size_t Size() const;
+    };
+
+    struct MatricesUpdate
+    {
+        Matrix4x4 ModelMatrix;
+        Matrix4x4 NormalMatrix;
+        uint32_t Entry;
+    };
+
+    struct SetupChunk
+    {
+        std::vector<std::pair<Renderer*, DrawCallInfo>> Candidates;
+        std::vector<uint32_t> CandidatesFrustumsMasks;
+        BoundsSoA CandidatesBounds;
+        std::vector<std::vector<uint64_t>> SourceVisibilityMasks;
+        std::vector<std::vector<uint64_t>> VisibilityMasks;
+        std::vector<MatricesUpdate> MatricesUpdates;
+    };
+
     std::vector<DrawCallInfo> m_DrawCalls;
     const Material* m_PreviousMaterial;
     size_t m_PreviousVertexAttributesHash;
     PrimitiveType m_PreviousPrimitiveType;
     Frustum m_Frustum;
 
+    std::vector<Frustum> m_SetupFrustums;
+    std::vector<Renderer*> m_SourceRenderers;
+    std::vector<BoundsTree<Renderer>::QueryResult> m_CulledRenderers;
+    std::vector<SetupChunk> m_SetupChunks;
+    std::vector<std::vector<DrawCallInfo>> m_ChunksDrawCalls;
+
     std::vector<uint32_t> m_InstancedMatricesEntries;
-    std::vector<uint32_t> m_InstancedMatricesEntriesCounts;
     std::shared_ptr<GraphicsBuffer> m_InstancedMatricesEntriesBuffer;
+    std::shared_ptr<GraphicsBufferView> m_InstancedMatricesEntriesView;
+
+    std::vector<uint8_t> m_PerDrawData;
+    std::shared_ptr<GraphicsBuffer> m_PerDrawDataBuffer;
+    uint32_t m_PerDrawDataStride = 0;
+
+    // draw commands are recorded during prepare and executed on draw
+    CommandList m_CommandList;
 
     std::vector<Matrix4x4> m_TemporaryMatrices;
     std::shared_ptr<GraphicsBuffer> m_TemporaryMatricesBuffer;
     std::shared_ptr<GraphicsBufferView> m_TemporaryMatricesBufferView;
 
     static std::mutex s_PermanentMatricesUpdatesMutex;
-    static std::shared_mutex s_PermanentMatricesBufferRecreateMutex;
-    static std::vector<std::pair<Matrix4x4, uint32_t>> s_PermanentMatricesUpdates;
-    static std::shared_ptr<GraphicsBuffer> s_PermanentMatricesBuffer;
-    static std::shared_ptr<GraphicsBufferView> s_PermanentMatricesBufferView;
-
-    static std::mutex s_FreeMatricesBufferEntriesMutex;
-    static std::deque<uint32_t> s_FreeMatricesBufferEntries;
-    static uint32_t s_MatricesBufferCapacity;
-
-    void SetupDrawCalls(const std::vector<std::shared_ptr<Renderer>>& renderers, const RenderSettings& settings, const Frustum& frustum);
+    static std::vector<MatricesUpdate> s_PermanentMatricesUpdates;
+    static std::unique_ptr<MatricesPool> s_MatricesPool;
+    static std::shared_ptr<RingBuffer> s_MatricesStagingBuffer;
+    static GraphicsBackendFence s_MatricesUploadFence;
+
+    static void BeginPrepare(std::span<RenderQueue* const> queues, std::span<const Matrix4x4> viewProjectionMatrices);
+    static void EndPrepare(std::span<RenderQueue* const> queues, std::span<const Matrix4x4> viewProjectionMatrices, const RenderSettings& settings);
+    static void SetupDrawCalls(std::span<RenderQueue* const> queues, const RenderersSource& renderers, const RenderSettings& settings);
+    static void SetupDrawCallsChunk(std::span<RenderQueue* const> queues, const RenderersSource& renderers, size_t chunkIndex, const RenderSettings& settings, SetupChunk& chunk);
     void SetupDrawCalls(const std::vector<Item>& items, const RenderSettings& settings, const Frustum& frustum);
+    void RequestTextureMips(const Matrix4x4& viewProjectionMatrix) const;
     void BatchDrawCalls();
-    void SetupMatrices(const DrawCallInfo& drawCallInfo) const;
+    void SetupPerDrawData();
+    void RecordCommands();
+    void SetupMatrices(const DrawCallInfo& drawCallInfo, size_t drawCallIndex);
     void SetupShaderPass(const Material* material, const VertexAttributes& vertexAttributes, PrimitiveType primitiveType, uint8_t stencilValue);
-
-    static int GetMatricesEntry();
-    static void CheckMatricesBufferSize();
-    static void CreatePermanentMatricesBuffer();
 };
 
 #endif //RENDER_QUEUE_H
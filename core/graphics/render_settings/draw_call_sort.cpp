@@ -0,0 +1,131 @@
+#include "draw_call_sort.h"
+#include "material/material.h"
+#include "graphics/draw_call_info.h"
+
+#include <algorithm>
+
+namespace DrawCallSortLocal
+{
+    constexpr int k_RenderQueueBits = 13;
+    constexpr int k_DepthBits = 19;
+    constexpr int k_ShaderBits = 12;
+    constexpr int k_MaterialBits = 12;
+    constexpr int k_GeometryBits = 8;
+
+    static_assert(k_RenderQueueBits + k_DepthBits + k_ShaderBits + k_MaterialBits + k_GeometryBits == 64);
+
+    constexpr int k_RadixBits = 8;
+    constexpr size_t k_RadixSize = 1 << k_RadixBits;
+
+    uint64_t GetPointerBits(const void* pointer, int bits)
+    {
+        // objects with same bits are only placed next to each other, so collisions affect state changes count but not correctness
+        uint64_t value = reinterpret_cast<uintptr_t>(pointer);
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        return value >> (64 - bits);
+    }
+
+    void RadixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& indices)
+    {
+        thread_local std::vector<uint64_t> tempKeys;
+        thread_local std::vector<uint32_t> tempIndices;
+
+        const size_t count = keys.size();
+        tempKeys.resize(count);
+        tempIndices.resize(count);
+
+        for (int shift = 0; shift < 64; shift += k_RadixBits)
+        {
+            size_t offsets[k_RadixSize] = {};
+            for (uint64_t key : keys)
+                ++offsets[(key >> shift) & (k_RadixSize - 1)];
+
+            // all keys have the same digit, pass would not change the order
+            if (offsets[(keys[0] >> shift) & (k_RadixSize - 1)] == count)
+                continue;
+
+            size_t offset = 0;
+            for (size_t& digitOffset : offsets)
+            {
+                const size_t digitCount = digitOffset;
+                digitOffset = offset;
+                offset += digitCount;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t target = offsets[(keys[i] >> shift) & (k_RadixSize - 1)]++;
+                tempKeys[target] = keys[i];
+                tempIndices[target] = indices[i];
+            }
+
+            keys.swap(tempKeys);
+            indices.swap(tempIndices);
+        }
+    }
+}
+
+namespace DrawCallSort
+{
+    uint64_t GetKey(const DrawCallInfo& drawCall, uint32_t depthBucket)
+    {
+        using namespace DrawCallSortLocal;
+
+        const int renderQueue = std::clamp(drawCall.Material->GetRenderQueue(), 0, (1 << k_RenderQueueBits) - 1);
+
+        uint64_t key = static_cast<uint64_t>(renderQueue);
+        key = key << k_DepthBits | (depthBucket & ((1U << k_DepthBits) - 1));
+        key = key << k_ShaderBits | GetPointerBits(drawCall.Material->GetShader().get(), k_ShaderBits);
+        key = key << k_MaterialBits | GetPointerBits(drawCall.Material, k_MaterialBits);
+        key = key << k_GeometryBits | GetPointerBits(drawCall.Geometry, k_GeometryBits);
+        return key;
+    }
+
+    void Sort(DrawCallSortMode sortMode, const Vector3& cameraDirection, std::vector<DrawCallInfo>& drawCalls)
+    {
+        using namespace DrawCallSortLocal;
+
+        // draw calls without sorting keep the order they were submitted in, overlays rely on it
+        const size_t count = drawCalls.size();
+        if (count < 2 || sortMode == DrawCallSortMode::NO_SORTING)
+            return;
+
+        thread_local std::vector<float> depths;
+        thread_local std::vector<uint64_t> keys;
+        thread_local std::vector<uint32_t> indices;
+        thread_local std::vector<DrawCallInfo> sortedDrawCalls;
+
+        // depth is quantized relative to the range of current draw calls, so buckets are not wasted on empty space
+        depths.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            depths[i] = Vector3::Dot(drawCalls[i].AABB.GetCenter(), cameraDirection);
+
+        const auto [minIt, maxIt] = std::minmax_element(depths.begin(), depths.end());
+        const float minDepth = *minIt;
+        const float depthScale = *maxIt > *minIt ? ((1U << k_DepthBits) - 1) / (*maxIt - *minIt) : 0;
+
+        keys.resize(count);
+        indices.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t depthBucket = static_cast<uint32_t>((depths[i] - minDepth) * depthScale);
+            if (sortMode == DrawCallSortMode::BACK_TO_FRONT)
+                depthBucket = ((1U << k_DepthBits) - 1) - depthBucket;
+
+            keys[i] = GetKey(drawCalls[i], depthBucket);
+            drawCalls[i].SortKey = keys[i];
+            indices[i] = static_cast<uint32_t>(i);
+        }
+
+        RadixSort(keys, indices);
+
+        sortedDrawCalls.clear();
+        sortedDrawCalls.reserve(count);
+        for (uint32_t index : indices)
+            sortedDrawCalls.push_back(std::move(drawCalls[index]));
+
+        drawCalls.swap(sortedDrawCalls);
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef RENDER_ENGINE_DRAW_CALL_SORT_H
+#define RENDER_ENGINE_DRAW_CALL_SORT_H
+
+#include <vector3/vector3.h>
+
+#include <cstdint>
+#include <vector>
+
+struct DrawCallInfo;
+
+enum class DrawCallSortMode
+{
+    FRONT_TO_BACK,
+    BACK_TO_FRONT,
+    NO_SORTING
+};
+
+namespace DrawCallSort
+{
+    // key bits from highest to lowest: render queue, depth bucket, shader, material, geometry
+    uint64_t GetKey(const DrawCallInfo& drawCall, uint32_t depthBucket);
+
+    // writes sort key of each draw call and reorders them by keys with radix sort.
+    // NO_SORTING keeps draw calls in submission order and doesn't write keys
+    void Sort(DrawCallSortMode sortMode, const Vector3& cameraDirection, std::vector<DrawCallInfo>& drawCalls);
+}
+
+#endif //RENDER_ENGINE_DRAW_CALL_SORT_H
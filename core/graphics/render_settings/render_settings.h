@@ -1,7 +1,7 @@
 #ifndef RENDER_ENGINE_RENDER_SETTINGS_H
 #define RENDER_ENGINE_RENDER_SETTINGS_H
 
-#include "draw_call_comparer.h"
+#include "draw_call_sort.h"
 #include "draw_call_filter.h"
 #include "culling/frustum.h"
 
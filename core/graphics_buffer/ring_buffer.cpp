@@ -3,46 +3,116 @@
 #include "graphics/graphics.h"
 #include "math_utils.h"
 #include "types/graphics_backend_buffer_descriptor.h"
+#include "editor/profiler/profiler.h"
+
+#include <algorithm>
 
 RingBuffer::RingBuffer(const GraphicsBackendBufferDescriptor& descriptor, const std::string& name) :
+    m_CurrentBlock(0),
+    m_CurrentFrame(0),
+    m_Stats(),
     m_Name(name),
-    m_CurrentOffset(0),
-    m_LastCheckFrame(0),
 	m_Descriptor(descriptor)
 {
-    m_Buffer = std::make_shared<GraphicsBuffer>(m_Descriptor, m_Name);
+    AddBlock(m_Descriptor.Size);
+}
+
+uint64_t RingBuffer::SetData(const void *data, uint64_t offset, uint64_t size, bool* outNewBlock)
+{
+    // only reserved space is aligned, data is copied with its own size, so caller's memory is not read past the end
+    offset = Math::Align(offset, GraphicsBackend::Current()->GetConstantBufferOffsetAlignment());
+    const uint64_t allocationOffset = Allocate(offset + size, outNewBlock);
+
+    m_Blocks[m_CurrentBlock].Buffer->SetData(data, allocationOffset + offset, size);
+
+    return allocationOffset;
 }
 
-uint64_t RingBuffer::SetData(const void *data, uint64_t offset, uint64_t size, bool* outResized)
+uint64_t RingBuffer::Allocate(uint64_t size, bool* outNewBlock)
 {
     const uint64_t currentFrame = GraphicsBackend::Current()->GetFrameNumber();
+    if (m_CurrentFrame != currentFrame)
+        BeginFrame(currentFrame);
 
-    if (m_LastCheckFrame != currentFrame)
+    const uint64_t requiredSize = Math::Align(size, GraphicsBackend::Current()->GetConstantBufferOffsetAlignment());
+
+    // try the current block first, so data of a frame is placed in as few blocks as possible
+    uint64_t allocationOffset = 0;
+    bool allocated = TryAllocate(m_Blocks[m_CurrentBlock], requiredSize, allocationOffset);
+    for (size_t i = 0; i < m_Blocks.size() && !allocated; ++i)
     {
-        m_CurrentOffset = 0;
-        m_LastCheckFrame = currentFrame;
+        if (i != m_CurrentBlock && TryAllocate(m_Blocks[i], requiredSize, allocationOffset))
+        {
+            m_CurrentBlock = i;
+            allocated = true;
+        }
     }
 
-    offset = Math::Align(offset, GraphicsBackend::Current()->GetConstantBufferOffsetAlignment());
-    size = Math::Align(size, GraphicsBackend::Current()->GetConstantBufferOffsetAlignment());
+    if (!allocated)
+    {
+        AddBlock(std::max(m_Blocks.back().Size * 2, requiredSize));
+        TryAllocate(m_Blocks[m_CurrentBlock], requiredSize, allocationOffset);
+    }
 
-    const uint64_t bufferSize = m_Buffer->GetSize();
-    const uint64_t currentOffset = m_CurrentOffset;
-    const uint64_t requiredSize = currentOffset + offset + size;
+    if (outNewBlock)
+        *outNewBlock = !allocated;
 
-    const bool needsResizing = m_Buffer->GetSize() < requiredSize;
-    if (needsResizing)
-    {
-        m_Descriptor.Size = std::max(bufferSize * 2, requiredSize);
+    m_Stats.FrameBytes += requiredSize;
+    m_Stats.InFlightBytes = 0;
+    for (const Block& block : m_Blocks)
+        m_Stats.InFlightBytes += block.Head - block.Tail;
+    m_Stats.HighWaterBytes = std::max(m_Stats.HighWaterBytes, m_Stats.InFlightBytes);
+
+    return allocationOffset;
+}
 
-        m_Buffer = std::make_shared<GraphicsBuffer>(m_Descriptor, m_Name);
-        m_CurrentOffset = 0;
+void RingBuffer::BeginFrame(uint64_t frame)
+{
+    FrameRegion& region = m_FrameRegions.emplace_back();
+    region.Frame = m_CurrentFrame;
+    region.Heads.reserve(m_Blocks.size());
+    for (const Block& block : m_Blocks)
+        region.Heads.push_back(block.Head);
+
+    // backend doesn't let CPU be more than max frames in flight ahead of GPU, so data of older frames is not used anymore
+    while (!m_FrameRegions.empty() && m_FrameRegions.front().Frame + GraphicsBackend::GetMaxFramesInFlight() <= frame)
+    {
+        const FrameRegion& finishedRegion = m_FrameRegions.front();
+        for (size_t i = 0; i < finishedRegion.Heads.size(); ++i)
+            m_Blocks[i].Tail = finishedRegion.Heads[i];
+        m_FrameRegions.pop_front();
     }
 
-    if(outResized)
-		*outResized = needsResizing;
+    m_Stats.FrameBytes = 0;
+    m_CurrentFrame = frame;
+}
+
+void RingBuffer::AddBlock(uint64_t size)
+{
+    Profiler::Marker _("RingBuffer::AddBlock");
+
+    m_Descriptor.Size = Math::Align(size, GraphicsBackend::Current()->GetConstantBufferOffsetAlignment());
+
+    Block& block = m_Blocks.emplace_back();
+    block.Buffer = std::make_shared<GraphicsBuffer>(m_Descriptor, m_Name);
+    block.Size = m_Descriptor.Size;
+
+    m_CurrentBlock = m_Blocks.size() - 1;
+
+    m_Stats.Capacity += block.Size;
+    m_Stats.BlocksCount = m_Blocks.size();
+}
+
+bool RingBuffer::TryAllocate(Block& block, uint64_t size, uint64_t& outOffset)
+{
+    // allocation can't wrap around the end of the buffer, the rest of the buffer is skipped instead
+    const uint64_t position = block.Head % block.Size;
+    const uint64_t padding = position + size > block.Size ? block.Size - position : 0;
+    if (block.Head + padding + size - block.Tail > block.Size)
+        return false;
 
-    m_Buffer->SetData(data, currentOffset + offset, size);
-    m_CurrentOffset += offset + size;
-    return currentOffset;
+    block.Head += padding;
+    outOffset = block.Head % block.Size;
+    block.Head += size;
+    return true;
 }
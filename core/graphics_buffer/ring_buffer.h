@@ -5,29 +5,51 @@
 #include "types/graphics_backend_buffer_descriptor.h"
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 class GraphicsBuffer;
 class GraphicsBackendBuffer;
 
+// Allocates per frame data in chained GPU buffers. Data of a frame is reclaimed when GPU can't use it anymore,
+// new block is added when all blocks are full, so previously returned offsets stay valid
 class RingBuffer
 {
 public:
+    struct Stats
+    {
+        uint64_t FrameBytes;
+        uint64_t InFlightBytes;
+        uint64_t HighWaterBytes;
+        uint64_t Capacity;
+        uint32_t BlocksCount;
+    };
+
     RingBuffer(const GraphicsBackendBufferDescriptor& descriptor, const std::string& name);
     ~RingBuffer() = default;
 
-    const std::shared_ptr<GraphicsBuffer> GetBuffer() const
+    // buffer of the block used by the last SetData or Allocate call
+    const std::shared_ptr<GraphicsBuffer>& GetBuffer() const
     {
-        return m_Buffer;
+        return m_Blocks[m_CurrentBlock].Buffer;
     }
 
     const GraphicsBackendBuffer& GetBackendBuffer() const
     {
-        return m_Buffer->GetBackendBuffer();
+        return GetBuffer()->GetBackendBuffer();
+    }
+
+    const Stats& GetStats() const
+    {
+        return m_Stats;
     }
 
-    uint64_t SetData(const void *data, uint64_t offset, uint64_t size, bool* outResized = nullptr);
+    // returns offset in the current buffer, outNewBlock is set if data didn't fit into existing blocks
+    uint64_t SetData(const void *data, uint64_t offset, uint64_t size, bool* outNewBlock = nullptr);
+    // reserves space without writing to it, so commands referencing the data can be recorded before it is uploaded to GetBuffer()
+    uint64_t Allocate(uint64_t size, bool* outNewBlock = nullptr);
 
     RingBuffer(const RingBuffer &) = delete;
     RingBuffer(RingBuffer &&) = delete;
@@ -36,13 +58,35 @@ public:
     RingBuffer &operator()(RingBuffer &&) = delete;
 
 private:
-    std::shared_ptr<GraphicsBuffer> m_Buffer;
-    std::string m_Name;
+    struct Block
+    {
+        std::shared_ptr<GraphicsBuffer> Buffer;
+        uint64_t Size;
+
+        // positions only grow, offset in buffer is position modulo size
+        uint64_t Head = 0;
+        uint64_t Tail = 0;
+    };
+
+    // heads of all blocks at the end of the frame, data before them is free when frame is finished by GPU
+    struct FrameRegion
+    {
+        uint64_t Frame;
+        std::vector<uint64_t> Heads;
+    };
 
-    uint64_t m_CurrentOffset;
-    uint64_t m_LastCheckFrame;
+    std::vector<Block> m_Blocks;
+    std::deque<FrameRegion> m_FrameRegions;
+    size_t m_CurrentBlock;
+    uint64_t m_CurrentFrame;
+    Stats m_Stats;
 
+    std::string m_Name;
     GraphicsBackendBufferDescriptor m_Descriptor;
+
+    void BeginFrame(uint64_t frame);
+    void AddBlock(uint64_t size);
+    static bool TryAllocate(Block& block, uint64_t size, uint64_t& outOffset);
 };
 
 
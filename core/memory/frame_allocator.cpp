@@ -0,0 +1,126 @@
+#include "frame_allocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace FrameAllocatorLocal
+{
+    constexpr size_t k_SlabSize = 256 * 1024;
+
+    struct Slab
+    {
+        std::unique_ptr<std::byte[]> Data;
+        size_t Size;
+    };
+
+    struct ThreadArena;
+
+    std::atomic<uint64_t> s_Frame = 0;
+    std::mutex s_ArenasMutex;
+    std::vector<ThreadArena*> s_Arenas;
+
+    struct ThreadArena
+    {
+        std::vector<Slab> Slabs;
+        size_t CurrentSlab = 0;
+        size_t Offset = 0;
+        uint64_t Frame = 0;
+
+        // written only by owning thread, read when stats are collected
+        std::atomic<uint64_t> Allocations = 0;
+        std::atomic<uint64_t> Bytes = 0;
+        std::atomic<uint64_t> SlabAllocations = 0;
+
+        ThreadArena()
+        {
+            std::lock_guard lock(s_ArenasMutex);
+            s_Arenas.push_back(this);
+        }
+
+        ~ThreadArena()
+        {
+            std::lock_guard lock(s_ArenasMutex);
+            std::erase(s_Arenas, this);
+        }
+
+        void* Allocate(size_t size, size_t alignment)
+        {
+            // memory of previous frames is released lazily, so threads never touch each other's slabs
+            const uint64_t frame = s_Frame.load(std::memory_order_relaxed);
+            if (Frame != frame)
+            {
+                Frame = frame;
+                CurrentSlab = 0;
+                Offset = 0;
+            }
+
+            Allocations.fetch_add(1, std::memory_order_relaxed);
+            Bytes.fetch_add(size, std::memory_order_relaxed);
+
+            while (CurrentSlab < Slabs.size())
+            {
+                Slab& slab = Slabs[CurrentSlab];
+                const uintptr_t begin = reinterpret_cast<uintptr_t>(slab.Data.get());
+                const size_t alignedOffset = ((begin + Offset + alignment - 1) & ~(alignment - 1)) - begin;
+                if (alignedOffset + size <= slab.Size)
+                {
+                    Offset = alignedOffset + size;
+                    return slab.Data.get() + alignedOffset;
+                }
+
+                ++CurrentSlab;
+                Offset = 0;
+            }
+
+            const size_t slabSize = std::max(k_SlabSize, size + alignment);
+            Slabs.push_back(Slab{std::make_unique<std::byte[]>(slabSize), slabSize});
+            SlabAllocations.fetch_add(1, std::memory_order_relaxed);
+
+            Slab& slab = Slabs.back();
+            const uintptr_t begin = reinterpret_cast<uintptr_t>(slab.Data.get());
+            const size_t alignedOffset = ((begin + alignment - 1) & ~(alignment - 1)) - begin;
+            Offset = alignedOffset + size;
+            return slab.Data.get() + alignedOffset;
+        }
+    };
+
+    ThreadArena& GetThreadArena()
+    {
+        thread_local ThreadArena arena;
+        return arena;
+    }
+}
+
+void FrameAllocator::BeginFrame()
+{
+    FrameAllocatorLocal::s_Frame.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard lock(FrameAllocatorLocal::s_ArenasMutex);
+    for (FrameAllocatorLocal::ThreadArena* arena : FrameAllocatorLocal::s_Arenas)
+    {
+        arena->Allocations = 0;
+        arena->Bytes = 0;
+        arena->SlabAllocations = 0;
+    }
+}
+
+FrameAllocator::Stats FrameAllocator::GetStats()
+{
+    Stats stats;
+
+    std::lock_guard lock(FrameAllocatorLocal::s_ArenasMutex);
+    for (const FrameAllocatorLocal::ThreadArena* arena : FrameAllocatorLocal::s_Arenas)
+    {
+        stats.Allocations += arena->Allocations.load(std::memory_order_relaxed);
+        stats.Bytes += arena->Bytes.load(std::memory_order_relaxed);
+        stats.SlabAllocations += arena->SlabAllocations.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void* FrameAllocator::Allocate(size_t size, size_t alignment)
+{
+    return FrameAllocatorLocal::GetThreadArena().Allocate(size, alignment);
+}
@@ -0,0 +1,74 @@
+#ifndef RENDER_ENGINE_FRAME_ALLOCATOR_H
+#define RENDER_ENGINE_FRAME_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Linear allocator for data that lives until the end of the current frame.
+// Each thread allocates from its own slabs, slabs are kept and reused after BeginFrame, so allocations are not freed individually
+class FrameAllocator
+{
+public:
+    struct Stats
+    {
+        uint64_t Allocations = 0;
+        uint64_t Bytes = 0;
+        // heap allocations made by allocator itself, stays zero once slabs are warmed up
+        uint64_t SlabAllocations = 0;
+    };
+
+    // must be called when no data from previous frame is used anymore
+    static void BeginFrame();
+    static Stats GetStats();
+
+    static void* Allocate(size_t size, size_t alignment);
+
+    // destructors are never called for frame memory, so only trivially destructible types are allowed
+    template<typename T>
+    static std::span<T> AllocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>);
+
+        if (count == 0)
+            return {};
+
+        T* data = static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+        return {data, count};
+    }
+};
+
+// allows standard containers to use frame memory. Containers must be destroyed before the end of the frame
+template<typename T>
+class FrameStlAllocator
+{
+public:
+    using value_type = T;
+
+    FrameStlAllocator() = default;
+
+    template<typename U>
+    FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    template<typename U>
+    bool operator==(const FrameStlAllocator<U>&) const { return true; }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+using FrameUnorderedMap = std::unordered_map<Key, Value, Hash, std::equal_to<Key>, FrameStlAllocator<std::pair<const Key, Value>>>;
+
+#endif //RENDER_ENGINE_FRAME_ALLOCATOR_H
@@ -47,7 +47,7 @@ Mesh::Mesh(const std::vector<Vector3>& vertices, const std::vector<int>& indices
 {
 }
 
-Mesh::Mesh(const std::span<uint8_t>& vertexData, const std::span<int>& indices, bool hasUV, bool hasNormals, bool hasTangents,
+Mesh::Mesh(std::span<const uint8_t> vertexData, std::span<const int> indices, bool hasUV, bool hasNormals, bool hasTangents,
            const Vector3& minPoint, const Vector3& maxPoint, const std::string& name) :
     DrawableGeometry(PrimitiveType::TRIANGLES, indices.size(), true),
     m_Bounds(minPoint, maxPoint)
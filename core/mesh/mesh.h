@@ -6,6 +6,7 @@
 #include "resources/resource.h"
 
 #include <memory>
+#include <span>
 #include <string>
 
 struct Vector2;
@@ -22,7 +23,7 @@ public:
          const std::vector<Vector2>& uvs,
          const std::vector<Vector3>& tangents,
          const std::string& name);
-    Mesh(const std::span<uint8_t>& vertexData, const std::span<int>& indices, bool hasUV, bool hasNormals, bool hasTangents,
+    Mesh(std::span<const uint8_t> vertexData, std::span<const int> indices, bool hasUV, bool hasNormals, bool hasTangents,
          const Vector3& minPoint, const Vector3& maxPoint, const std::string& name);
     ~Mesh() override = default;
 
@@ -1,22 +1,31 @@
 #include "mesh_binary_reader.h"
 #include "file_system/file_system.h"
+#include "file_system/mapped_file.h"
+
+#include <cstring>
 
 bool MeshBinaryReader::ReadMesh(const std::filesystem::path &path)
 {
     static constexpr int headerSize = sizeof(MeshHeader);
 
-    m_MeshBinaryData.clear();
+    m_MeshFile = FileSystem::MapFile(FileSystem::GetResourcesPath() / path);
+    if (!m_MeshFile)
+        return false;
 
-    if (!FileSystem::ReadFileBytes(FileSystem::GetResourcesPath() / path, m_MeshBinaryData))
+    const std::span<const uint8_t> meshData = m_MeshFile->GetData();
+    if (meshData.size() < headerSize)
         return false;
 
-    m_Header = *reinterpret_cast<MeshHeader*>(m_MeshBinaryData.data());
+    memcpy(&m_Header, meshData.data(), headerSize);
+
+    const uint64_t indicesOffset = headerSize + static_cast<uint64_t>(m_Header.VertexDataSize);
+    if (m_Header.VertexDataSize < 0 || m_Header.IndicesCount < 0 || indicesOffset + m_Header.IndicesCount * sizeof(int) > meshData.size())
+        return false;
 
-    uint8_t* vertexData = reinterpret_cast<uint8_t*>(&m_MeshBinaryData[0] + headerSize);
-    m_VertexData = std::span<uint8_t>(vertexData, m_Header.VertexDataSize);
+    m_VertexData = meshData.subspan(headerSize, m_Header.VertexDataSize);
 
-    int* indices = reinterpret_cast<int*>(&m_MeshBinaryData[0] + headerSize + m_Header.VertexDataSize);
-    m_Indices = std::span<int>(indices, m_Header.IndicesCount);
+    const int* indices = reinterpret_cast<const int*>(meshData.data() + indicesOffset);
+    m_Indices = std::span<const int>(indices, m_Header.IndicesCount);
 
     return true;
 }
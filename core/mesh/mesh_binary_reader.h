@@ -4,9 +4,12 @@
 #include "mesh_header.h"
 
 #include <filesystem>
-#include <vector>
+#include <memory>
 #include <span>
 
+class MappedFile;
+
+// Reads mesh from memory mapped file, vertex data and indices point into the mapping and stay valid while reader is alive
 class MeshBinaryReader
 {
 public:
@@ -14,12 +17,12 @@ public:
 
     bool ReadMesh(const std::filesystem::path &path);
 
-    const std::span<uint8_t>& GetVertexData() const
+    const std::span<const uint8_t>& GetVertexData() const
     {
         return m_VertexData;
     }
 
-    const std::span<int>& GetIndices() const
+    const std::span<const int>& GetIndices() const
     {
         return m_Indices;
     }
@@ -30,9 +33,9 @@ public:
     }
 
 private:
-    std::vector<uint8_t> m_MeshBinaryData;
-    std::span<uint8_t> m_VertexData;
-    std::span<int> m_Indices;
+    std::shared_ptr<MappedFile> m_MeshFile;
+    std::span<const uint8_t> m_VertexData;
+    std::span<const int> m_Indices;
     MeshHeader m_Header{};
 };
 
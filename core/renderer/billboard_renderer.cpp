@@ -57,9 +57,9 @@ BillboardRenderer::BillboardRenderer(const std::shared_ptr<Texture2D>& texture,
     SetSize(size);
 }
 
-Bounds BillboardRenderer::GetAABB() const
+Bounds BillboardRenderer::GetLocalBounds() const
 {
-    return GetModelMatrix() * m_Bounds;
+    return m_Bounds;
 }
 
 std::shared_ptr<DrawableGeometry> BillboardRenderer::GetGeometry()
@@ -75,6 +75,8 @@ void BillboardRenderer::SetSize(float _size)
 
     Vector4 size {_size, _size / m_Aspect, 0, 0};
     m_Material->SetVector("_Size", size);
+
+    InvalidateBounds();
 }
 
 void BillboardRenderer::SetTexture(const std::shared_ptr<Texture2D>& texture)
@@ -15,7 +15,6 @@ public:
     BillboardRenderer(const std::shared_ptr<Texture2D>& texture, float size, const std::string& name);
     ~BillboardRenderer() override = default;
 
-    Bounds GetAABB() const override;
     std::shared_ptr<DrawableGeometry> GetGeometry() override;
     void SetRenderQueue(int _renderQueue);
     void SetSize(float _size);
@@ -27,6 +26,9 @@ public:
     BillboardRenderer &operator=(const BillboardRenderer &) = delete;
     BillboardRenderer &operator=(BillboardRenderer &&) = delete;
 
+protected:
+    Bounds GetLocalBounds() const override;
+
 private:
     BillboardRenderer() = default;
 
@@ -60,9 +60,9 @@ MeshRenderer::MeshRenderer(std::shared_ptr<Mesh>              _mesh,
 {
 }
 
-Bounds MeshRenderer::GetAABB() const
+Bounds MeshRenderer::GetLocalBounds() const
 {
-    return m_Mesh ? GetModelMatrix() * m_Mesh->GetBounds() : Bounds();
+    return m_Mesh ? m_Mesh->GetBounds() : Bounds();
 }
 
 std::shared_ptr<DrawableGeometry> MeshRenderer::GetGeometry()
@@ -73,6 +73,10 @@ std::shared_ptr<DrawableGeometry> MeshRenderer::GetGeometry()
 
 void MeshRenderer::SetMesh(const std::shared_ptr<Mesh> &mesh)
 {
-    std::unique_lock lock(m_MeshMutex);
-    m_Mesh = mesh;
+    {
+        std::unique_lock lock(m_MeshMutex);
+        m_Mesh = mesh;
+    }
+
+    InvalidateBounds();
 }
\ No newline at end of file
@@ -15,7 +15,6 @@ public:
                  const std::shared_ptr<Material>    &_material);
     ~MeshRenderer() override = default;
 
-    Bounds GetAABB() const override;
     std::shared_ptr<DrawableGeometry> GetGeometry() override;
     void SetMesh(const std::shared_ptr<Mesh>& mesh);
 
@@ -25,6 +24,9 @@ public:
     MeshRenderer &operator=(const MeshRenderer &) = delete;
     MeshRenderer &operator=(MeshRenderer &&) = delete;
 
+protected:
+    Bounds GetLocalBounds() const override;
+
 private:
     MeshRenderer() = default;
 
@@ -1,11 +1,11 @@
 #include "renderer.h"
 #include "billboard_renderer.h"
 #include "gameObject/gameObject.h"
+#include "scene/scene.h"
 #include "graphics/graphics.h"
 #include "material/material.h"
 #include "texture_2d/texture_2d.h"
 #include "graphics/render_queue/render_queue.h"
-#include "graphics_buffer/graphics_buffer_view.h"
 
 #include <utility>
 
@@ -16,10 +16,32 @@ Renderer::Renderer(const std::shared_ptr<Material>& material) :
 
 Renderer::~Renderer()
 {
-    SetMatricesBufferView(nullptr);
+    SetMatricesEntry(-1);
+
+    if (std::shared_ptr<Scene> scene = m_Scene.lock())
+        scene->RemoveRenderer(this);
+}
+
+Bounds Renderer::GetAABB() const
+{
+    return m_HasWorldData ? m_AABB : ComputeModelMatrix() * GetLocalBounds();
 }
 
 Matrix4x4 Renderer::GetModelMatrix() const
+{
+    return m_HasWorldData ? m_ModelMatrix : ComputeModelMatrix();
+}
+
+Matrix4x4 Renderer::GetNormalMatrix() const
+{
+    if (m_HasWorldData)
+        return m_NormalMatrix;
+
+    std::shared_ptr<GameObject> go = m_GameObject.lock();
+    return go ? go->GetWorldToLocalMatrix().Transpose() : Matrix4x4::Identity();
+}
+
+Matrix4x4 Renderer::ComputeModelMatrix() const
 {
     if (m_GameObject.expired())
         return Matrix4x4::Identity();
@@ -28,6 +50,24 @@ Matrix4x4 Renderer::GetModelMatrix() const
     return go->GetLocalToWorldMatrix();
 }
 
+void Renderer::UpdateWorldData()
+{
+    // world to local matrix is already computed by transform hierarchy, so normal matrix does not need another inversion
+    if (std::shared_ptr<GameObject> go = m_GameObject.lock())
+    {
+        m_ModelMatrix = go->GetLocalToWorldMatrix();
+        m_NormalMatrix = go->GetWorldToLocalMatrix().Transpose();
+    }
+    else
+    {
+        m_ModelMatrix = Matrix4x4::Identity();
+        m_NormalMatrix = Matrix4x4::Identity();
+    }
+
+    m_AABB = m_ModelMatrix * GetLocalBounds();
+    m_HasWorldData = true;
+}
+
 std::shared_ptr<Material> Renderer::GetMaterial()
 {
     std::shared_lock lock(m_MaterialMutex);
@@ -40,9 +80,9 @@ void Renderer::SetMaterial(std::shared_ptr<Material> material)
     m_Material = std::move(material);
 }
 
-std::shared_mutex& Renderer::GetMatricesBufferViewMutex()
+std::shared_mutex& Renderer::GetMatricesEntryMutex()
 {
-    return m_MatricesBufferViewMutex;
+    return m_MatricesEntryMutex;
 }
 
 bool Renderer::IsTransformDirty() const
@@ -53,15 +93,24 @@ bool Renderer::IsTransformDirty() const
 void Renderer::SetTransformDirty(bool dirty)
 {
     m_TransformDirty = dirty;
+
+    if (dirty)
+        InvalidateBounds();
+}
+
+void Renderer::InvalidateBounds()
+{
+    if (std::shared_ptr<Scene> scene = m_Scene.lock())
+        scene->InvalidateRendererBounds(this);
 }
 
-void Renderer::SetMatricesBufferView(const std::shared_ptr<GraphicsBufferView>& view)
+void Renderer::SetMatricesEntry(int32_t entry)
 {
-    RenderQueue::FreeMatricesEntry(m_MatricesBufferView);
-    m_MatricesBufferView = view;
+    RenderQueue::FreeMatricesEntry(m_MatricesEntry);
+    m_MatricesEntry = entry;
 }
 
-std::shared_ptr<GraphicsBufferView> Renderer::GetMatricesBufferView() const
+int32_t Renderer::GetMatricesEntry() const
 {
-    return m_MatricesBufferView;
+    return m_MatricesEntry;
 }
@@ -2,19 +2,19 @@
 #define RENDER_ENGINE_RENDERER_H
 
 #include "component/component.h"
+#include "bounds/bounds.h"
+#include "matrix4x4/matrix4x4.h"
 
 #include <memory>
 #include <string>
 #include <shared_mutex>
+#include <atomic>
 
 class GameObject;
+class Scene;
 class Shader;
 class Material;
-class GraphicsBuffer;
-class GraphicsBufferView;
 struct Vector4;
-struct Matrix4x4;
-struct Bounds;
 struct DrawableGeometry;
 
 class Renderer : public Component
@@ -22,20 +22,23 @@ class Renderer : public Component
 public:
     virtual ~Renderer();
 
-    virtual Bounds GetAABB() const = 0;
     virtual std::shared_ptr<DrawableGeometry> GetGeometry() = 0;
 
+    // world data is cached when renderer is registered in scene and updated once per frame after transform or bounds change
+    Bounds GetAABB() const;
     Matrix4x4 GetModelMatrix() const;
+    Matrix4x4 GetNormalMatrix() const;
     std::shared_ptr<Material> GetMaterial();
 
     void SetMaterial(std::shared_ptr<Material> material);
 
-    std::shared_mutex& GetMatricesBufferViewMutex();
+    std::shared_mutex& GetMatricesEntryMutex();
     bool IsTransformDirty() const;
     void SetTransformDirty(bool dirty);
 
-    void SetMatricesBufferView(const std::shared_ptr<GraphicsBufferView>& view);
-    std::shared_ptr<GraphicsBufferView> GetMatricesBufferView() const;
+    // slot in render queue matrices pool, it stays valid when pool grows
+    void SetMatricesEntry(int32_t entry);
+    int32_t GetMatricesEntry() const;
 
     bool CastShadows = true;
     uint8_t StencilValue = 0;
@@ -47,10 +50,28 @@ protected:
     std::shared_ptr<Material> m_Material;
     std::shared_mutex m_MaterialMutex;
 
+    virtual Bounds GetLocalBounds() const = 0;
+    void InvalidateBounds();
+
 private:
     bool m_TransformDirty = true;
-    std::shared_ptr<GraphicsBufferView> m_MatricesBufferView;
-    std::shared_mutex m_MatricesBufferViewMutex;
+    int32_t m_MatricesEntry = -1;
+    std::shared_mutex m_MatricesEntryMutex;
+
+    std::weak_ptr<Scene> m_Scene;
+    int32_t m_SceneIndex = -1;
+    int32_t m_BoundsTreeProxy = -1;
+    std::atomic<bool> m_BoundsDirty = false;
+
+    Bounds m_AABB;
+    Matrix4x4 m_ModelMatrix;
+    Matrix4x4 m_NormalMatrix;
+    bool m_HasWorldData = false;
+
+    Matrix4x4 ComputeModelMatrix() const;
+    void UpdateWorldData();
+
+    friend class Scene;
 };
 
 #endif //RENDER_ENGINE_RENDERER_H
@@ -4,6 +4,7 @@
 #include "cubemap/cubemap.h"
 #include "editor/profiler/profiler.h"
 #include "texture/texture_binary_reader.h"
+#include "texture_streamer/texture_streamer.h"
 #include "material/material.h"
 #include "material/material_parser.h"
 #include "mesh/mesh.h"
@@ -28,14 +29,14 @@ std::shared_ptr<Texture2D> Resources::Load(const std::filesystem::path& path, bo
     if (TryGetFromCache(path, texture))
         return texture;
 
-    TextureBinaryReader reader;
-    if (!reader.ReadTexture(path))
+    auto reader = std::make_shared<TextureBinaryReader>();
+    if (!reader->ReadTexture(path))
     {
         Debug::LogErrorFormat("[Resources] Cannot load texture: {}", path.string());
         return nullptr;
     }
 
-    const TextureHeader& header = reader.GetHeader();
+    const TextureHeader& header = reader->GetHeader();
 
     GraphicsBackendTextureDescriptor descriptor;
     descriptor.Width = header.Width;
@@ -44,8 +45,12 @@ std::shared_ptr<Texture2D> Resources::Load(const std::filesystem::path& path, bo
     descriptor.Linear = header.IsLinear;
     descriptor.Format = header.TextureFormat;
 
-    texture = std::shared_ptr<Texture2D>(new Texture2D(descriptor, path.string()));
-    UploadPixels(*texture, 1, header.MipCount, reader);
+    // textures loaded in background are streamed, only their smallest mips are uploaded right away
+    const uint32_t residentMip = asyncSubresourceLoads ? TextureStreamer::GetBaseMip(descriptor) : 0;
+    texture = std::shared_ptr<Texture2D>(new Texture2D(descriptor, path.string(), residentMip));
+    UploadPixels(*texture, 1, residentMip, header.MipCount, *reader);
+    if (residentMip > 0)
+        TextureStreamer::Add(texture, 1, reader, path.string());
     AddToCache(path, texture);
 
     return texture;
@@ -60,14 +65,14 @@ std::shared_ptr<Cubemap> Resources::Load(const std::filesystem::path& path, bool
     if (TryGetFromCache(path, cubemap))
         return cubemap;
 
-    TextureBinaryReader reader;
-    if (!reader.ReadTexture(path))
+    auto reader = std::make_shared<TextureBinaryReader>();
+    if (!reader->ReadTexture(path))
     {
         Debug::LogErrorFormat("[Resources] Cannot load cubemap: {}", path.string());
         return nullptr;
     }
 
-    const TextureHeader& header = reader.GetHeader();
+    const TextureHeader& header = reader->GetHeader();
 
     constexpr int facesCount = static_cast<int>(CubemapFace::MAX);
     if (header.Depth != facesCount)
@@ -83,8 +88,11 @@ std::shared_ptr<Cubemap> Resources::Load(const std::filesystem::path& path, bool
     descriptor.Linear = header.IsLinear;
     descriptor.Format = header.TextureFormat;
 
-    cubemap = std::shared_ptr<Cubemap>(new Cubemap(descriptor, path.string()));
-    UploadPixels(*cubemap, facesCount, header.MipCount, reader);
+    const uint32_t residentMip = asyncSubresourceLoads ? TextureStreamer::GetBaseMip(descriptor) : 0;
+    cubemap = std::shared_ptr<Cubemap>(new Cubemap(descriptor, path.string(), residentMip));
+    UploadPixels(*cubemap, facesCount, residentMip, header.MipCount, *reader);
+    if (residentMip > 0)
+        TextureStreamer::Add(cubemap, facesCount, reader, path.string());
     AddToCache(path, cubemap);
 
     return cubemap;
@@ -118,6 +126,7 @@ std::shared_ptr<Mesh> Resources::Load(const std::filesystem::path& path, bool as
     if (TryGetFromCache(path, mesh))
         return mesh;
 
+    // vertex data is uploaded directly from mapped file without intermediate copies
     MeshBinaryReader reader;
     if (!reader.ReadMesh(path))
     {
@@ -156,13 +165,13 @@ std::shared_ptr<Font> Resources::Load(const std::filesystem::path &path, bool as
     return font;
 }
 
-void Resources::UploadPixels(Texture& texture, int facesCount, int mipCount, TextureBinaryReader& reader)
+void Resources::UploadPixels(Texture& texture, int facesCount, int firstMip, int lastMip, const TextureBinaryReader& reader)
 {
-    for (int face = 0; face < facesCount; ++face)
+    for (int mip = lastMip - 1; mip >= firstMip; --mip)
     {
-        for (int mip = 0; mip < mipCount; ++mip)
+        for (int face = 0; face < facesCount; ++face)
         {
-            std::span<uint8_t> pixels = reader.GetPixels(face, mip);
+            std::span<const uint8_t> pixels = reader.GetPixels(face, mip);
             texture.UploadPixels(pixels.data(), pixels.size(), 0, mip, static_cast<CubemapFace>(face));
         }
     }
@@ -76,7 +76,7 @@ private:
         std::vector<std::function<void(std::shared_ptr<Resource>)>> Callbacks;
     };
 
-    static void UploadPixels(Texture& texture, int facesCount, int mipCount, TextureBinaryReader& reader);
+    static void UploadPixels(Texture& texture, int facesCount, int firstMip, int lastMip, const TextureBinaryReader& reader);
 
     static std::unordered_map<std::filesystem::path, std::shared_ptr<Resource>> s_LoadedResources;
     static std::unordered_map<std::filesystem::path, AsyncLoadRequest> s_AsyncLoadRequests;
@@ -2,6 +2,8 @@
 #include "arguments.h"
 #include "scene_parser.h"
 #include "component/component.h"
+#include "renderer/renderer.h"
+#include "bounds/bounds.h"
 #include "graphics_backend_api.h"
 #include "editor/profiler/profiler.h"
 #include "ui/ui_manager.h"
@@ -66,6 +68,9 @@ void Scene::Update()
         Profiler::Marker _("Scene::UpdateComponents");
         UpdateComponents(Current->m_GameObjects);
     }
+
+    if (Current != nullptr)
+        Current->m_TransformHierarchy->Update();
 }
 
 void Scene::Load(const std::string& scenePath)
@@ -113,6 +118,92 @@ void Scene::SetLoading(bool isLoading)
     m_IsLoading = isLoading;
 }
 
+void Scene::AddRenderer(Renderer* renderer)
+{
+    // renderers can be added from loading threads, so they are registered on the next bounds update
+    renderer->m_Scene = weak_from_this();
+    InvalidateRendererBounds(renderer);
+}
+
+void Scene::RemoveRenderer(Renderer* renderer)
+{
+    {
+        std::unique_lock lock(m_DirtyRenderersMutex);
+        std::erase(m_DirtyRenderers, renderer);
+    }
+
+    std::unique_lock lock(m_RenderersMutex);
+    if (renderer->m_BoundsTreeProxy != BoundsTree<Renderer>::NullProxy)
+    {
+        m_RenderersTree.Remove(renderer->m_BoundsTreeProxy);
+        renderer->m_BoundsTreeProxy = BoundsTree<Renderer>::NullProxy;
+    }
+
+    if (renderer->m_SceneIndex >= 0)
+    {
+        Renderer* last = m_Renderers.back();
+        m_Renderers[renderer->m_SceneIndex] = last;
+        last->m_SceneIndex = renderer->m_SceneIndex;
+
+        m_Renderers.pop_back();
+        m_RenderersBounds.RemoveSwapBack(renderer->m_SceneIndex);
+        renderer->m_SceneIndex = -1;
+    }
+
+    // destroyed game object has already unlinked its transform, and its handle can be reused by another object
+    if (std::shared_ptr<GameObject> go = renderer->GetGameObject())
+        m_TransformHierarchy->SetRenderer(go->m_TransformHandle, nullptr);
+}
+
+void Scene::InvalidateRendererBounds(Renderer* renderer)
+{
+    if (renderer->m_BoundsDirty.exchange(true))
+        return;
+
+    std::unique_lock lock(m_DirtyRenderersMutex);
+    m_DirtyRenderers.push_back(renderer);
+}
+
+void Scene::UpdateRenderersBounds()
+{
+    Profiler::Marker _("Scene::UpdateRenderersBounds");
+
+    std::unique_lock dirtyLock(m_DirtyRenderersMutex);
+    std::unique_lock treeLock(m_RenderersMutex);
+
+    for (Renderer* renderer : m_DirtyRenderers)
+    {
+        renderer->m_BoundsDirty = false;
+        renderer->UpdateWorldData();
+
+        const Bounds bounds = renderer->GetAABB();
+        if (renderer->m_BoundsTreeProxy == BoundsTree<Renderer>::NullProxy)
+        {
+            renderer->m_BoundsTreeProxy = m_RenderersTree.Insert(bounds, renderer);
+            renderer->m_SceneIndex = static_cast<int32_t>(m_Renderers.size());
+            m_Renderers.push_back(renderer);
+            m_RenderersBounds.Add(bounds);
+
+            // transform hierarchy is modified only on the main thread, so renderer is linked to it here and not on attach
+            if (std::shared_ptr<GameObject> go = renderer->GetGameObject())
+                m_TransformHierarchy->SetRenderer(go->m_TransformHandle, renderer);
+        }
+        else
+        {
+            m_RenderersTree.Update(renderer->m_BoundsTreeProxy, bounds);
+            m_RenderersBounds.Set(renderer->m_SceneIndex, bounds);
+        }
+    }
+
+    m_DirtyRenderers.clear();
+}
+
+void Scene::QueryRenderers(std::span<const Frustum> frustums, uint32_t planesBits, std::vector<BoundsTree<Renderer>::QueryResult>& outRenderers)
+{
+    std::shared_lock lock(m_RenderersMutex);
+    m_RenderersTree.Query(frustums, planesBits, outRenderers);
+}
+
 void Scene::LoadInternal()
 {
     Profiler::Marker _("Scene::LoadInternal");
@@ -3,17 +3,23 @@
 
 #include "gameObject/gameObject.h"
 #include "vector3/vector3.h"
+#include "culling/bounds_tree.h"
+#include "bounds/bounds_soa.h"
 #include <memory>
 #include <string>
 #include <vector>
 #include <functional>
 #include <filesystem>
 #include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <span>
 
 class Light;
+class Renderer;
 class Cubemap;
 
-class Scene
+class Scene : public std::enable_shared_from_this<Scene>
 {
 public:
     inline static std::shared_ptr<Scene> Current = nullptr;
@@ -34,12 +40,37 @@ public:
         return m_GameObjects;
     }
 
+    inline const std::shared_ptr<TransformHierarchy>& GetTransformHierarchy() const
+    {
+        return m_TransformHierarchy;
+    }
+
     bool IsLoading();
     void SetLoading(bool isLoading);
 
+    void AddRenderer(Renderer* renderer);
+    void RemoveRenderer(Renderer* renderer);
+    void InvalidateRendererBounds(Renderer* renderer);
+    void UpdateRenderersBounds();
+
+    void QueryRenderers(std::span<const Frustum> frustums, uint32_t planesBits, std::vector<BoundsTree<Renderer>::QueryResult>& outRenderers);
+
+    // registered renderers are added and removed only on the main thread between frames
+    inline const std::vector<Renderer*>& GetRenderers() const
+    {
+        return m_Renderers;
+    }
+
+    // world bounds of registered renderers, placed at the same indices as renderers
+    inline const BoundsSoA& GetRenderersBounds() const
+    {
+        return m_RenderersBounds;
+    }
+
 private:
     static std::filesystem::path s_PendingScenePath;
 
+    std::shared_ptr<TransformHierarchy> m_TransformHierarchy = std::make_shared<TransformHierarchy>();
     std::vector<std::shared_ptr<GameObject>> m_GameObjects;
 
     std::shared_mutex m_SkyboxMutex;
@@ -47,6 +78,14 @@ private:
 
     std::atomic<bool> m_IsLoading;
 
+    std::shared_mutex m_RenderersMutex;
+    std::vector<Renderer*> m_Renderers;
+    BoundsSoA m_RenderersBounds;
+    BoundsTree<Renderer> m_RenderersTree;
+
+    std::mutex m_DirtyRenderersMutex;
+    std::vector<Renderer*> m_DirtyRenderers;
+
     static void LoadInternal();
     static void UpdateComponents(std::vector<std::shared_ptr<GameObject>>& gameObjects);
 };
@@ -5,6 +5,7 @@
 #include "cubemap/cubemap.h"
 #include "json_common/json_common.h"
 #include "resources/resources.h"
+#include "shader/pipeline_cache/pipeline_cache.h"
 
 namespace SceneParser
 {
@@ -92,6 +93,9 @@ namespace SceneParser
             }
         }
 
+        // programs recorded in previous runs are created while scene is loading instead of on first draw
+        loadingTask->AddDependency(PipelineCache::Prewarm());
+
         if (!sceneInfo.Settings.Skybox.empty())
         {
             std::shared_ptr<Worker::Task> skyboxTask = Resources::LoadAsync<Cubemap>(sceneInfo.Settings.Skybox, [scene](std::shared_ptr<Cubemap> skybox)
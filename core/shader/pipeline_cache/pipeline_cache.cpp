@@ -0,0 +1,309 @@
+#include "pipeline_cache.h"
+#include "shader/shader.h"
+#include "file_system/file_system.h"
+#include "graphics_backend_api.h"
+#include "editor/profiler/profiler.h"
+#include "debug.h"
+#include "hash.h"
+
+#include <cstring>
+#include <map>
+#include <type_traits>
+
+std::mutex PipelineCache::s_EntriesMutex;
+std::vector<PipelineCache::Entry> PipelineCache::s_Entries;
+std::unordered_set<size_t> PipelineCache::s_EntriesHashes;
+size_t PipelineCache::s_PrewarmedEntriesCount = 0;
+bool PipelineCache::s_Dirty = false;
+
+std::mutex PipelineCache::s_PrewarmMutex;
+std::shared_ptr<Worker::Task> PipelineCache::s_PrewarmTask;
+uint64_t PipelineCache::s_PrewarmGeneration = 0;
+std::vector<std::shared_ptr<Shader>> PipelineCache::s_PrewarmedShaders;
+
+std::atomic<uint64_t> PipelineCache::s_Hits = 0;
+std::atomic<uint64_t> PipelineCache::s_Misses = 0;
+std::atomic<uint64_t> PipelineCache::s_CompileTimeUs = 0;
+std::atomic<uint64_t> PipelineCache::s_PrewarmedPrograms = 0;
+
+namespace PipelineCacheLocal
+{
+    constexpr uint32_t k_Magic = 0x50534F43; // PSOC
+    // must be increased when layout of the file or of any serialized descriptor changes
+    constexpr uint32_t k_Version = 1;
+
+    // empty if platform has no writable cache directory
+    std::filesystem::path GetPath()
+    {
+        const std::filesystem::path& cachePath = FileSystem::GetCachePath();
+        if (cachePath.empty())
+            return {};
+
+        const int backendName = static_cast<int>(GraphicsBackend::Current()->GetName());
+        return cachePath / ("pipeline_cache_" + std::to_string(backendName) + ".bin");
+    }
+
+    template<typename T>
+    void Write(std::vector<uint8_t>& bytes, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        const size_t offset = bytes.size();
+        bytes.resize(offset + sizeof(T));
+        memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    void WriteString(std::vector<uint8_t>& bytes, const std::string& value)
+    {
+        Write(bytes, static_cast<uint32_t>(value.size()));
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+
+    template<typename T>
+    bool Read(const std::vector<uint8_t>& bytes, size_t& offset, T& outValue)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (offset + sizeof(T) > bytes.size())
+            return false;
+
+        memcpy(&outValue, bytes.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(const std::vector<uint8_t>& bytes, size_t& offset, std::string& outValue)
+    {
+        uint32_t size;
+        if (!Read(bytes, offset, size) || offset + size > bytes.size())
+            return false;
+
+        outValue.assign(reinterpret_cast<const char*>(bytes.data() + offset), size);
+        offset += size;
+        return true;
+    }
+}
+
+void PipelineCache::Load()
+{
+    Profiler::Marker _("PipelineCache::Load");
+
+    const std::filesystem::path path = PipelineCacheLocal::GetPath();
+    std::vector<uint8_t> bytes;
+    if (path.empty() || !FileSystem::FileExists(path) || !FileSystem::ReadFileBytes(path, bytes))
+        return;
+
+    size_t offset = 0;
+    uint32_t magic, version, entriesCount;
+    if (!PipelineCacheLocal::Read(bytes, offset, magic) || magic != PipelineCacheLocal::k_Magic ||
+        !PipelineCacheLocal::Read(bytes, offset, version) || version != PipelineCacheLocal::k_Version ||
+        !PipelineCacheLocal::Read(bytes, offset, entriesCount))
+    {
+        Debug::LogErrorFormat("[PipelineCache] Outdated or corrupted cache {}", path.string());
+        return;
+    }
+
+    std::lock_guard lock(s_EntriesMutex);
+
+    for (uint32_t i = 0; i < entriesCount; ++i)
+    {
+        Entry entry;
+        uint32_t keywordsCount, attributesCount;
+
+        bool valid = PipelineCacheLocal::ReadString(bytes, offset, entry.ShaderPath) && PipelineCacheLocal::Read(bytes, offset, keywordsCount);
+        for (uint32_t j = 0; valid && j < keywordsCount; ++j)
+            valid = PipelineCacheLocal::ReadString(bytes, offset, entry.Keywords.emplace_back());
+
+        valid = valid && PipelineCacheLocal::Read(bytes, offset, attributesCount);
+        for (uint32_t j = 0; valid && j < attributesCount; ++j)
+            valid = PipelineCacheLocal::Read(bytes, offset, entry.VertexAttributes.emplace_back());
+
+        if (!valid || !PipelineCacheLocal::Read(bytes, offset, entry.State))
+        {
+            Debug::LogErrorFormat("[PipelineCache] Corrupted cache {}", path.string());
+            return;
+        }
+
+        const size_t pipelineHash = Shader::GetPipelineHash(VertexAttributes::GetHash(entry.VertexAttributes), entry.State);
+        if (s_EntriesHashes.insert(GetEntryHash(entry.ShaderPath, entry.Keywords, pipelineHash)).second)
+            s_Entries.push_back(std::move(entry));
+    }
+}
+
+void PipelineCache::Save()
+{
+    Profiler::Marker _("PipelineCache::Save");
+
+    const std::filesystem::path path = PipelineCacheLocal::GetPath();
+    if (path.empty())
+        return;
+
+    std::vector<uint8_t> bytes;
+    {
+        std::lock_guard lock(s_EntriesMutex);
+        if (!s_Dirty)
+            return;
+
+        PipelineCacheLocal::Write(bytes, PipelineCacheLocal::k_Magic);
+        PipelineCacheLocal::Write(bytes, PipelineCacheLocal::k_Version);
+        PipelineCacheLocal::Write(bytes, static_cast<uint32_t>(s_Entries.size()));
+
+        for (const Entry& entry : s_Entries)
+        {
+            PipelineCacheLocal::WriteString(bytes, entry.ShaderPath);
+            PipelineCacheLocal::Write(bytes, static_cast<uint32_t>(entry.Keywords.size()));
+            for (const std::string& keyword : entry.Keywords)
+                PipelineCacheLocal::WriteString(bytes, keyword);
+
+            PipelineCacheLocal::Write(bytes, static_cast<uint32_t>(entry.VertexAttributes.size()));
+            for (const GraphicsBackendVertexAttributeDescriptor& attribute : entry.VertexAttributes)
+                PipelineCacheLocal::Write(bytes, attribute);
+
+            PipelineCacheLocal::Write(bytes, entry.State);
+        }
+
+        s_Dirty = false;
+    }
+
+    try
+    {
+        std::filesystem::create_directories(path.parent_path());
+        FileSystem::WriteFileBytes(path, bytes);
+    }
+    catch (const std::exception& exception)
+    {
+        Debug::LogErrorFormat("[PipelineCache] Can't save cache\n{}", exception.what());
+    }
+}
+
+void PipelineCache::Shutdown()
+{
+    std::shared_ptr<Worker::Task> prewarmTask;
+    {
+        std::lock_guard lock(s_PrewarmMutex);
+        prewarmTask = s_PrewarmTask;
+    }
+
+    if (prewarmTask)
+        prewarmTask->Wait();
+
+    Save();
+
+    std::lock_guard lock(s_PrewarmMutex);
+    s_PrewarmTask = nullptr;
+    s_PrewarmedShaders.clear();
+}
+
+std::shared_ptr<Worker::Task> PipelineCache::Prewarm()
+{
+    Profiler::Marker _("PipelineCache::Prewarm");
+
+    // programs are created per shader, so each shader is loaded only once
+    std::map<std::pair<std::string, std::vector<std::string>>, std::vector<Entry>> shaderEntries;
+    {
+        std::lock_guard lock(s_EntriesMutex);
+        for (size_t i = s_PrewarmedEntriesCount; i < s_Entries.size(); ++i)
+            shaderEntries[{s_Entries[i].ShaderPath, s_Entries[i].Keywords}].push_back(s_Entries[i]);
+        s_PrewarmedEntriesCount = s_Entries.size();
+    }
+
+    std::vector<std::shared_ptr<Worker::Task>> shaderTasks;
+    for (auto& pair : shaderEntries)
+    {
+        shaderTasks.push_back(Worker::CreateTask([key = pair.first, entries = std::move(pair.second)]
+        {
+            std::shared_ptr<Shader> shader = Shader::Load(key.first, key.second);
+            for (const Entry& entry : entries)
+                shader->Prewarm(entry.VertexAttributes, entry.State);
+
+            // shader is kept alive, so prewarmed programs are not destroyed before it is used
+            std::lock_guard lock(s_PrewarmMutex);
+            s_PrewarmedShaders.push_back(shader);
+        }, Worker::Priority::LOADING));
+    }
+
+    std::shared_ptr<Worker::Task> prewarmTask;
+    {
+        std::lock_guard lock(s_PrewarmMutex);
+
+        // programs of previous calls are kept alive by prewarmed shaders, so only new entries are left
+        if (shaderTasks.empty())
+            return s_PrewarmTask ? s_PrewarmTask : Worker::Noop();
+
+        const uint64_t generation = ++s_PrewarmGeneration;
+        prewarmTask = Worker::CreateTask([generation]
+        {
+            std::lock_guard lock(s_PrewarmMutex);
+            if (s_PrewarmGeneration == generation)
+                s_PrewarmTask = nullptr;
+        }, Worker::Priority::LOADING);
+
+        // task of the previous call can be still running, the new one finishes only after it, so waiting for the last task is enough
+        if (s_PrewarmTask)
+            prewarmTask->AddDependency(s_PrewarmTask);
+
+        s_PrewarmTask = prewarmTask;
+    }
+
+    // tasks are scheduled outside of the lock, because they can be executed in place
+    for (const std::shared_ptr<Worker::Task>& task : shaderTasks)
+    {
+        prewarmTask->AddDependency(task);
+        task->Schedule();
+    }
+    prewarmTask->Schedule();
+
+    return prewarmTask;
+}
+
+void PipelineCache::Record(const std::string& shaderPath, const std::vector<std::string>& keywords, size_t pipelineHash,
+                           const std::vector<GraphicsBackendVertexAttributeDescriptor>& vertexAttributes, const PipelineState& state)
+{
+    std::lock_guard lock(s_EntriesMutex);
+    if (!s_EntriesHashes.insert(GetEntryHash(shaderPath, keywords, pipelineHash)).second)
+        return;
+
+    s_Entries.push_back(Entry{shaderPath, keywords, vertexAttributes, state});
+    s_Dirty = true;
+}
+
+void PipelineCache::AddHit()
+{
+    s_Hits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PipelineCache::AddMiss(uint64_t compileTimeUs)
+{
+    s_Misses.fetch_add(1, std::memory_order_relaxed);
+    s_CompileTimeUs.fetch_add(compileTimeUs, std::memory_order_relaxed);
+}
+
+void PipelineCache::AddPrewarmed()
+{
+    s_PrewarmedPrograms.fetch_add(1, std::memory_order_relaxed);
+}
+
+PipelineCache::Stats PipelineCache::GetStats()
+{
+    Stats stats{};
+    stats.Hits = s_Hits.load(std::memory_order_relaxed);
+    stats.Misses = s_Misses.load(std::memory_order_relaxed);
+    stats.CompileTimeUs = s_CompileTimeUs.load(std::memory_order_relaxed);
+    stats.PrewarmedPrograms = s_PrewarmedPrograms.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void PipelineCache::ResetFrameStats()
+{
+    s_Hits.store(0, std::memory_order_relaxed);
+    s_Misses.store(0, std::memory_order_relaxed);
+    s_CompileTimeUs.store(0, std::memory_order_relaxed);
+}
+
+size_t PipelineCache::GetEntryHash(const std::string& shaderPath, const std::vector<std::string>& keywords, size_t pipelineHash)
+{
+    size_t hash = Hash::Combine(Hash::FNV1a(shaderPath), pipelineHash);
+    for (const std::string& keyword : keywords)
+        hash = Hash::Combine(hash, Hash::FNV1a(keyword));
+    return hash;
+}
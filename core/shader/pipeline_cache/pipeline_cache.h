@@ -0,0 +1,95 @@
+#ifndef RENDER_ENGINE_PIPELINE_CACHE_H
+#define RENDER_ENGINE_PIPELINE_CACHE_H
+
+#include "types/graphics_backend_vertex_attribute_descriptor.h"
+#include "types/graphics_backend_stencil_descriptor.h"
+#include "types/graphics_backend_depth_descriptor.h"
+#include "types/graphics_backend_rasterizer_descriptor.h"
+#include "types/graphics_backend_blend_descriptor.h"
+#include "enums/texture_internal_format.h"
+#include "enums/primitive_type.h"
+#include "worker/worker.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class Shader;
+
+// Records every render pipeline state programs were created for and stores them on disk,
+// so programs can be created on loading threads before they are first drawn
+class PipelineCache
+{
+public:
+    // full render state program is created for, except vertex attributes
+    struct PipelineState
+    {
+        TextureInternalFormat ColorTargetFormat;
+        bool IsLinear;
+        TextureInternalFormat DepthTargetFormat;
+        PrimitiveType PrimitiveType;
+        GraphicsBackendStencilDescriptor StencilDescriptor;
+        GraphicsBackendDepthDescriptor DepthDescriptor;
+        GraphicsBackendRasterizerDescriptor RasterizerDescriptor;
+        GraphicsBackendBlendDescriptor BlendDescriptor;
+    };
+
+    struct Stats
+    {
+        // hits, misses and compile time are counted for programs requested during current frame
+        uint64_t Hits;
+        uint64_t Misses;
+        uint64_t CompileTimeUs;
+        uint64_t PrewarmedPrograms;
+    };
+
+    static void Load();
+    static void Save();
+    static void Shutdown();
+
+    // creates programs on loading threads for recorded states that were not prewarmed by previous calls
+    static std::shared_ptr<Worker::Task> Prewarm();
+
+    static void Record(const std::string& shaderPath, const std::vector<std::string>& keywords, size_t pipelineHash,
+                       const std::vector<GraphicsBackendVertexAttributeDescriptor>& vertexAttributes, const PipelineState& state);
+
+    static void AddHit();
+    static void AddMiss(uint64_t compileTimeUs);
+    static void AddPrewarmed();
+
+    static Stats GetStats();
+    static void ResetFrameStats();
+
+private:
+    struct Entry
+    {
+        std::string ShaderPath;
+        std::vector<std::string> Keywords;
+        std::vector<GraphicsBackendVertexAttributeDescriptor> VertexAttributes;
+        PipelineState State;
+    };
+
+    static std::mutex s_EntriesMutex;
+    static std::vector<Entry> s_Entries;
+    static std::unordered_set<size_t> s_EntriesHashes;
+    static size_t s_PrewarmedEntriesCount;
+    static bool s_Dirty;
+
+    static std::mutex s_PrewarmMutex;
+    // last scheduled prewarm, reset when it is finished
+    static std::shared_ptr<Worker::Task> s_PrewarmTask;
+    static uint64_t s_PrewarmGeneration;
+    static std::vector<std::shared_ptr<Shader>> s_PrewarmedShaders;
+
+    static std::atomic<uint64_t> s_Hits;
+    static std::atomic<uint64_t> s_Misses;
+    static std::atomic<uint64_t> s_CompileTimeUs;
+    static std::atomic<uint64_t> s_PrewarmedPrograms;
+
+    static size_t GetEntryHash(const std::string& shaderPath, const std::vector<std::string>& keywords, size_t pipelineHash);
+};
+
+#endif //RENDER_ENGINE_PIPELINE_CACHE_H
@@ -12,35 +12,23 @@
 #include "drawable_geometry/drawable_geometry.h"
 
 #include <vector>
+#include <algorithm>
+#include <chrono>
+
+std::mutex Shader::s_LoadedShadersMutex;
+std::unordered_map<std::string, std::weak_ptr<Shader>> Shader::s_LoadedShaders;
 
 namespace ShaderLocal
 {
-    size_t GetPSOHash(size_t vertexAttributesHash, TextureInternalFormat colorTargetFormat, bool isLinear, TextureInternalFormat depthTargetFormat, PrimitiveType primitiveType,
-        const GraphicsBackendStencilDescriptor& stencilDescriptor,
-        const GraphicsBackendDepthDescriptor& depthDescriptor,
-        const GraphicsBackendRasterizerDescriptor& rasterizerDescriptor,
-        const GraphicsBackendBlendDescriptor& blendDescriptor)
+    std::string GetShaderKey(const std::filesystem::path& path, const std::vector<std::string>& sortedKeywords)
     {
-        size_t hash = 0;
-        if (GraphicsBackend::Current()->RequireRTFormatsForPSO())
+        std::string key = path.string();
+        for (const std::string& keyword : sortedKeywords)
         {
-            hash = Hash::Combine(hash, std::hash<TextureInternalFormat>{}(colorTargetFormat));
-            hash = Hash::Combine(hash, std::hash<TextureInternalFormat>{}(depthTargetFormat));
-            hash = Hash::Combine(hash, std::hash<bool>{}(isLinear));
+            key += ",";
+            key += keyword;
         }
-        if (GraphicsBackend::Current()->RequirePrimitiveTypeForPSO())
-			hash = Hash::Combine(hash, std::hash<PrimitiveType>{}(primitiveType));
-        if (GraphicsBackend::Current()->RequireStencilStateForPSO())
-			hash = Hash::Combine(hash, GraphicsBackendBase::GetStencilDescriptorHash(stencilDescriptor));
-        if (GraphicsBackend::Current()->RequireDepthStateForPSO())
-			hash = Hash::Combine(hash, GraphicsBackendBase::GetDepthDescriptorHash(depthDescriptor));
-        if (GraphicsBackend::Current()->RequireRasterizerStateForPSO())
-			hash = Hash::Combine(hash, GraphicsBackendBase::GetRasterizerDescriptorHash(rasterizerDescriptor));
-        if (GraphicsBackend::Current()->RequireBlendStateForPSO())
-			hash = Hash::Combine(hash, GraphicsBackendBase::GetBlendDescriptorHash(blendDescriptor));
-        if (GraphicsBackend::Current()->RequireVertexAttributesForPSO())
-			hash = Hash::Combine(hash, vertexAttributesHash);
-        return hash;
+        return key;
     }
 }
 
@@ -48,6 +36,21 @@ std::shared_ptr<Shader> Shader::Load(const std::filesystem::path& path, const st
 {
     Profiler::Marker _("Shader::Load", path.string());
 
+    std::vector<std::string> sortedKeywords = keywords;
+    std::sort(sortedKeywords.begin(), sortedKeywords.end());
+    const std::string key = ShaderLocal::GetShaderKey(path, sortedKeywords);
+
+    // shaders are shared, so programs created for one material or prewarmed by pipeline cache are reused by others
+    {
+        std::lock_guard lock(s_LoadedShadersMutex);
+        const auto it = s_LoadedShaders.find(key);
+        if (it != s_LoadedShaders.end())
+        {
+            if (std::shared_ptr<Shader> shader = it->second.lock())
+                return shader;
+        }
+    }
+
     auto shader = ShaderLoader::Load(path, keywords);
 
     if (!shader)
@@ -60,6 +63,15 @@ std::shared_ptr<Shader> Shader::Load(const std::filesystem::path& path, const st
         return fallback;
     }
 
+    shader->m_Path = path.string();
+    shader->m_Keywords = std::move(sortedKeywords);
+
+    std::lock_guard lock(s_LoadedShadersMutex);
+    std::weak_ptr<Shader>& loadedShader = s_LoadedShaders[key];
+    if (std::shared_ptr<Shader> concurrentlyLoadedShader = loadedShader.lock())
+        return concurrentlyLoadedShader;
+
+    loadedShader = shader;
     return shader;
 }
 
@@ -111,50 +123,116 @@ const GraphicsBackendProgram& Shader::GetProgram(const VertexAttributes& vertexA
     return GetOrCreateRenderProgram(vertexAttributes, primitiveType);
 }
 
+void Shader::Prewarm(const std::vector<GraphicsBackendVertexAttributeDescriptor>& vertexAttributes, const PipelineCache::PipelineState& state)
+{
+    if (m_Type == ProgramType::COMPUTE)
+        return;
+
+    const size_t hash = GetPipelineHash(VertexAttributes::GetHash(vertexAttributes), state);
+    {
+        std::shared_lock lock(m_ProgramsMutex);
+        if (m_Programs.contains(hash))
+            return;
+    }
+
+    CreateRenderProgram(hash, vertexAttributes, state);
+    PipelineCache::AddPrewarmed();
+}
+
+size_t Shader::GetPipelineHash(size_t vertexAttributesHash, const PipelineCache::PipelineState& state)
+{
+    size_t hash = 0;
+    if (GraphicsBackend::Current()->RequireRTFormatsForPSO())
+    {
+        hash = Hash::Combine(hash, std::hash<TextureInternalFormat>{}(state.ColorTargetFormat));
+        hash = Hash::Combine(hash, std::hash<TextureInternalFormat>{}(state.DepthTargetFormat));
+        hash = Hash::Combine(hash, std::hash<bool>{}(state.IsLinear));
+    }
+    if (GraphicsBackend::Current()->RequirePrimitiveTypeForPSO())
+        hash = Hash::Combine(hash, std::hash<PrimitiveType>{}(state.PrimitiveType));
+    if (GraphicsBackend::Current()->RequireStencilStateForPSO())
+        hash = Hash::Combine(hash, GraphicsBackendBase::GetStencilDescriptorHash(state.StencilDescriptor));
+    if (GraphicsBackend::Current()->RequireDepthStateForPSO())
+        hash = Hash::Combine(hash, GraphicsBackendBase::GetDepthDescriptorHash(state.DepthDescriptor));
+    if (GraphicsBackend::Current()->RequireRasterizerStateForPSO())
+        hash = Hash::Combine(hash, GraphicsBackendBase::GetRasterizerDescriptorHash(state.RasterizerDescriptor));
+    if (GraphicsBackend::Current()->RequireBlendStateForPSO())
+        hash = Hash::Combine(hash, GraphicsBackendBase::GetBlendDescriptorHash(state.BlendDescriptor));
+    if (GraphicsBackend::Current()->RequireVertexAttributesForPSO())
+        hash = Hash::Combine(hash, vertexAttributesHash);
+    return hash;
+}
+
 const GraphicsBackendProgram& Shader::GetOrCreateRenderProgram(const VertexAttributes& vertexAttributes, PrimitiveType primitiveType)
 {
-    bool isLinear;
-    const TextureInternalFormat colorTargetFormat = GraphicsBackend::Current()->GetRenderTargetFormat(FramebufferAttachment::COLOR_ATTACHMENT0, &isLinear);
-    const TextureInternalFormat depthTargetFormat = GraphicsBackend::Current()->GetRenderTargetFormat(FramebufferAttachment::DEPTH_STENCIL_ATTACHMENT, nullptr);
+    PipelineCache::PipelineState state{};
+    state.ColorTargetFormat = GraphicsBackend::Current()->GetRenderTargetFormat(FramebufferAttachment::COLOR_ATTACHMENT0, &state.IsLinear);
+    state.DepthTargetFormat = GraphicsBackend::Current()->GetRenderTargetFormat(FramebufferAttachment::DEPTH_STENCIL_ATTACHMENT, nullptr);
+    state.PrimitiveType = primitiveType;
+    state.StencilDescriptor = GraphicsBackend::Current()->GetStencilDescriptor();
+    state.DepthDescriptor = GraphicsBackend::Current()->GetDepthState();
+    state.RasterizerDescriptor = GraphicsBackend::Current()->GetRasterizerState();
+    state.BlendDescriptor = GraphicsBackend::Current()->GetBlendState();
+
+    const size_t hash = GetPipelineHash(vertexAttributes.GetHash(), state);
+    {
+        std::shared_lock lock(m_ProgramsMutex);
+        const auto it = m_Programs.find(hash);
+        if (it != m_Programs.end())
+        {
+            PipelineCache::AddHit();
+            return it->second;
+        }
+    }
 
-    const GraphicsBackendStencilDescriptor& stencilDescriptor = GraphicsBackend::Current()->GetStencilDescriptor();
-    const GraphicsBackendDepthDescriptor& depthDescriptor = GraphicsBackend::Current()->GetDepthState();
-    const GraphicsBackendRasterizerDescriptor& rasterizerDescriptor = GraphicsBackend::Current()->GetRasterizerState();
-    const GraphicsBackendBlendDescriptor& blendDescriptor = GraphicsBackend::Current()->GetBlendState();
+    const std::chrono::steady_clock::time_point compileBegin = std::chrono::steady_clock::now();
+    const GraphicsBackendProgram& program = CreateRenderProgram(hash, vertexAttributes.GetAttributes(), state);
+    const std::chrono::steady_clock::duration compileTime = std::chrono::steady_clock::now() - compileBegin;
+    PipelineCache::AddMiss(std::chrono::duration_cast<std::chrono::microseconds>(compileTime).count());
 
-    const size_t hash = ShaderLocal::GetPSOHash(vertexAttributes.GetHash(), colorTargetFormat, isLinear, depthTargetFormat, primitiveType, stencilDescriptor, depthDescriptor, rasterizerDescriptor, blendDescriptor);
+    return program;
+}
 
-    const auto it = m_Programs.find(hash);
-    if (it != m_Programs.end())
-        return it->second;
+const GraphicsBackendProgram& Shader::CreateRenderProgram(size_t hash, const std::vector<GraphicsBackendVertexAttributeDescriptor>& vertexAttributes, const PipelineCache::PipelineState& state)
+{
+    Profiler::Marker _("Shader::CreateRenderProgram", m_Name);
 
     GraphicsBackendColorAttachmentDescriptor colorAttachmentDescriptor{};
-    colorAttachmentDescriptor.Format = colorTargetFormat;
-    colorAttachmentDescriptor.BlendDescriptor = blendDescriptor;
-    colorAttachmentDescriptor.IsLinear = isLinear;
+    colorAttachmentDescriptor.Format = state.ColorTargetFormat;
+    colorAttachmentDescriptor.BlendDescriptor = state.BlendDescriptor;
+    colorAttachmentDescriptor.IsLinear = state.IsLinear;
 
     GraphicsBackendProgramDescriptor programDescriptor{};
     programDescriptor.Type = m_Type;
     programDescriptor.Shaders = &m_Shaders;
-    programDescriptor.VertexAttributes = &vertexAttributes.GetAttributes();
+    programDescriptor.VertexAttributes = &vertexAttributes;
     programDescriptor.Textures = &m_Textures;
     programDescriptor.Samplers = &m_Samplers;
     programDescriptor.Buffers = &m_Buffers;
     programDescriptor.Name = &m_Name;
     programDescriptor.ColorAttachmentDescriptor = colorAttachmentDescriptor;
-    programDescriptor.DepthFormat = depthTargetFormat;
-    programDescriptor.RasterizerDescriptor = rasterizerDescriptor;
-    programDescriptor.DepthDescriptor = depthDescriptor;
-    programDescriptor.StencilDescriptor = stencilDescriptor;
-    programDescriptor.PrimitiveType = primitiveType;
+    programDescriptor.DepthFormat = state.DepthTargetFormat;
+    programDescriptor.RasterizerDescriptor = state.RasterizerDescriptor;
+    programDescriptor.DepthDescriptor = state.DepthDescriptor;
+    programDescriptor.StencilDescriptor = state.StencilDescriptor;
+    programDescriptor.PrimitiveType = state.PrimitiveType;
 
     const GraphicsBackendProgram program = GraphicsBackend::Current()->CreateProgram(programDescriptor);
-    m_Programs[hash] = program;
-    return m_Programs[hash];
+
+    if (!m_Path.empty())
+        PipelineCache::Record(m_Path, m_Keywords, hash, vertexAttributes, state);
+
+    // the same program could be created concurrently by prewarming, then only one of them is kept
+    std::unique_lock lock(m_ProgramsMutex);
+    const auto [it, inserted] = m_Programs.try_emplace(hash, program);
+    if (!inserted)
+        GraphicsBackend::Current()->DeleteProgram(program);
+    return it->second;
 }
 
 const GraphicsBackendProgram& Shader::GetOrCreateComputeProgram()
 {
+    std::unique_lock lock(m_ProgramsMutex);
     if (!m_Programs.empty())
         return m_Programs.begin()->second;
 
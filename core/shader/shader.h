@@ -5,12 +5,16 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 #include "types/graphics_backend_program.h"
 #include "types/graphics_backend_shader_object.h"
 #include "enums/primitive_type.h"
 #include "drawable_geometry/vertex_attributes/vertex_attributes.h"
 #include "types/graphics_backend_program_descriptor.h"
+#include "pipeline_cache/pipeline_cache.h"
 
 struct GraphicsBackendTextureInfo;
 struct GraphicsBackendSamplerInfo;
@@ -40,6 +44,12 @@ public:
     const GraphicsBackendProgram& GetProgram(const std::shared_ptr<DrawableGeometry>& geometry);
     const GraphicsBackendProgram& GetProgram(const VertexAttributes& vertexAttributes, PrimitiveType primitiveType);
 
+    // creates program for the state before it is drawn, can be called from any thread
+    void Prewarm(const std::vector<GraphicsBackendVertexAttributeDescriptor>& vertexAttributes, const PipelineCache::PipelineState& state);
+
+    // only parts of the state required by current backend affect the hash
+    static size_t GetPipelineHash(size_t vertexAttributesHash, const PipelineCache::PipelineState& state);
+
     inline const std::unordered_map<std::string, GraphicsBackendTextureInfo> &GetTextures() const
     {
         return m_Textures;
@@ -63,6 +73,11 @@ public:
 private:
     std::vector<GraphicsBackendShaderObject> m_Shaders;
     std::unordered_map<size_t, GraphicsBackendProgram> m_Programs;
+    std::shared_mutex m_ProgramsMutex;
+
+    // path and sorted keywords shader was loaded with, empty if it is not recorded to pipeline cache
+    std::string m_Path;
+    std::vector<std::string> m_Keywords;
 
     ProgramType m_Type;
     std::string m_Name;
@@ -73,7 +88,11 @@ private:
     std::unordered_map<std::string, GraphicsBackendSamplerInfo> m_Samplers;
     std::unordered_map<std::string, std::shared_ptr<GraphicsBackendBufferInfo>> m_Buffers;
 
+    static std::mutex s_LoadedShadersMutex;
+    static std::unordered_map<std::string, std::weak_ptr<Shader>> s_LoadedShaders;
+
     const GraphicsBackendProgram& GetOrCreateRenderProgram(const VertexAttributes& vertexAttributes, PrimitiveType primitiveType);
+    const GraphicsBackendProgram& CreateRenderProgram(size_t hash, const std::vector<GraphicsBackendVertexAttributeDescriptor>& vertexAttributes, const PipelineCache::PipelineState& state);
     const GraphicsBackendProgram& GetOrCreateComputeProgram();
 };
 
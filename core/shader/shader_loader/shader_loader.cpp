@@ -7,9 +7,12 @@
 #include "types/graphics_backend_shader_object.h"
 #include "graphics_backend_api.h"
 #include "shader_parser.h"
+#include "shader/shader_package/shader_package.h"
 #include "hash.h"
 
+#include <mutex>
 #include <span>
+#include <unordered_map>
 
 namespace ShaderLoader
 {
@@ -32,7 +35,68 @@ namespace ShaderLoader
         }
     }
 
-    std::string GetKeywordsHash(std::vector<std::string> keywords, bool& outSupportInstancing)
+    std::filesystem::path GetBackendPath(const std::filesystem::path& path, const std::string& keywordHash)
+    {
+        const GraphicsBackendName backendName = GraphicsBackend::Current()->GetName();
+        if (backendName != GraphicsBackendName::NULL_BACKEND)
+            return FileSystem::GetResourcesPath() / path / GetBackendLiteral(backendName) / keywordHash;
+
+        // null backend does not compile shaders, so reflection of any compiled backend is enough
+        for (int i = static_cast<int>(GraphicsBackendName::OPENGL); i < static_cast<int>(GraphicsBackendName::NULL_BACKEND); ++i)
+        {
+            std::filesystem::path backendPath = FileSystem::GetResourcesPath() / path / GetBackendLiteral(static_cast<GraphicsBackendName>(i)) / keywordHash;
+            if (FileSystem::FileExists(backendPath / "reflection.json"))
+                return backendPath;
+        }
+
+        return FileSystem::GetResourcesPath() / path;
+    }
+
+    std::shared_ptr<ShaderPackage> MapPackage(const std::filesystem::path& path)
+    {
+        const GraphicsBackendName backendName = GraphicsBackend::Current()->GetName();
+        if (backendName != GraphicsBackendName::NULL_BACKEND)
+            return ShaderPackage::Load(FileSystem::GetResourcesPath() / path / GetBackendLiteral(backendName) / ShaderPackageFormat::Filename);
+
+        for (int i = static_cast<int>(GraphicsBackendName::OPENGL); i < static_cast<int>(GraphicsBackendName::NULL_BACKEND); ++i)
+        {
+            if (std::shared_ptr<ShaderPackage> package = ShaderPackage::Load(FileSystem::GetResourcesPath() / path / GetBackendLiteral(static_cast<GraphicsBackendName>(i)) / ShaderPackageFormat::Filename))
+                return package;
+        }
+
+        return nullptr;
+    }
+
+    std::mutex s_PackagesMutex;
+    // package is mapped once per shader and backend and shared by all its variants, nullptr if shader is not packaged
+    std::unordered_map<std::string, std::shared_ptr<ShaderPackage>> s_Packages;
+
+    std::shared_ptr<ShaderPackage> LoadPackage(const std::filesystem::path& path)
+    {
+        const std::string key = GetBackendLiteral(GraphicsBackend::Current()->GetName()) + ":" + path.string();
+
+        {
+            std::lock_guard lock(s_PackagesMutex);
+            const auto it = s_Packages.find(key);
+            if (it != s_Packages.end())
+                return it->second;
+        }
+
+        std::shared_ptr<ShaderPackage> package = MapPackage(path);
+
+        // package could be mapped by another thread meanwhile, first one is kept so variants share it
+        std::lock_guard lock(s_PackagesMutex);
+        return s_Packages.try_emplace(key, std::move(package)).first->second;
+    }
+
+    GraphicsBackendShaderObject CompileShader(ShaderType shaderType, std::span<const uint8_t> shaderData, const std::string& name)
+    {
+        if (GraphicsBackend::Current()->GetName() == GraphicsBackendName::DX12)
+            return GraphicsBackend::Current()->CompileShaderBinary(shaderType, std::vector<uint8_t>(shaderData.begin(), shaderData.end()), name);
+        return GraphicsBackend::Current()->CompileShader(shaderType, std::string(shaderData.begin(), shaderData.end()), name);
+    }
+
+    uint64_t GetKeywordsHash(std::vector<std::string> keywords, bool& outSupportInstancing)
     {
         outSupportInstancing = false;
 
@@ -44,18 +108,51 @@ namespace ShaderLoader
             outSupportInstancing |= keyword == INSTANCING_KEYWORD;
         }
 
-        return std::to_string(Hash::FNV1a(keywordsDirectives));
+        return Hash::FNV1a(keywordsDirectives);
     }
 
 	std::shared_ptr<Shader> Load(const std::filesystem::path& path, const std::vector<std::string>& keywords)
     {
         bool supportInstancing = false;
-        std::string keywordHash = GetKeywordsHash(keywords, supportInstancing);
+        const uint64_t keywordsHash = GetKeywordsHash(keywords, supportInstancing);
+        const std::string keywordHash = std::to_string(keywordsHash);
+
+        std::string shaderDebugName;
+        shaderDebugName.append(path.string());
+        shaderDebugName.append("_");
+        shaderDebugName.append(keywordHash);
 
         try
         {
-            std::string backendLiteral = GetBackendLiteral(GraphicsBackend::Current()->GetName());
-            std::filesystem::path backendPath = FileSystem::GetResourcesPath() / path / backendLiteral / keywordHash;
+            // all variants are stored in one mapped package, separate variant files are used only if shaders are not packaged
+            if (std::shared_ptr<ShaderPackage> package = LoadPackage(path))
+            {
+                const ShaderPackageFormat::Variant* variant = package->FindVariant(keywordsHash);
+                if (!variant)
+                    throw std::runtime_error("Variant " + keywordHash + " is not found in package");
+
+                std::unordered_map<std::string, GraphicsBackendTextureInfo> textures;
+                std::unordered_map<std::string, GraphicsBackendSamplerInfo> samplers;
+                std::unordered_map<std::string, std::shared_ptr<GraphicsBackendBufferInfo>> buffers;
+                ThreadGroupSize threadGroupSize;
+                package->GetReflection(*variant, textures, buffers, samplers, threadGroupSize);
+
+                std::vector<GraphicsBackendShaderObject> shaders;
+                for (int i = 0; i < static_cast<int>(ShaderType::COUNT); ++i)
+                {
+                    const ShaderType shaderType = static_cast<ShaderType>(i);
+                    const std::span<const uint8_t> shaderData = package->GetStage(*variant, shaderType);
+                    if (shaderData.empty())
+                        continue;
+
+                    const std::string shaderFunctionDebugName = shaderDebugName + "_" + GraphicsBackendBase::GetShaderTypeName(shaderType);
+                    shaders.push_back(CompileShader(shaderType, shaderData, shaderFunctionDebugName));
+                }
+
+                return std::make_shared<Shader>(shaders, textures, buffers, samplers, threadGroupSize, shaderDebugName, supportInstancing);
+            }
+
+            std::filesystem::path backendPath = GetBackendPath(path, keywordHash);
 
             auto reflectionJson = FileSystem::ReadFile(backendPath / "reflection.json");
             std::unordered_map<std::string, GraphicsBackendTextureInfo> textures;
@@ -64,11 +161,6 @@ namespace ShaderLoader
             ThreadGroupSize threadGroupSize;
             ShaderParser::ParseReflection(reflectionJson, textures, buffers, samplers, threadGroupSize);
 
-            std::string shaderDebugName;
-            shaderDebugName.append(path.string());
-            shaderDebugName.append("_");
-            shaderDebugName.append(keywordHash);
-
             std::vector<GraphicsBackendShaderObject> shaders;
             for (int i = 0; i < static_cast<int>(ShaderType::COUNT); ++i)
             {
@@ -3,6 +3,8 @@
 
 #include <filesystem>
 #include <string>
+#include <vector>
+#include <memory>
 
 class Shader;
 
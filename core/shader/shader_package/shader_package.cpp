@@ -0,0 +1,123 @@
+#include "shader_package.h"
+#include "file_system/file_system.h"
+#include "file_system/mapped_file.h"
+#include "debug.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+std::shared_ptr<ShaderPackage> ShaderPackage::Load(const std::filesystem::path& path)
+{
+    if (!FileSystem::FileExists(path))
+        return nullptr;
+
+    std::shared_ptr<MappedFile> file = FileSystem::MapFile(path);
+    if (!file)
+        return nullptr;
+
+    std::shared_ptr<ShaderPackage> package = std::make_shared<ShaderPackage>(std::move(file));
+    if (!package->IsValid())
+    {
+        Debug::LogErrorFormat("[ShaderPackage] Invalid shader package {}", path.string());
+        return nullptr;
+    }
+
+    return package;
+}
+
+ShaderPackage::ShaderPackage(std::shared_ptr<MappedFile> file) :
+    m_File(std::move(file)),
+    m_Data(m_File->GetData())
+{
+    if (m_Data.size() < sizeof(ShaderPackageFormat::Header))
+        return;
+
+    const ShaderPackageFormat::Header* header = reinterpret_cast<const ShaderPackageFormat::Header*>(m_Data.data());
+    if (header->Magic != ShaderPackageFormat::Magic || header->Version != ShaderPackageFormat::Version)
+        return;
+
+    const uint64_t variantsSize = static_cast<uint64_t>(header->VariantsCount) * sizeof(ShaderPackageFormat::Variant);
+    if (variantsSize > UINT32_MAX)
+        return;
+
+    m_Variants = GetTable<ShaderPackageFormat::Variant>({header->VariantsOffset, static_cast<uint32_t>(variantsSize)});
+}
+
+const ShaderPackageFormat::Variant* ShaderPackage::FindVariant(uint64_t keywordsHash) const
+{
+    const auto it = std::lower_bound(m_Variants.begin(), m_Variants.end(), keywordsHash, [](const ShaderPackageFormat::Variant& variant, uint64_t hash)
+    {
+        return variant.KeywordsHash < hash;
+    });
+
+    return it != m_Variants.end() && it->KeywordsHash == keywordsHash ? &*it : nullptr;
+}
+
+std::span<const uint8_t> ShaderPackage::GetStage(const ShaderPackageFormat::Variant& variant, ShaderType shaderType) const
+{
+    const uint32_t stage = static_cast<uint32_t>(shaderType);
+    if (stage >= ShaderPackageFormat::StagesCount)
+        return {};
+
+    return GetTable<uint8_t>(variant.Stages[stage]);
+}
+
+void ShaderPackage::GetReflection(const ShaderPackageFormat::Variant& variant,
+    std::unordered_map<std::string, GraphicsBackendTextureInfo>& textures,
+    std::unordered_map<std::string, std::shared_ptr<GraphicsBackendBufferInfo>>& buffers,
+    std::unordered_map<std::string, GraphicsBackendSamplerInfo>& samplers,
+    ThreadGroupSize& threadGroupSize) const
+{
+    for (const ShaderPackageFormat::Resource& resource : GetTable<ShaderPackageFormat::Resource>(variant.Resources))
+    {
+        std::string name = GetString(resource.Name);
+        switch (resource.Type)
+        {
+            case ShaderPackageFormat::ResourceType::TEXTURE:
+                textures[std::move(name)] = GraphicsBackendTextureInfo{resource.Binding, resource.ReadWrite != 0};
+                break;
+            case ShaderPackageFormat::ResourceType::SAMPLER:
+                samplers[std::move(name)] = GraphicsBackendSamplerInfo{resource.Binding};
+                break;
+            case ShaderPackageFormat::ResourceType::BUFFER:
+            {
+                std::unordered_map<std::string, int> variables;
+                for (const ShaderPackageFormat::Variable& variable : GetTable<ShaderPackageFormat::Variable>(resource.Variables))
+                    variables[GetString(variable.Name)] = static_cast<int>(variable.Offset);
+
+                buffers[std::move(name)] = std::make_shared<GraphicsBackendBufferInfo>(resource.Binding, resource.Size, static_cast<BufferType>(resource.BufferType), resource.ReadWrite != 0, std::move(variables));
+                break;
+            }
+        }
+    }
+
+    threadGroupSize.X = variant.ThreadGroupSize[0];
+    threadGroupSize.Y = variant.ThreadGroupSize[1];
+    threadGroupSize.Z = variant.ThreadGroupSize[2];
+}
+
+bool ShaderPackage::IsValid() const
+{
+    if (m_Data.size() < sizeof(ShaderPackageFormat::Header))
+        return false;
+
+    const ShaderPackageFormat::Header* header = reinterpret_cast<const ShaderPackageFormat::Header*>(m_Data.data());
+    return header->Magic == ShaderPackageFormat::Magic && header->Version == ShaderPackageFormat::Version && m_Variants.size() == header->VariantsCount;
+}
+
+template<typename T>
+std::span<const T> ShaderPackage::GetTable(const ShaderPackageFormat::Range& range) const
+{
+    // offset and size are validated, so corrupted package can't be read out of bounds
+    const uint64_t end = static_cast<uint64_t>(range.Offset) + range.Size;
+    if (range.Size == 0 || end > m_Data.size() || range.Size % sizeof(T) != 0 || range.Offset % alignof(T) != 0)
+        return {};
+
+    return {reinterpret_cast<const T*>(m_Data.data() + range.Offset), range.Size / sizeof(T)};
+}
+
+std::string ShaderPackage::GetString(const ShaderPackageFormat::Range& range) const
+{
+    const std::span<const uint8_t> chars = GetTable<uint8_t>(range);
+    return {reinterpret_cast<const char*>(chars.data()), chars.size()};
+}
@@ -0,0 +1,48 @@
+#ifndef RENDER_ENGINE_SHADER_PACKAGE_H
+#define RENDER_ENGINE_SHADER_PACKAGE_H
+
+#include "shader_package_format.h"
+#include "types/graphics_backend_texture_info.h"
+#include "types/graphics_backend_buffer_info.h"
+#include "types/graphics_backend_sampler_info.h"
+#include "types/graphics_backend_program_descriptor.h"
+#include "enums/shader_type.h"
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+class MappedFile;
+
+// Memory mapped shader package, variants and their reflection are read in place
+class ShaderPackage
+{
+public:
+    // returns nullptr if package does not exist or is not valid
+    static std::shared_ptr<ShaderPackage> Load(const std::filesystem::path& path);
+
+    explicit ShaderPackage(std::shared_ptr<MappedFile> file);
+
+    const ShaderPackageFormat::Variant* FindVariant(uint64_t keywordsHash) const;
+    std::span<const uint8_t> GetStage(const ShaderPackageFormat::Variant& variant, ShaderType shaderType) const;
+    void GetReflection(const ShaderPackageFormat::Variant& variant,
+        std::unordered_map<std::string, GraphicsBackendTextureInfo>& textures,
+        std::unordered_map<std::string, std::shared_ptr<GraphicsBackendBufferInfo>>& buffers,
+        std::unordered_map<std::string, GraphicsBackendSamplerInfo>& samplers,
+        ThreadGroupSize& threadGroupSize) const;
+
+private:
+    std::shared_ptr<MappedFile> m_File;
+    std::span<const uint8_t> m_Data;
+    std::span<const ShaderPackageFormat::Variant> m_Variants;
+
+    bool IsValid() const;
+
+    template<typename T>
+    std::span<const T> GetTable(const ShaderPackageFormat::Range& range) const;
+    std::string GetString(const ShaderPackageFormat::Range& range) const;
+};
+
+#endif //RENDER_ENGINE_SHADER_PACKAGE_H
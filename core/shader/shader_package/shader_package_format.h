@@ -0,0 +1,69 @@
+#ifndef RENDER_ENGINE_SHADER_PACKAGE_FORMAT_H
+#define RENDER_ENGINE_SHADER_PACKAGE_FORMAT_H
+
+#include <cstdint>
+
+// Binary package with all compiled variants of one shader for one backend, written by shader compiler.
+// Offsets are in bytes from the start of the package, tables are 8 bytes aligned, so they can be read in place
+namespace ShaderPackageFormat
+{
+    constexpr uint32_t Magic = 0x474B5053; // SPKG
+    constexpr uint32_t Version = 1;
+    constexpr uint32_t Alignment = 8;
+    constexpr const char* Filename = "package.bin";
+
+    // must match ShaderType
+    constexpr uint32_t StagesCount = 3;
+
+    enum class ResourceType : uint32_t
+    {
+        TEXTURE,
+        SAMPLER,
+        BUFFER,
+    };
+
+    struct Range
+    {
+        uint32_t Offset;
+        uint32_t Size;
+    };
+
+    struct Header
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t VariantsCount;
+        uint32_t VariantsOffset;
+    };
+
+    // variants are sorted by keywords hash
+    struct Variant
+    {
+        uint64_t KeywordsHash;
+        // empty if stage is not present
+        Range Stages[StagesCount];
+        Range Resources;
+        uint32_t ThreadGroupSize[3];
+        uint32_t Padding;
+    };
+
+    struct Resource
+    {
+        Range Name;
+        ResourceType Type;
+        uint32_t Binding;
+        uint32_t ReadWrite;
+        // used only by buffers, BufferType value
+        uint32_t BufferType;
+        uint32_t Size;
+        Range Variables;
+    };
+
+    struct Variable
+    {
+        Range Name;
+        uint32_t Offset;
+    };
+}
+
+#endif //RENDER_ENGINE_SHADER_PACKAGE_FORMAT_H
@@ -2,20 +2,23 @@
 #include "graphics_backend_api.h"
 #include "editor/profiler/profiler.h"
 
-Texture::Texture(TextureType textureType, const GraphicsBackendTextureDescriptor& descriptor, const std::string& name) :
+#include <algorithm>
+
+Texture::Texture(TextureType textureType, const GraphicsBackendTextureDescriptor& descriptor, const std::string& name, uint32_t residentMip) :
         m_TextureDescriptor(descriptor),
 		m_TextureType(textureType),
 		m_SamplerName(name + "_Sampler"),
 		m_SamplerDescriptor({}),
 		m_SamplerDirty(true),
-		m_HasSampler(false)
+		m_HasSampler(false),
+		m_ResidentMip(residentMip)
 {
     Profiler::Marker _("Texture::Texture");
 
     m_SamplerDescriptor.WrapMode = TextureWrapMode::REPEAT;
     m_SamplerDescriptor.FilteringMode = descriptor.MipLevels > 1 ? TextureFilteringMode::LINEAR_MIPMAP_NEAREST : TextureFilteringMode::LINEAR;
     m_SamplerDescriptor.HasBorderColor = true;
-    m_Texture = GraphicsBackend::Current()->CreateTexture(m_TextureType, m_TextureDescriptor, name);
+    m_Texture = GraphicsBackend::Current()->CreateTexture(m_TextureType, GetResidentDescriptor(m_TextureDescriptor, m_ResidentMip), name);
 }
 
 Texture::~Texture()
@@ -27,36 +30,42 @@ Texture::~Texture()
 
 void Texture::SetMinMipLevel(int minMipLevel)
 {
+    std::lock_guard lock(m_SamplerMutex);
     m_SamplerDescriptor.MinLod = minMipLevel;
     m_SamplerDirty = true;
 }
 
 void Texture::SetWrapMode(TextureWrapMode wrapMode)
 {
+    std::lock_guard lock(m_SamplerMutex);
     m_SamplerDescriptor.WrapMode = wrapMode;
     m_SamplerDirty = true;
 }
 
 void Texture::SetBorderColor(const Vector4& color)
 {
+    std::lock_guard lock(m_SamplerMutex);
     memcpy(&m_SamplerDescriptor.BorderColor[0], &color, sizeof(Vector4));
     m_SamplerDirty = true;
 }
 
 void Texture::SetFilteringMode(TextureFilteringMode mode)
 {
+    std::lock_guard lock(m_SamplerMutex);
     m_SamplerDescriptor.FilteringMode = mode;
     m_SamplerDirty = true;
 }
 
 void Texture::SetComparisonFunction(ComparisonFunction function)
 {
+    std::lock_guard lock(m_SamplerMutex);
     m_SamplerDescriptor.ComparisonFunction = function;
     m_SamplerDirty = true;
 }
 
-const GraphicsBackendSampler& Texture::GetBackendSampler()
+GraphicsBackendSampler Texture::GetBackendSampler()
 {
+    std::lock_guard lock(m_SamplerMutex);
     if (m_SamplerDirty)
         RecreateSampler();
     return m_Sampler;
@@ -70,7 +79,23 @@ void Texture::UploadPixels(const void *pixels, int size, int depth, int mipLevel
     const unsigned int width = m_TextureDescriptor.Width / sizeMultiplier;
     const unsigned int height = m_TextureDescriptor.Height / sizeMultiplier;
 
-    GraphicsBackend::Current()->UploadImagePixels(GetBackendTexture(), mipLevel, cubemapFace, width, height, depth, size, pixels);
+    GraphicsBackend::Current()->UploadImagePixels(GetBackendTexture(), mipLevel - m_ResidentMip, cubemapFace, width, height, depth, size, pixels);
+}
+
+void Texture::SetResidentTexture(const GraphicsBackendTexture& texture, uint32_t residentMip)
+{
+    GraphicsBackend::Current()->DeleteTexture(m_Texture);
+    m_Texture = texture;
+    m_ResidentMip = residentMip;
+}
+
+GraphicsBackendTextureDescriptor Texture::GetResidentDescriptor(const GraphicsBackendTextureDescriptor& descriptor, uint32_t residentMip)
+{
+    GraphicsBackendTextureDescriptor residentDescriptor = descriptor;
+    residentDescriptor.Width = std::max(descriptor.Width >> residentMip, 1u);
+    residentDescriptor.Height = std::max(descriptor.Height >> residentMip, 1u);
+    residentDescriptor.MipLevels = descriptor.MipLevels - residentMip;
+    return residentDescriptor;
 }
 
 void Texture::RecreateSampler()
@@ -16,6 +16,8 @@
 #include "resources/resource.h"
 
 #include <string>
+#include <mutex>
+#include <atomic>
 
 class Texture : public Resource
 {
@@ -33,7 +35,7 @@ public:
         return m_Texture;
     }
 
-    const GraphicsBackendSampler& GetBackendSampler();
+    GraphicsBackendSampler GetBackendSampler();
 
     inline uint32_t GetWidth() const
     {
@@ -50,6 +52,12 @@ public:
         return m_TextureDescriptor.MipLevels;
     }
 
+    // number of mips present on GPU, less than mip levels if largest mips are not streamed in
+    inline uint32_t GetResidentMipLevels() const
+    {
+        return m_TextureDescriptor.MipLevels - m_ResidentMip;
+    }
+
     Texture(const Texture &) = delete;
     Texture(Texture &&) = delete;
 
@@ -57,12 +65,15 @@ public:
     Texture &operator=(Texture &&) = delete;
 
 protected:
-    Texture(TextureType textureType, const GraphicsBackendTextureDescriptor& descriptor, const std::string& name);
+    Texture(TextureType textureType, const GraphicsBackendTextureDescriptor& descriptor, const std::string& name, uint32_t residentMip = 0);
 
     void UploadPixels(const void *pixels, int size, int depth, int mipLevel, CubemapFace cubemapFace = CubemapFace::POSITIVE_X) const;
 
 private:
     void RecreateSampler();
+    void SetResidentTexture(const GraphicsBackendTexture& texture, uint32_t residentMip);
+
+    static GraphicsBackendTextureDescriptor GetResidentDescriptor(const GraphicsBackendTextureDescriptor& descriptor, uint32_t residentMip);
 
     GraphicsBackendTextureDescriptor m_TextureDescriptor;
     GraphicsBackendTexture m_Texture;
@@ -70,11 +81,19 @@ private:
     TextureType m_TextureType = TextureType::TEXTURE_2D;
     std::string m_SamplerName;
 
+    // sampler is recreated lazily in GetBackendSampler, which is called by render queues recorded in parallel on workers
+    std::mutex m_SamplerMutex;
     GraphicsBackendSamplerDescriptor m_SamplerDescriptor;
     bool m_SamplerDirty;
     bool m_HasSampler;
 
+    // backend texture of streamed texture contains only mips starting from resident mip, descriptor still describes the full texture
+    uint32_t m_ResidentMip = 0;
+    bool m_IsStreamed = false;
+    std::atomic<uint8_t> m_RequestedMip;
+
     friend class Resources;
+    friend class TextureStreamer;
     friend class Font;
 };
 
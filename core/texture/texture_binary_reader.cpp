@@ -1,46 +1,49 @@
 #include "texture_binary_reader.h"
 #include "file_system/file_system.h"
+#include "file_system/mapped_file.h"
+
+#include <cstring>
+
+static_assert(sizeof(TextureHeader) % alignof(TextureMipRange) == 0, "Mip ranges must be aligned in the texture file");
 
 bool TextureBinaryReader::ReadTexture(const std::filesystem::path &path)
 {
     static constexpr int headerSize = sizeof(TextureHeader);
 
-    m_TextureBinaryData.clear();
+    // file is mapped, so only pages of mips that are actually uploaded are read from disk
+    m_TextureFile = FileSystem::MapFile(FileSystem::GetResourcesPath() / path);
+    if (!m_TextureFile)
+        return false;
 
-    if (!FileSystem::ReadFileBytes(FileSystem::GetResourcesPath() / path, m_TextureBinaryData))
-    {
+    const std::span<const uint8_t> textureData = m_TextureFile->GetData();
+    if (textureData.size() < headerSize)
+        return false;
+
+    memcpy(&m_Header, textureData.data(), headerSize);
+    if (m_Header.Version != TextureHeader::CurrentVersion || m_Header.Depth == 0 || m_Header.MipCount == 0)
         return false;
-    }
 
-    m_Header = *reinterpret_cast<TextureHeader*>(m_TextureBinaryData.data());
+    const size_t rangesCount = m_Header.Depth * m_Header.MipCount;
+    if (headerSize + rangesCount * sizeof(TextureMipRange) > textureData.size())
+        return false;
 
-    auto *sizes = reinterpret_cast<uint32_t*>(&m_TextureBinaryData[0] + headerSize);
-    m_MipSizes = std::span<uint32_t>(sizes, m_Header.Depth * m_Header.MipCount);
+    const auto *ranges = reinterpret_cast<const TextureMipRange*>(textureData.data() + headerSize);
+    m_MipRanges = std::span<const TextureMipRange>(ranges, rangesCount);
 
-    uint32_t totalSize = GetMipsSize(m_Header.Depth - 1, m_Header.MipCount - 1);
-    auto *pixels = reinterpret_cast<uint8_t*>(&m_TextureBinaryData[0] + headerSize + m_MipSizes.size() * sizeof(uint32_t));
-    m_Pixels = std::span<uint8_t>(pixels, totalSize);
+    for (const TextureMipRange& range : m_MipRanges)
+    {
+        if (static_cast<uint64_t>(range.Offset) + range.Size > textureData.size())
+            return false;
+    }
 
     return true;
 }
 
-std::span<uint8_t> TextureBinaryReader::GetPixels(unsigned int slice, unsigned int mipLevel) const
+std::span<const uint8_t> TextureBinaryReader::GetPixels(unsigned int slice, unsigned int mipLevel) const
 {
     if (slice >= m_Header.Depth || mipLevel >= m_Header.MipCount)
         return {};
 
-    uint32_t mipSize = m_MipSizes[slice * m_Header.MipCount + mipLevel];
-    uint32_t mipOffset = slice == 0 && mipLevel == 0 ? 0 : GetMipsSize(slice, mipLevel - 1);
-
-    return {m_Pixels.data() + mipOffset, mipSize};
-}
-
-uint32_t TextureBinaryReader::GetMipsSize(unsigned int slices, unsigned int mipLevels) const
-{
-    uint32_t mipsSize = 0;
-    for (int i = 0; i <= slices * m_Header.MipCount + mipLevels; ++i)
-    {
-        mipsSize += m_MipSizes[i];
-    }
-    return mipsSize;
+    const TextureMipRange& range = m_MipRanges[slice * m_Header.MipCount + mipLevel];
+    return m_TextureFile->GetData().subspan(range.Offset, range.Size);
 }
@@ -4,10 +4,10 @@
 #include "texture_header.h"
 
 #include <filesystem>
-#include <vector>
+#include <memory>
 #include <span>
 
-struct TextureHeader;
+class MappedFile;
 
 class TextureBinaryReader
 {
@@ -15,7 +15,7 @@ public:
     TextureBinaryReader() = default;
 
     bool ReadTexture(const std::filesystem::path &path);
-    std::span<uint8_t> GetPixels(unsigned int slice, unsigned int mipLevel) const;
+    std::span<const uint8_t> GetPixels(unsigned int slice, unsigned int mipLevel) const;
 
     const TextureHeader &GetHeader() const
     {
@@ -23,12 +23,9 @@ public:
     }
 
 private:
-    std::vector<uint8_t> m_TextureBinaryData;
-    std::span<uint32_t> m_MipSizes;
-    std::span<uint8_t> m_Pixels;
+    std::shared_ptr<MappedFile> m_TextureFile;
+    std::span<const TextureMipRange> m_MipRanges;
     TextureHeader m_Header{};
-
-    uint32_t GetMipsSize(unsigned int slices, unsigned int mipLevels) const;
 };
 
 
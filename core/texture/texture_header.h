@@ -3,8 +3,13 @@
 
 #include "enums/texture_internal_format.h"
 
+#include <cstdint>
+
 struct TextureHeader
 {
+    static constexpr uint16_t CurrentVersion = 2;
+
+    uint16_t Version;
     uint16_t Width;
     uint16_t Height;
     uint16_t Depth;
@@ -13,4 +18,12 @@ struct TextureHeader
     uint8_t IsLinear : 1;
 };
 
-#endif
\ No newline at end of file
+// header is followed by a range for each slice and mip, indexed as slice * MipCount + mip.
+// pixels are stored from the smallest mip to the largest, so small mips can be read without touching the rest of the file
+struct TextureMipRange
+{
+    uint32_t Offset;
+    uint32_t Size;
+};
+
+#endif
@@ -1,7 +1,7 @@
 #include "texture_2d.h"
 
-Texture2D::Texture2D(const GraphicsBackendTextureDescriptor & descriptor, const std::string& name) :
-        Texture(TextureType::TEXTURE_2D, descriptor, name)
+Texture2D::Texture2D(const GraphicsBackendTextureDescriptor& descriptor, const std::string& name, uint32_t residentMip) :
+        Texture(TextureType::TEXTURE_2D, descriptor, name, residentMip)
 {
 }
 
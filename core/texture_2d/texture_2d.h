@@ -20,7 +20,7 @@ public:
     Texture2D &operator=(Texture2D &&) = delete;
 
 private:
-    Texture2D(const GraphicsBackendTextureDescriptor& descriptor, const std::string& name);
+    Texture2D(const GraphicsBackendTextureDescriptor& descriptor, const std::string& name, uint32_t residentMip = 0);
 
     friend class Resources;
 };
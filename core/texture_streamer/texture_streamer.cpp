@@ -0,0 +1,327 @@
+#include "texture_streamer.h"
+#include "texture/texture.h"
+#include "texture/texture_binary_reader.h"
+#include "enums/cubemap_face.h"
+#include "graphics_backend_api.h"
+#include "editor/profiler/profiler.h"
+#include "arguments.h"
+#include "debug.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <queue>
+
+std::mutex TextureStreamer::s_AddedEntriesMutex;
+std::vector<TextureStreamer::Entry> TextureStreamer::s_AddedEntries;
+std::vector<TextureStreamer::Entry> TextureStreamer::s_Entries;
+
+bool TextureStreamer::s_Enabled = false;
+uint64_t TextureStreamer::s_BudgetBytes = 256 * 1024 * 1024;
+uint64_t TextureStreamer::s_Frame = 0;
+TextureStreamer::Stats TextureStreamer::s_Stats{};
+
+namespace TextureStreamerLocal
+{
+    constexpr uint8_t k_NotRequested = 0xFF;
+    // mips not larger than this are always resident
+    constexpr uint32_t k_BaseMipSize = 64;
+    // texture is reduced to base mip if it was not requested for this number of frames
+    constexpr uint64_t k_UnusedFrames = 120;
+    // loads are limited, so they don't occupy all loading threads
+    constexpr uint32_t k_MaxPendingLoads = 4;
+}
+
+void TextureStreamer::Init()
+{
+    s_Enabled = !Arguments::Contains("-no_texture_streaming");
+    if (Arguments::Contains("-texture_streaming_budget"))
+    {
+        const std::string budget = Arguments::Get("-texture_streaming_budget");
+
+        uint64_t budgetMegabytes;
+        const std::from_chars_result result = std::from_chars(budget.data(), budget.data() + budget.size(), budgetMegabytes);
+        if (result.ec == std::errc() && result.ptr == budget.data() + budget.size())
+            s_BudgetBytes = budgetMegabytes * 1024 * 1024;
+        else
+            Debug::LogErrorFormat("[TextureStreamer] Invalid budget {}, default {} MB is used", budget, s_BudgetBytes / (1024 * 1024));
+    }
+}
+
+void TextureStreamer::Shutdown()
+{
+    std::lock_guard lock(s_AddedEntriesMutex);
+
+    for (Entry& entry : s_Entries)
+    {
+        if (entry.UpdateTask)
+        {
+            entry.UpdateTask->Wait();
+            GraphicsBackend::Current()->DeleteTexture(entry.Update->Texture);
+        }
+    }
+
+    s_Entries.clear();
+    s_AddedEntries.clear();
+}
+
+void TextureStreamer::SetBudget(uint64_t bytes)
+{
+    s_BudgetBytes = bytes;
+}
+
+uint32_t TextureStreamer::GetBaseMip(const GraphicsBackendTextureDescriptor& descriptor)
+{
+    if (!s_Enabled)
+        return 0;
+
+    uint32_t mip = 0;
+    while (mip + 1 < descriptor.MipLevels && std::max(descriptor.Width >> mip, descriptor.Height >> mip) > TextureStreamerLocal::k_BaseMipSize)
+        ++mip;
+    return mip;
+}
+
+void TextureStreamer::Add(const std::shared_ptr<Texture>& texture, int facesCount, const std::shared_ptr<TextureBinaryReader>& reader, const std::string& name)
+{
+    const uint32_t mipLevels = texture->GetMipLevels();
+
+    Entry entry{};
+    entry.Texture = texture;
+    entry.Reader = reader;
+    entry.Name = name;
+    entry.Type = texture->m_TextureType;
+    entry.Descriptor = texture->m_TextureDescriptor;
+    entry.FacesCount = facesCount;
+    entry.BaseMip = texture->m_ResidentMip;
+    entry.ResidentMip = texture->m_ResidentMip;
+    entry.RequestedMip = texture->m_ResidentMip;
+    entry.TargetMip = texture->m_ResidentMip;
+
+    entry.MipsBytes.assign(mipLevels + 1, 0);
+    for (uint32_t mip = mipLevels; mip-- > 0;)
+    {
+        entry.MipsBytes[mip] = entry.MipsBytes[mip + 1];
+        for (int face = 0; face < facesCount; ++face)
+            entry.MipsBytes[mip] += reader->GetPixels(face, mip).size();
+    }
+
+    // texture is not visible to other threads yet, so its streaming state is set without synchronization
+    texture->m_IsStreamed = true;
+    texture->m_RequestedMip = TextureStreamerLocal::k_NotRequested;
+
+    std::lock_guard lock(s_AddedEntriesMutex);
+    s_AddedEntries.push_back(std::move(entry));
+}
+
+void TextureStreamer::RequestScreenSize(Texture& texture, float screenSize)
+{
+    if (!texture.m_IsStreamed)
+        return;
+
+    // one texel per pixel is enough, when texture covers the whole renderer
+    const float textureSize = static_cast<float>(std::max(texture.GetWidth(), texture.GetHeight()));
+    const float mip = std::log2(textureSize / std::max(screenSize, 1.0f));
+    RequestMip(texture, mip > 0 ? static_cast<uint32_t>(mip) : 0);
+}
+
+void TextureStreamer::RequestMip(Texture& texture, uint32_t mip)
+{
+    if (!texture.m_IsStreamed)
+        return;
+
+    // the most detailed mip requested during frame is kept
+    const uint8_t requestedMip = static_cast<uint8_t>(std::min<uint32_t>(mip, TextureStreamerLocal::k_NotRequested - 1));
+    uint8_t currentMip = texture.m_RequestedMip.load(std::memory_order_relaxed);
+    while (requestedMip < currentMip && !texture.m_RequestedMip.compare_exchange_weak(currentMip, requestedMip, std::memory_order_relaxed))
+    {
+    }
+}
+
+void TextureStreamer::Update()
+{
+    if (!s_Enabled)
+        return;
+
+    Profiler::Marker _("TextureStreamer::Update");
+
+    ++s_Frame;
+    s_Stats.LoadedMips = 0;
+    s_Stats.EvictedMips = 0;
+
+    {
+        std::lock_guard lock(s_AddedEntriesMutex);
+        for (Entry& entry : s_AddedEntries)
+        {
+            entry.LastRequestFrame = s_Frame;
+            s_Entries.push_back(std::move(entry));
+        }
+        s_AddedEntries.clear();
+    }
+
+    ApplyUpdates();
+    FitIntoBudget();
+    ScheduleUpdates();
+}
+
+TextureStreamer::Stats TextureStreamer::GetStats()
+{
+    Stats stats = s_Stats;
+    stats.BudgetBytes = s_BudgetBytes;
+    return stats;
+}
+
+void TextureStreamer::ApplyUpdates()
+{
+    for (Entry& entry : s_Entries)
+    {
+        const std::shared_ptr<Texture> texture = entry.Texture.lock();
+
+        // graphics prepare is finished, so backend texture can be replaced, old one is deleted only after frames using it are finished
+        if (entry.UpdateTask && entry.UpdateTask->IsFinished)
+        {
+            const uint32_t residentMip = entry.Update->ResidentMip;
+            if (texture)
+            {
+                if (residentMip < entry.ResidentMip)
+                    s_Stats.LoadedMips += entry.ResidentMip - residentMip;
+                else
+                    s_Stats.EvictedMips += residentMip - entry.ResidentMip;
+
+                texture->SetResidentTexture(entry.Update->Texture, residentMip);
+                entry.ResidentMip = residentMip;
+            }
+            else
+                GraphicsBackend::Current()->DeleteTexture(entry.Update->Texture);
+
+            entry.Update = nullptr;
+            entry.UpdateTask = nullptr;
+        }
+
+        if (!texture)
+            continue;
+
+        const uint8_t requestedMip = texture->m_RequestedMip.exchange(TextureStreamerLocal::k_NotRequested, std::memory_order_relaxed);
+        if (requestedMip != TextureStreamerLocal::k_NotRequested)
+        {
+            entry.RequestedMip = std::min<uint32_t>(requestedMip, entry.BaseMip);
+            entry.LastRequestFrame = s_Frame;
+        }
+        else if (s_Frame - entry.LastRequestFrame > TextureStreamerLocal::k_UnusedFrames)
+            entry.RequestedMip = entry.BaseMip;
+    }
+
+    // entries of destroyed textures are kept until their updates are finished
+    std::erase_if(s_Entries, [](const Entry& entry){ return !entry.UpdateTask && entry.Texture.expired(); });
+}
+
+void TextureStreamer::FitIntoBudget()
+{
+    uint64_t bytes = 0;
+    for (Entry& entry : s_Entries)
+    {
+        entry.TargetMip = entry.Texture.expired() ? entry.BaseMip : entry.RequestedMip;
+        bytes += entry.MipsBytes[entry.TargetMip];
+    }
+
+    s_Stats.RequestedBytes = bytes;
+    if (bytes <= s_BudgetBytes)
+        return;
+
+    Profiler::Marker _("TextureStreamer::FitIntoBudget");
+
+    auto GetTopMipBytes = [](const Entry* entry)
+    {
+        return entry->MipsBytes[entry->TargetMip] - entry->MipsBytes[entry->TargetMip + 1];
+    };
+
+    // largest mips of textures that were not requested for the longest time are dropped first
+    auto IsLowerPriority = [&GetTopMipBytes](const Entry* a, const Entry* b)
+    {
+        if (a->LastRequestFrame != b->LastRequestFrame)
+            return a->LastRequestFrame > b->LastRequestFrame;
+        return GetTopMipBytes(a) < GetTopMipBytes(b);
+    };
+
+    std::priority_queue<Entry*, std::vector<Entry*>, decltype(IsLowerPriority)> candidates(IsLowerPriority);
+    for (Entry& entry : s_Entries)
+    {
+        if (entry.TargetMip < entry.BaseMip)
+            candidates.push(&entry);
+    }
+
+    while (bytes > s_BudgetBytes && !candidates.empty())
+    {
+        Entry* entry = candidates.top();
+        candidates.pop();
+
+        bytes -= GetTopMipBytes(entry);
+        ++entry->TargetMip;
+
+        if (entry->TargetMip < entry->BaseMip)
+            candidates.push(entry);
+    }
+}
+
+void TextureStreamer::ScheduleUpdates()
+{
+    uint32_t pendingLoads = 0;
+    for (const Entry& entry : s_Entries)
+    {
+        if (entry.UpdateTask && entry.Update->ResidentMip < entry.ResidentMip)
+            ++pendingLoads;
+    }
+
+    uint64_t residentBytes = 0;
+    uint64_t pendingUpdates = 0;
+    for (Entry& entry : s_Entries)
+    {
+        residentBytes += entry.MipsBytes[entry.ResidentMip];
+
+        // evictions are always scheduled, so memory is freed as soon as possible
+        const bool canUpdate = !entry.UpdateTask && !entry.Texture.expired() && entry.TargetMip != entry.ResidentMip;
+        const bool isLoad = entry.TargetMip < entry.ResidentMip;
+        if (canUpdate && (!isLoad || pendingLoads < TextureStreamerLocal::k_MaxPendingLoads))
+        {
+            ScheduleUpdate(entry);
+            pendingLoads += isLoad ? 1 : 0;
+        }
+
+        pendingUpdates += entry.UpdateTask ? 1 : 0;
+    }
+
+    s_Stats.ResidentBytes = residentBytes;
+    s_Stats.StreamedTextures = s_Entries.size();
+    s_Stats.PendingUpdates = pendingUpdates;
+}
+
+void TextureStreamer::ScheduleUpdate(Entry& entry)
+{
+    const std::shared_ptr<PendingUpdate> update = std::make_shared<PendingUpdate>();
+    update->ResidentMip = entry.TargetMip;
+
+    auto UpdateTexture = [update, reader = entry.Reader, type = entry.Type, descriptor = entry.Descriptor, facesCount = entry.FacesCount, name = entry.Name]()
+    {
+        Profiler::Marker _("TextureStreamer::UpdateTexture", name);
+
+        const uint32_t residentMip = update->ResidentMip;
+        update->Texture = GraphicsBackend::Current()->CreateTexture(type, Texture::GetResidentDescriptor(descriptor, residentMip), name);
+
+        // smallest mips are placed first in the file, so it is read sequentially
+        for (uint32_t mip = descriptor.MipLevels; mip-- > residentMip;)
+        {
+            const int width = static_cast<int>(std::max(descriptor.Width >> mip, 1u));
+            const int height = static_cast<int>(std::max(descriptor.Height >> mip, 1u));
+
+            for (int face = 0; face < facesCount; ++face)
+            {
+                const std::span<const uint8_t> pixels = reader->GetPixels(face, mip);
+                GraphicsBackend::Current()->UploadImagePixels(update->Texture, static_cast<int>(mip - residentMip), static_cast<CubemapFace>(face),
+                                                              width, height, 0, static_cast<int>(pixels.size()), pixels.data());
+            }
+        }
+    };
+
+    entry.Update = update;
+    entry.UpdateTask = Worker::CreateTask(UpdateTexture, Worker::Priority::LOADING);
+    entry.UpdateTask->Schedule();
+}
@@ -0,0 +1,96 @@
+#ifndef RENDER_ENGINE_TEXTURE_STREAMER_H
+#define RENDER_ENGINE_TEXTURE_STREAMER_H
+
+#include "enums/texture_type.h"
+#include "types/graphics_backend_texture.h"
+#include "types/graphics_backend_texture_descriptor.h"
+#include "worker/worker.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Texture;
+class TextureBinaryReader;
+
+// Keeps on GPU only mips of streamed textures that are required by visible renderers, while staying within memory budget.
+// Required mips are requested during render queues prepare, textures are recreated with new set of mips on loading threads
+class TextureStreamer
+{
+public:
+    struct Stats
+    {
+        uint64_t BudgetBytes;
+        uint64_t ResidentBytes;
+        // size of all requested mips, more than resident size if they don't fit into budget
+        uint64_t RequestedBytes;
+        uint64_t StreamedTextures;
+        uint64_t PendingUpdates;
+        // loaded and evicted mips are counted for updates applied during current frame
+        uint64_t LoadedMips;
+        uint64_t EvictedMips;
+    };
+
+    static void Init();
+    static void Shutdown();
+
+    static void SetBudget(uint64_t bytes);
+
+    // mip that is uploaded when texture is loaded, 0 if texture is not streamed
+    static uint32_t GetBaseMip(const GraphicsBackendTextureDescriptor& descriptor);
+    static void Add(const std::shared_ptr<Texture>& texture, int facesCount, const std::shared_ptr<TextureBinaryReader>& reader, const std::string& name);
+
+    // can be called from any thread during prepare, screen size is in pixels
+    static void RequestScreenSize(Texture& texture, float screenSize);
+    static void RequestMip(Texture& texture, uint32_t mip);
+
+    // applies finished updates and schedules new ones, must be called on the main thread when graphics prepare is finished
+    static void Update();
+
+    static Stats GetStats();
+
+private:
+    // texture with new set of mips, filled on loading thread
+    struct PendingUpdate
+    {
+        GraphicsBackendTexture Texture;
+        uint32_t ResidentMip;
+    };
+
+    struct Entry
+    {
+        std::weak_ptr<Texture> Texture;
+        std::shared_ptr<TextureBinaryReader> Reader;
+        std::string Name;
+        TextureType Type;
+        GraphicsBackendTextureDescriptor Descriptor;
+        int FacesCount;
+        uint32_t BaseMip;
+        uint32_t ResidentMip;
+        uint32_t RequestedMip;
+        uint32_t TargetMip;
+        uint64_t LastRequestFrame;
+        // size of all mips starting from index
+        std::vector<uint64_t> MipsBytes;
+        std::shared_ptr<PendingUpdate> Update;
+        std::shared_ptr<Worker::Task> UpdateTask;
+    };
+
+    static std::mutex s_AddedEntriesMutex;
+    static std::vector<Entry> s_AddedEntries;
+    static std::vector<Entry> s_Entries;
+
+    static bool s_Enabled;
+    static uint64_t s_BudgetBytes;
+    static uint64_t s_Frame;
+    static Stats s_Stats;
+
+    static void ApplyUpdates();
+    static void FitIntoBudget();
+    static void ScheduleUpdates();
+    static void ScheduleUpdate(Entry& entry);
+};
+
+#endif //RENDER_ENGINE_TEXTURE_STREAMER_H
@@ -4,6 +4,7 @@
 #include "ui/ui_image.h"
 #include "ui/ui_text.h"
 #include "graphics_buffer/ring_buffer.h"
+#include "graphics_buffer/graphics_buffer.h"
 #include "vector4/vector4.h"
 #include "graphics/graphics.h"
 #include "graphics_backend_api.h"
@@ -15,9 +16,18 @@
 #include "editor/profiler/profiler.h"
 #include "graphics/render_data.h"
 #include "types/graphics_backend_render_target_descriptor.h"
+#include "math_utils.h"
+
+#include <cstring>
 
 namespace UIRenderPass_Local
 {
+    struct UIData
+    {
+        Vector4 OffsetScale;
+        Vector4 Color;
+    };
+
     Vector4 GetOffsetScale(Vector2 position, Vector2 size)
     {
         const Vector2& referenceSize = UIManager::GetReferenceSize();
@@ -36,6 +46,7 @@ UIRenderPass::UIRenderPass() :
     bufferDescriptor.AllowCPUWrites = true;
     bufferDescriptor.Size = 1024;
     m_UIDataBuffer = std::make_shared<RingBuffer>(bufferDescriptor, "UI Data");
+    m_QuadMesh = Mesh::GetQuadMesh();
 }
 
 void UIRenderPass::Prepare(RenderData& renderData)
@@ -60,121 +71,141 @@ void UIRenderPass::Prepare(RenderData& renderData)
         Vector2 size = Vector2(offsetScale.z * width, offsetScale.w * height);
         Gizmos::DrawRect(position, position + size);
     }
-}
 
-void UIRenderPass::Execute(const RenderData& renderData)
-{
-    Profiler::Marker cpuMarker("UIRenderPass::Execute");
+    m_CommandList.Clear();
+    m_RecordedMeshes.clear();
+    m_RecordedTextures.clear();
 
-    struct UIData
+    const std::vector<UIElement*> elements = UIManager::GetElements();
+    const int dataStride = Math::Align(static_cast<int>(sizeof(UIRenderPass_Local::UIData)), GraphicsBackend::Current()->GetConstantBufferOffsetAlignment());
+    m_UIData.assign(elements.size() * dataStride, 0);
+    m_UIDataOffset = m_UIData.empty() ? 0 : m_UIDataBuffer->Allocate(m_UIData.size());
+    m_UIDataBlock = m_UIDataBuffer->GetBuffer();
+
+    size_t dataCount = 0;
+    auto bindData = [this, dataStride, &dataCount](const void* data, int size)
     {
-        Vector4 OffsetScale;
-        Vector4 Color;
+        const size_t offset = dataCount++ * dataStride;
+        memcpy(m_UIData.data() + offset, data, size);
+        m_CommandList.BindConstantBuffer(m_UIDataBlock->GetBackendBuffer(), 0, static_cast<int>(m_UIDataOffset + offset), size);
     };
 
-    const std::shared_ptr<Mesh> quadMesh = Mesh::GetQuadMesh();
+    uint8_t maskStencilDepth = 0;
 
-    const GraphicsBackendRenderTargetDescriptor colorDescriptor{ .Attachment = FramebufferAttachment::COLOR_ATTACHMENT0, .Texture = renderData.PostProcessedTarget->GetBackendTexture(), .LoadAction = LoadAction::LOAD };
-    const GraphicsBackendRenderTargetDescriptor depthDescriptor{ .Attachment = FramebufferAttachment::DEPTH_STENCIL_ATTACHMENT, .Texture = renderData.CameraDepthTarget->GetBackendTexture(), .LoadAction = LoadAction::CLEAR };
-
-    GraphicsBackend::Current()->AttachRenderTarget(colorDescriptor);
-    GraphicsBackend::Current()->AttachRenderTarget(depthDescriptor);
-
-    GraphicsBackend::Current()->BeginRenderPass("UI Pass");
+    for (UIElement* element : elements)
     {
-        Profiler::GPUMarker gpuMarker("UIRenderPass::Execute");
+        if (const UIImage* image = dynamic_cast<UIImage*>(element))
+        {
+            UIRenderPass_Local::UIData data;
+            data.OffsetScale = UIRenderPass_Local::GetOffsetScale(image->GetGlobalPosition(), image->Size);
+            data.Color = image->Color;
+            bindData(&data, sizeof(data));
+
+            m_CommandList.BindTextureSampler(image->Image->GetBackendTexture(), image->Image->GetBackendSampler(), 0);
+            m_RecordedTextures.push_back(image->Image);
+
+            m_CommandList.SetBlendState(GraphicsBackendBlendDescriptor::AlphaBlending());
+            m_CommandList.SetRasterizerState(GraphicsBackendRasterizerDescriptor::NoCull());
+            m_CommandList.SetDepthState(GraphicsBackendDepthDescriptor::AlwaysPassNoWrite());
+            m_CommandList.UseShader(m_ImageShader.get(), &m_QuadMesh->GetVertexAttributes(), m_QuadMesh->GetPrimitiveType());
+            m_CommandList.DrawElements(m_QuadMesh->GetGraphicsBackendGeometry(), m_QuadMesh->GetPrimitiveType(), m_QuadMesh->GetElementsCount(), m_QuadMesh->GetIndicesDataType());
+        }
 
-        uint8_t maskStencilDepth = 0;
+        if (const UIText* text = dynamic_cast<UIText*>(element))
+        {
+            const std::shared_ptr<Mesh> textMesh = text->GetMesh();
+            const std::shared_ptr<Texture> fontAtlas = text->GetFontAtlas();
+            if (!textMesh || !fontAtlas)
+                continue;
+
+            UIRenderPass_Local::UIData data;
+            data.OffsetScale = UIRenderPass_Local::GetOffsetScale(text->GetGlobalPosition(), Vector2(1, 1));
+            data.Color = text->Color;
+            bindData(&data, sizeof(data));
+
+            m_CommandList.BindTextureSampler(fontAtlas->GetBackendTexture(), fontAtlas->GetBackendSampler(), 0);
+
+            m_CommandList.SetBlendState(GraphicsBackendBlendDescriptor::AlphaBlending());
+            m_CommandList.SetRasterizerState(GraphicsBackendRasterizerDescriptor::NoCull());
+            m_CommandList.SetDepthState(GraphicsBackendDepthDescriptor::AlwaysPassNoWrite());
+            m_CommandList.UseShader(m_TextShader.get(), &textMesh->GetVertexAttributes(), textMesh->GetPrimitiveType());
+            m_CommandList.DrawElements(textMesh->GetGraphicsBackendGeometry(), textMesh->GetPrimitiveType(), textMesh->GetElementsCount(), textMesh->GetIndicesDataType());
+
+            m_RecordedMeshes.push_back(textMesh);
+            m_RecordedTextures.push_back(fontAtlas);
+        }
 
-        for (UIElement* element : UIManager::GetElements())
+        if (const UIMaskStencil* maskStencil = dynamic_cast<UIMaskStencil*>(element))
         {
-            if (const UIImage* image = dynamic_cast<UIImage*>(element))
-            {
-                UIData data;
-                data.OffsetScale = UIRenderPass_Local::GetOffsetScale(image->GetGlobalPosition(), image->Size);
-                data.Color = image->Color;
-                const uint64_t offset = m_UIDataBuffer->SetData(&data, 0, sizeof(data));
-
-                GraphicsBackend::Current()->BindConstantBuffer(m_UIDataBuffer->GetBackendBuffer(), 0, offset, sizeof(data));
-                GraphicsBackend::Current()->BindTextureSampler(image->Image->GetBackendTexture(), image->Image->GetBackendSampler(), 0);
-
-                GraphicsBackend::Current()->SetBlendState(GraphicsBackendBlendDescriptor::AlphaBlending());
-                GraphicsBackend::Current()->SetRasterizerState(GraphicsBackendRasterizerDescriptor::NoCull());
-                GraphicsBackend::Current()->SetDepthState(GraphicsBackendDepthDescriptor::AlwaysPassNoWrite());
-                GraphicsBackend::Current()->UseProgram(m_ImageShader->GetProgram(quadMesh));
-                GraphicsBackend::Current()->DrawElements(quadMesh->GetGraphicsBackendGeometry(), quadMesh->GetPrimitiveType(), quadMesh->GetElementsCount(), quadMesh->GetIndicesDataType());
-            }
+            Vector2 position = maskStencil->GetGlobalPosition();
+            Vector2 size = maskStencil->Size;
 
-            if (const UIText* text = dynamic_cast<UIText*>(element))
+            if (!maskStencil->Open)
             {
-                const std::shared_ptr<Mesh> textMesh = text->GetMesh();
-                const std::shared_ptr<Texture> fontAtlas = text->GetFontAtlas();
-                if (!textMesh || !fontAtlas)
-                    continue;
-
-                UIData data;
-                data.OffsetScale = UIRenderPass_Local::GetOffsetScale(text->GetGlobalPosition(), Vector2(1, 1));
-                data.Color = text->Color;
-                const uint64_t offset = m_UIDataBuffer->SetData(&data, 0, sizeof(data));
-
-                GraphicsBackend::Current()->BindConstantBuffer(m_UIDataBuffer->GetBackendBuffer(), 0, offset, sizeof(data));
-                GraphicsBackend::Current()->BindTextureSampler(fontAtlas->GetBackendTexture(), fontAtlas->GetBackendSampler(), 0);
-
-                GraphicsBackend::Current()->SetBlendState(GraphicsBackendBlendDescriptor::AlphaBlending());
-                GraphicsBackend::Current()->SetRasterizerState(GraphicsBackendRasterizerDescriptor::NoCull());
-                GraphicsBackend::Current()->SetDepthState(GraphicsBackendDepthDescriptor::AlwaysPassNoWrite());
-                GraphicsBackend::Current()->UseProgram(m_TextShader->GetProgram(textMesh));
-                GraphicsBackend::Current()->DrawElements(textMesh->GetGraphicsBackendGeometry(), textMesh->GetPrimitiveType(), textMesh->GetElementsCount(), textMesh->GetIndicesDataType());
+                position.x += size.x;
+                size.x *= -1;
             }
 
-            if (const UIMaskStencil* maskStencil = dynamic_cast<UIMaskStencil*>(element))
-            {
-                Vector2 position = maskStencil->GetGlobalPosition();
-                Vector2 size = maskStencil->Size;
+            Vector4 offsetScale = UIRenderPass_Local::GetOffsetScale(position, size);
+            bindData(&offsetScale, sizeof(offsetScale));
 
-                if (!maskStencil->Open)
-                {
-                    position.x += size.x;
-                    size.x *= -1;
-                }
+            GraphicsBackendStencilDescriptor stencilDescriptor{};
+            stencilDescriptor.Enabled = true;
+            stencilDescriptor.FrontFaceOpDescriptor.ComparisonFunction = ComparisonFunction::ALWAYS;
+            stencilDescriptor.FrontFaceOpDescriptor.PassOp = StencilOperation::INCREMENT_SATURATE;
+            stencilDescriptor.BackFaceOpDescriptor.ComparisonFunction = ComparisonFunction::ALWAYS;
+            stencilDescriptor.BackFaceOpDescriptor.PassOp = StencilOperation::DECREMENT_SATURATE;
 
-                Vector4 offsetScale = UIRenderPass_Local::GetOffsetScale(position, size);
-                const uint64_t offset = m_UIDataBuffer->SetData(&offsetScale, 0, sizeof(offsetScale));
+            m_CommandList.SetStencilState(stencilDescriptor);
 
-                GraphicsBackend::Current()->BindConstantBuffer(m_UIDataBuffer->GetBackendBuffer(), 0, offset, sizeof(offsetScale));
+            m_CommandList.SetBlendState(GraphicsBackendBlendDescriptor::NoColorWrite());
+            m_CommandList.SetRasterizerState(GraphicsBackendRasterizerDescriptor::NoCull());
+            m_CommandList.SetDepthState(GraphicsBackendDepthDescriptor::AlwaysPassNoWrite());
+            m_CommandList.UseShader(m_MaskStencilShader.get(), &m_QuadMesh->GetVertexAttributes(), m_QuadMesh->GetPrimitiveType());
+            m_CommandList.DrawElements(m_QuadMesh->GetGraphicsBackendGeometry(), m_QuadMesh->GetPrimitiveType(), m_QuadMesh->GetElementsCount(), m_QuadMesh->GetIndicesDataType());
 
-                GraphicsBackendStencilDescriptor stencilDescriptor{};
+            if (maskStencil->Open)
+                ++maskStencilDepth;
+            else
+                --maskStencilDepth;
+
+            stencilDescriptor = {};
+            if (maskStencilDepth > 0)
+            {
                 stencilDescriptor.Enabled = true;
-                stencilDescriptor.FrontFaceOpDescriptor.ComparisonFunction = ComparisonFunction::ALWAYS;
-                stencilDescriptor.FrontFaceOpDescriptor.PassOp = StencilOperation::INCREMENT_SATURATE;
-                stencilDescriptor.BackFaceOpDescriptor.ComparisonFunction = ComparisonFunction::ALWAYS;
-                stencilDescriptor.BackFaceOpDescriptor.PassOp = StencilOperation::DECREMENT_SATURATE;
-
-                GraphicsBackend::Current()->SetStencilState(stencilDescriptor);
-
-                GraphicsBackend::Current()->SetBlendState(GraphicsBackendBlendDescriptor::NoColorWrite());
-                GraphicsBackend::Current()->SetRasterizerState(GraphicsBackendRasterizerDescriptor::NoCull());
-                GraphicsBackend::Current()->SetDepthState(GraphicsBackendDepthDescriptor::AlwaysPassNoWrite());
-                GraphicsBackend::Current()->UseProgram(m_MaskStencilShader->GetProgram(quadMesh));
-                GraphicsBackend::Current()->DrawElements(quadMesh->GetGraphicsBackendGeometry(), quadMesh->GetPrimitiveType(), quadMesh->GetElementsCount(), quadMesh->GetIndicesDataType());
-
-                if (maskStencil->Open)
-                    ++maskStencilDepth;
-                else
-                    --maskStencilDepth;
-
-                stencilDescriptor = {};
-                if (maskStencilDepth > 0)
-                {
-                    stencilDescriptor.Enabled = true;
-                    stencilDescriptor.FrontFaceOpDescriptor.ComparisonFunction = ComparisonFunction::EQUAL;
-                    GraphicsBackend::Current()->SetStencilValue(maskStencilDepth);
-                }
-
-                GraphicsBackend::Current()->SetStencilState(stencilDescriptor);
+                stencilDescriptor.FrontFaceOpDescriptor.ComparisonFunction = ComparisonFunction::EQUAL;
+                m_CommandList.SetStencilValue(maskStencilDepth);
             }
+
+            m_CommandList.SetStencilState(stencilDescriptor);
         }
     }
 
+    m_UIData.resize(dataCount * dataStride);
+}
+
+void UIRenderPass::Execute(const RenderData& renderData)
+{
+    Profiler::Marker cpuMarker("UIRenderPass::Execute");
+
+    if (!m_UIData.empty())
+        m_UIDataBlock->SetData(m_UIData.data(), m_UIDataOffset, m_UIData.size());
+
+    const GraphicsBackendRenderTargetDescriptor colorDescriptor{ .Attachment = FramebufferAttachment::COLOR_ATTACHMENT0, .Texture = renderData.PostProcessedTarget->GetBackendTexture(), .LoadAction = LoadAction::LOAD };
+    const GraphicsBackendRenderTargetDescriptor depthDescriptor{ .Attachment = FramebufferAttachment::DEPTH_STENCIL_ATTACHMENT, .Texture = renderData.CameraDepthTarget->GetBackendTexture(), .LoadAction = LoadAction::CLEAR };
+
+    GraphicsBackend::Current()->AttachRenderTarget(colorDescriptor);
+    GraphicsBackend::Current()->AttachRenderTarget(depthDescriptor);
+
+    GraphicsBackend::Current()->BeginRenderPass("UI Pass");
+    {
+        Profiler::GPUMarker gpuMarker("UIRenderPass::Execute");
+        m_CommandList.Execute();
+    }
+
     GraphicsBackend::Current()->EndRenderPass();
+
+    const RingBuffer::Stats& dataBufferStats = m_UIDataBuffer->GetStats();
+    Profiler::SetCounter("UIDataBuffer.HighWaterBytes", dataBufferStats.HighWaterBytes);
+    Profiler::SetCounter("UIDataBuffer.Blocks", dataBufferStats.BlocksCount);
 }
@@ -2,11 +2,17 @@
 #define RENDER_ENGINE_UI_RENDER_PASS_H
 
 #include "graphics/passes/render_pass.h"
+#include "graphics/command_list/command_list.h"
+
+#include <cstdint>
 #include <vector>
 
 class Shader;
 class RingBuffer;
 class UIElement;
+class Mesh;
+class Texture;
+class GraphicsBuffer;
 
 class UIRenderPass : public RenderPass
 {
@@ -22,6 +28,17 @@ private:
     std::shared_ptr<Shader> m_TextShader;
     std::shared_ptr<Shader> m_MaskStencilShader;
     std::shared_ptr<RingBuffer> m_UIDataBuffer;
+    // quad mesh is created lazily, so it is taken on the main thread and not during prepare
+    std::shared_ptr<Mesh> m_QuadMesh;
+
+    CommandList m_CommandList;
+    // data of all elements is recorded in prepare and uploaded at once on execute to the reserved part of the ring buffer
+    std::vector<uint8_t> m_UIData;
+    std::shared_ptr<GraphicsBuffer> m_UIDataBlock;
+    uint64_t m_UIDataOffset = 0;
+    // keep meshes and textures referenced by recorded commands alive until they are executed
+    std::vector<std::shared_ptr<Mesh>> m_RecordedMeshes;
+    std::vector<std::shared_ptr<Texture>> m_RecordedTextures;
 };
 
 #endif //RENDER_ENGINE_UI_RENDER_PASS_H
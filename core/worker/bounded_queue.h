@@ -0,0 +1,100 @@
+#ifndef RENDER_ENGINE_BOUNDED_QUEUE_H
+#define RENDER_ENGINE_BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Lock-free multi-producer multi-consumer queue with fixed capacity (power of two)
+template<typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t capacity) :
+        m_Cells(new Cell[capacity]),
+        m_Mask(capacity - 1),
+        m_EnqueuePosition(0),
+        m_DequeuePosition(0)
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~BoundedQueue()
+    {
+        delete[] m_Cells;
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue(BoundedQueue&&) = delete;
+
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(BoundedQueue&&) = delete;
+
+    bool TryPush(T* item)
+    {
+        Cell* cell;
+        size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &m_Cells[position & m_Mask];
+            const size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0)
+            {
+                if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+                return false;
+            else
+                position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+
+        cell->Item = item;
+        cell->Sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    T* TryPop()
+    {
+        Cell* cell;
+        size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &m_Cells[position & m_Mask];
+            const size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+            if (difference == 0)
+            {
+                if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+                return nullptr;
+            else
+                position = m_DequeuePosition.load(std::memory_order_relaxed);
+        }
+
+        T* item = cell->Item;
+        cell->Sequence.store(position + m_Mask + 1, std::memory_order_release);
+        return item;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> Sequence;
+        T* Item;
+    };
+
+    Cell* m_Cells;
+    size_t m_Mask;
+
+    alignas(64) std::atomic<size_t> m_EnqueuePosition;
+    alignas(64) std::atomic<size_t> m_DequeuePosition;
+};
+
+#endif //RENDER_ENGINE_BOUNDED_QUEUE_H
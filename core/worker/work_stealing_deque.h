@@ -0,0 +1,144 @@
+#ifndef RENDER_ENGINE_WORK_STEALING_DEQUE_H
+#define RENDER_ENGINE_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Chase-Lev deque. Push and Pop are allowed only from the owning thread, Steal - from any thread
+template<typename T>
+class WorkStealingDeque
+{
+public:
+    explicit WorkStealingDeque(int64_t capacity = 1024) :
+        m_Top(0),
+        m_Bottom(0),
+        m_Array(new Array(capacity))
+    {
+    }
+
+    ~WorkStealingDeque()
+    {
+        delete m_Array.load(std::memory_order_relaxed);
+        for (Array* array : m_RetiredArrays)
+            delete array;
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+    void Push(T* item)
+    {
+        const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_Top.load(std::memory_order_acquire);
+        Array* array = m_Array.load(std::memory_order_relaxed);
+
+        if (bottom - top > array->Capacity - 1)
+        {
+            // stealers may still read from the old array, so it is kept alive until the deque is destroyed
+            Array* newArray = array->Grow(bottom, top);
+            m_RetiredArrays.push_back(array);
+            m_Array.store(newArray, std::memory_order_release);
+            array = newArray;
+        }
+
+        array->Put(bottom, item);
+        m_Bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    T* Pop()
+    {
+        const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = m_Array.load(std::memory_order_relaxed);
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = array->Get(bottom);
+        if (top == bottom)
+        {
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    T* Steal()
+    {
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return nullptr;
+
+        Array* array = m_Array.load(std::memory_order_acquire);
+        T* item = array->Get(top);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return item;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Array
+    {
+        int64_t Capacity;
+        int64_t Mask;
+        std::atomic<T*>* Items;
+
+        explicit Array(int64_t capacity) :
+            Capacity(capacity),
+            Mask(capacity - 1),
+            Items(new std::atomic<T*>[capacity])
+        {
+        }
+
+        ~Array()
+        {
+            delete[] Items;
+        }
+
+        T* Get(int64_t index) const
+        {
+            return Items[index & Mask].load(std::memory_order_relaxed);
+        }
+
+        void Put(int64_t index, T* item)
+        {
+            Items[index & Mask].store(item, std::memory_order_relaxed);
+        }
+
+        Array* Grow(int64_t bottom, int64_t top) const
+        {
+            Array* array = new Array(Capacity * 2);
+            for (int64_t i = top; i < bottom; ++i)
+                array->Put(i, Get(i));
+            return array;
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> m_Top;
+    alignas(64) std::atomic<int64_t> m_Bottom;
+    alignas(64) std::atomic<Array*> m_Array;
+
+    std::vector<Array*> m_RetiredArrays;
+};
+
+#endif //RENDER_ENGINE_WORK_STEALING_DEQUE_H
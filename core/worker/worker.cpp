@@ -1,13 +1,69 @@
 #include "worker.h"
 #include "editor/profiler/profiler.h"
+#include "arguments.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if RENDER_ENGINE_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif RENDER_ENGINE_ANDROID || RENDER_ENGINE_LINUX
+#include <sched.h>
+#endif
+
+namespace WorkerLocal
+{
+    constexpr size_t k_InjectionQueueCapacity = 4096;
+    constexpr int k_SpinsBeforePark = 64;
+    constexpr int k_SpinsBeforeBlock = 16;
+    constexpr int k_MaxHelpSearchTasks = 64;
+    constexpr uint32_t k_AllPrioritiesMask = (1U << Worker::Priority::COUNT) - 1;
+
+    // arguments reserving workers which run only tasks of the given priority
+    const char* const k_ReservedWorkersArguments[Worker::Priority::COUNT] = {
+        "-task_workers",
+        "-loading_workers",
+    };
+
+    int32_t GetArgumentValue(const std::string& argument, int32_t defaultValue)
+    {
+        return Arguments::Contains(argument) ? std::atoi(Arguments::Get(argument).c_str()) : defaultValue;
+    }
+
+    void SetCurrentThreadAffinity(int32_t core)
+    {
+#if RENDER_ENGINE_WINDOWS
+        SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << (core % (sizeof(DWORD_PTR) * 8)));
+#elif RENDER_ENGINE_ANDROID || RENDER_ENGINE_LINUX
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(core, &cpuSet);
+        sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+#endif
+        // Apple platforms do not allow to pin threads to cores, affinity is ignored there
+    }
+}
 
-std::unordered_map<std::thread::id, int32_t> Worker::s_WorkerIds;
 std::vector<std::shared_ptr<Worker>> Worker::s_Workers;
-std::vector<std::shared_ptr<Worker::Task>> Worker::s_Tasks[Worker::Priority::COUNT];
-std::mutex Worker::s_TasksMutex;
+BoundedQueue<Worker::Task> Worker::s_InjectionQueues[Worker::Priority::COUNT] = {
+    BoundedQueue<Worker::Task>(WorkerLocal::k_InjectionQueueCapacity),
+    BoundedQueue<Worker::Task>(WorkerLocal::k_InjectionQueueCapacity),
+};
+std::mutex Worker::s_OverflowMutex;
+std::deque<Worker::Task*> Worker::s_OverflowQueues[Worker::Priority::COUNT];
+std::atomic<int32_t> Worker::s_OverflowCounts[Worker::Priority::COUNT] = {};
+std::atomic<uint32_t> Worker::s_WakeEpoch = 0;
+std::atomic<int32_t> Worker::s_SleepingWorkers = 0;
+std::atomic<int32_t> Worker::s_SleepingWorkersWithoutPriority[Worker::Priority::COUNT] = {};
+thread_local Worker* Worker::s_CurrentWorker = nullptr;
 
-Worker::Worker() :
-    m_Thread(&Worker::Run, this),
+Worker::Worker(int32_t id, uint32_t priorityMask, int32_t core) :
+    m_Id(id),
+    m_PriorityMask(priorityMask),
+    m_Core(core),
     m_Running(true)
 {
 }
@@ -21,21 +77,74 @@ Worker::~Worker()
 
 void Worker::Init()
 {
-    uint32_t cores = std::min(std::thread::hardware_concurrency() - 1, 6U);
-    for (int32_t i = 0; i < cores - 1; ++i)
+    // one hardware thread is left for the main thread
+    const int32_t hardwareThreads = static_cast<int32_t>(std::thread::hardware_concurrency());
+    const int32_t workersCount = std::max(WorkerLocal::GetArgumentValue("-workers", hardwareThreads - 1), 0);
+    const bool setAffinity = Arguments::Contains("-worker_affinity") && hardwareThreads > 0;
+
+    // at least one worker stays shared, so tasks of priorities without reserved workers are always picked up
+    int32_t reservedWorkers[Priority::COUNT];
+    int32_t reservedWorkersCount = 0;
+    uint32_t reservedMask = 0;
+    for (int prio = 0; prio < Priority::COUNT; ++prio)
     {
-        std::shared_ptr<Worker> worker = std::make_shared<Worker>();
-        s_Workers.push_back(worker);
-        s_WorkerIds[worker->m_Thread.get_id()] = i;
+        const int32_t available = std::max(workersCount - 1 - reservedWorkersCount, 0);
+        reservedWorkers[prio] = std::clamp(WorkerLocal::GetArgumentValue(WorkerLocal::k_ReservedWorkersArguments[prio], 0), 0, available);
+        reservedWorkersCount += reservedWorkers[prio];
+        if (reservedWorkers[prio] > 0)
+            reservedMask |= 1U << prio;
     }
+
+    const uint32_t sharedMask = reservedMask == WorkerLocal::k_AllPrioritiesMask ? WorkerLocal::k_AllPrioritiesMask : WorkerLocal::k_AllPrioritiesMask & ~reservedMask;
+    for (int32_t i = 0; i < workersCount; ++i)
+    {
+        uint32_t priorityMask = sharedMask;
+        for (int prio = 0, firstReserved = 0; prio < Priority::COUNT; firstReserved += reservedWorkers[prio], ++prio)
+        {
+            if (i >= firstReserved && i < firstReserved + reservedWorkers[prio])
+                priorityMask = 1U << prio;
+        }
+
+        // core 0 is left for the main thread
+        const int32_t core = setAffinity ? (i + 1) % hardwareThreads : -1;
+        s_Workers.push_back(std::make_shared<Worker>(i, priorityMask, core));
+    }
+
+    Profiler::SetWorkersCount(workersCount);
+
+    // threads are started only after all workers are created, because any of them can be a steal victim
+    for (const std::shared_ptr<Worker>& worker : s_Workers)
+        worker->m_Thread = std::thread(&Worker::Run, worker.get());
 }
 
 void Worker::Shutdown()
 {
+    for (const std::shared_ptr<Worker>& worker : s_Workers)
+        worker->m_Running = false;
+
+    s_WakeEpoch.fetch_add(1);
+    s_WakeEpoch.notify_all();
+
+    for (const std::shared_ptr<Worker>& worker : s_Workers)
     {
-        std::lock_guard<std::mutex> lock(s_TasksMutex);
-        for (int i = 0; i < Priority::COUNT; ++i)
-			s_Tasks[i] .clear();
+        if (worker->m_Thread.joinable())
+            worker->m_Thread.join();
+    }
+
+    // drop queued tasks, releasing references that keep them alive
+    for (int prio = 0; prio < Priority::COUNT; ++prio)
+    {
+        while (Task* task = s_InjectionQueues[prio].TryPop())
+            task->QueuedReference.reset();
+
+        while (Task* task = TryPopOverflow(static_cast<Priority>(prio)))
+            task->QueuedReference.reset();
+
+        for (const std::shared_ptr<Worker>& worker : s_Workers)
+        {
+            while (Task* task = worker->m_Deques[prio].Steal())
+                task->QueuedReference.reset();
+        }
     }
 
     s_Workers.clear();
@@ -54,61 +163,230 @@ std::shared_ptr<Worker::Task> Worker::Noop()
 {
     std::shared_ptr<Worker::Task> task = std::make_shared<Worker::Task>();
     task->IsFinished = true;
+    task->IsStarted = true;
+    task->Dependents = Task::GetClosedDependents();
     task->Priority = Priority::TASK;
     return task;
 }
 
 int32_t Worker::GetWorkerId()
 {
-    std::thread::id threadId = std::this_thread::get_id();
-    auto it = s_WorkerIds.find(threadId);
-    return it != s_WorkerIds.end() ? it->second : -1;
+    return s_CurrentWorker ? s_CurrentWorker->m_Id : -1;
+}
+
+int32_t Worker::GetWorkersCount()
+{
+    return static_cast<int32_t>(s_Workers.size());
 }
 
 void Worker::Run()
 {
+    s_CurrentWorker = this;
+
+    if (m_Core >= 0)
+        WorkerLocal::SetCurrentThreadAffinity(m_Core);
+
+    int spins = 0;
     while (m_Running)
     {
-        std::shared_ptr<Worker::Task> task;
+        if (Task* task = FindTask(this, m_PriorityMask))
+        {
+            RunTask(task);
+            spins = 0;
+        }
+        else if (++spins < WorkerLocal::k_SpinsBeforePark)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            Park(nullptr);
+            spins = 0;
+        }
+    }
+
+    s_CurrentWorker = nullptr;
+}
+
+void Worker::Park(const Task* awaitedTask)
+{
+    // epoch is read before the last check, so a task pushed or finished after the check changes it and wait returns immediately
+    const uint32_t epoch = s_WakeEpoch.load();
+    s_SleepingWorkers.fetch_add(1);
+    for (int prio = 0; prio < Priority::COUNT; ++prio)
+    {
+        if ((m_PriorityMask & (1U << prio)) == 0)
+            s_SleepingWorkersWithoutPriority[prio].fetch_add(1);
+    }
+
+    Task* task = FindTask(this, m_PriorityMask);
+    const bool awaitedFinished = awaitedTask && awaitedTask->IsFinished;
+    if (!task && !awaitedFinished && m_Running)
+        s_WakeEpoch.wait(epoch);
+
+    for (int prio = 0; prio < Priority::COUNT; ++prio)
+    {
+        if ((m_PriorityMask & (1U << prio)) == 0)
+            s_SleepingWorkersWithoutPriority[prio].fetch_sub(1);
+    }
+    s_SleepingWorkers.fetch_sub(1);
+
+    if (task)
+        RunTask(task);
+}
+
+Worker::Task* Worker::FindTask(Worker* worker, uint32_t priorityMask)
+{
+    const int32_t workersCount = static_cast<int32_t>(s_Workers.size());
+    const int32_t firstVictim = worker ? worker->m_Id + 1 : 0;
+
+    for (int prio = 0; prio < Priority::COUNT; ++prio)
+    {
+        if ((priorityMask & (1U << prio)) == 0)
+            continue;
+
+        if (worker)
         {
-            std::lock_guard<std::mutex> lock(s_TasksMutex);
-            for (int prio = 0; prio < Priority::COUNT; ++prio)
-            {
-                if (!s_Tasks[prio].empty())
-                {
-                    int taskIndex = -1;
-                    for (int i = 0; i < s_Tasks[prio].size(); ++i)
-                    {
-                        if (s_Tasks[prio][i]->DependenciesFinished())
-                        {
-                            taskIndex = i;
-                            break;
-                        }
-                    }
-
-                    if (taskIndex >= 0)
-                    {
-                        task = s_Tasks[prio][taskIndex];
-                        s_Tasks[prio].erase(s_Tasks[prio].begin() + taskIndex);
-                        break;
-                    }
-                }
-            }
+            if (Task* task = worker->m_Deques[prio].Pop())
+                return task;
         }
 
-        if (task)
+        if (Task* task = s_InjectionQueues[prio].TryPop())
+            return task;
+
+        if (Task* task = TryPopOverflow(static_cast<Priority>(prio)))
+            return task;
+
+        for (int32_t i = 0; i < workersCount; ++i)
+        {
+            const std::shared_ptr<Worker>& victim = s_Workers[(firstVictim + i) % workersCount];
+            if (victim.get() == worker)
+                continue;
+
+            if (Task* task = victim->m_Deques[prio].Steal())
+                return task;
+        }
+    }
+
+    return nullptr;
+}
+
+void Worker::Enqueue(const std::shared_ptr<Task>& task)
+{
+    if (s_Workers.empty())
+    {
+        task->QueuedReference.reset();
+        task->TryRun();
+        return;
+    }
+
+    Task* rawTask = task.get();
+    rawTask->QueuedReference = task;
+
+    if (s_CurrentWorker)
+    {
+        s_CurrentWorker->m_Deques[rawTask->Priority].Push(rawTask);
+    }
+    else if (!s_InjectionQueues[rawTask->Priority].TryPush(rawTask))
+    {
+        // queue is full, short task is ready anyway, so it is run in place, but loading would stall the pushing thread
+        if (rawTask->Priority == Priority::TASK)
         {
-            if (task->Func)
-				task->Func();
-            task->IsFinished = true;
+            RunTask(rawTask);
+            return;
         }
+
+        std::lock_guard lock(s_OverflowMutex);
+        s_OverflowQueues[rawTask->Priority].push_back(rawTask);
+        s_OverflowCounts[rawTask->Priority].fetch_add(1);
+    }
+
+    WakeWorker(rawTask->Priority);
+}
+
+Worker::Task* Worker::TryPopOverflow(Priority priority)
+{
+    // counter lets workers skip the lock while nothing has overflowed
+    if (s_OverflowCounts[priority].load() == 0)
+        return nullptr;
+
+    std::lock_guard lock(s_OverflowMutex);
+    if (s_OverflowQueues[priority].empty())
+        return nullptr;
+
+    Task* task = s_OverflowQueues[priority].front();
+    s_OverflowQueues[priority].pop_front();
+    s_OverflowCounts[priority].fetch_sub(1);
+    return task;
+}
+
+void Worker::RunTask(Task* task)
+{
+    const std::shared_ptr<Task> taskReference = std::move(task->QueuedReference);
+    taskReference->TryRun();
+}
+
+bool Worker::TryRunAnyTask()
+{
+    // threads outside of the pool help only with short tasks, loading could stall them for too long
+    Task* task = FindTask(s_CurrentWorker, s_CurrentWorker ? s_CurrentWorker->m_PriorityMask : 1U << Priority::TASK);
+    if (!task)
+        return false;
+
+    RunTask(task);
+    return true;
+}
+
+void Worker::Block(Task& task)
+{
+    task.Waiters.fetch_add(1);
+
+    // worker is woken up by new work as well, so it does not sleep while there is something to help with
+    if (s_CurrentWorker)
+        s_CurrentWorker->Park(&task);
+    else if (!task.IsFinished)
+        task.IsFinished.wait(false);
+
+    task.Waiters.fetch_sub(1);
+}
+
+void Worker::WakeWorker(Priority priority)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (s_SleepingWorkers.load() > 0)
+    {
+        // counter is incremented before the last queue check in Park, so a worker missed here sees the task itself
+        s_WakeEpoch.fetch_add(1);
+        if (s_SleepingWorkersWithoutPriority[priority].load() > 0)
+            s_WakeEpoch.notify_all();
+        else
+            s_WakeEpoch.notify_one();
+    }
+}
+
+Worker::Task::~Task()
+{
+    DependentNode* node = Dependents.load();
+    if (node == GetClosedDependents())
+        return;
+
+    while (node)
+    {
+        DependentNode* next = node->Next;
+        delete node;
+        node = next;
     }
 }
 
 void Worker::Task::Schedule()
 {
-    std::lock_guard<std::mutex> lock(s_TasksMutex);
-    s_Tasks[Priority].push_back(shared_from_this());
+    const std::shared_ptr<Task> task = shared_from_this();
+
+    // reference is set before dependencies can enqueue the task, Enqueue replaces it with the same one
+    IsScheduled = true;
+    QueuedReference = task;
+    if (PendingDependencies.fetch_sub(1) == 1)
+        Worker::Enqueue(task);
 }
 
 void Worker::Task::Execute()
@@ -116,35 +394,154 @@ void Worker::Task::Execute()
     if (IsFinished)
         return;
 
-    for (const std::shared_ptr<Worker::Task>& dep : Dependencies)
+    for (const std::shared_ptr<Worker::Task>& dep : GetDependencies())
         dep->Execute();
 
-    if (Func)
-        Func();
-
-    IsFinished = true;
+    // task could be already picked by a worker
+    if (!TryRun())
+        Wait();
 }
 
 void Worker::Task::Wait()
 {
+    if (IsFinished)
+        return;
+
     Profiler::Marker _("Worker::Task::Wait");
+
+    int idleSpins = 0;
     while (!IsFinished)
-        continue;
+    {
+        if (TryRunReadyDependency() || Worker::TryRunAnyTask())
+        {
+            idleSpins = 0;
+        }
+        else if (++idleSpins < WorkerLocal::k_SpinsBeforeBlock)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            Worker::Block(*this);
+            idleSpins = 0;
+        }
+    }
 }
 
 void Worker::Task::AddDependency(const std::shared_ptr<Task> &task)
 {
-    Dependencies.push_back(task);
+    {
+        std::lock_guard lock(DependenciesMutex);
+        Dependencies.push_back(task);
+    }
+
+    PendingDependencies.fetch_add(1);
+    if (!task->AddDependent(shared_from_this()))
+        PendingDependencies.fetch_sub(1);
 }
 
-bool Worker::Task::DependenciesFinished()
+bool Worker::Task::TryRun()
 {
-    for (const std::shared_ptr<Task>& dependency : Dependencies)
+    if (IsStarted.exchange(true))
+        return false;
+
+    if (Func)
+        Func();
+
+    Finish();
+    return true;
+}
+
+bool Worker::Task::TryRunReadyDependency()
+{
+    // depth-first search for queued but not started tasks from the awaited subtree
+    // references are held, because dependencies are released by tasks finishing during the search
+    std::shared_ptr<Task> stack[WorkerLocal::k_MaxHelpSearchTasks];
+    int stackSize = 0;
+    int visited = 0;
+
+    stack[stackSize++] = shared_from_this();
+    while (stackSize > 0 && visited < WorkerLocal::k_MaxHelpSearchTasks)
+    {
+        const std::shared_ptr<Task> task = std::move(stack[--stackSize]);
+        ++visited;
+
+        if (task->IsFinished || !task->IsScheduled)
+            continue;
+
+        if (task->PendingDependencies == 0 && task->TryRun())
+            return true;
+
+        std::lock_guard lock(task->DependenciesMutex);
+        for (const std::shared_ptr<Task>& dependency : task->Dependencies)
+        {
+            if (stackSize < WorkerLocal::k_MaxHelpSearchTasks && !dependency->IsFinished)
+                stack[stackSize++] = dependency;
+        }
+    }
+
+    return false;
+}
+
+void Worker::Task::Finish()
+{
+    IsFinished = true;
+
+    if (Waiters > 0)
     {
-        if (!dependency->IsFinished)
+        IsFinished.notify_all();
+        s_WakeEpoch.fetch_add(1);
+        s_WakeEpoch.notify_all();
+    }
+
+    DependentNode* node = Dependents.exchange(GetClosedDependents(), std::memory_order_acq_rel);
+    while (node)
+    {
+        DependentNode* next = node->Next;
+        if (const std::shared_ptr<Task> dependent = node->Dependent.lock())
+            dependent->OnDependencyFinished();
+        delete node;
+        node = next;
+    }
+
+    // finished dependencies are not needed anymore, they are released outside of the lock
+    std::vector<std::shared_ptr<Task>> dependencies;
+    {
+        std::lock_guard lock(DependenciesMutex);
+        dependencies.swap(Dependencies);
+    }
+}
+
+bool Worker::Task::AddDependent(const std::shared_ptr<Task>& task)
+{
+    DependentNode* node = new DependentNode{task, Dependents.load(std::memory_order_acquire)};
+    while (true)
+    {
+        if (node->Next == GetClosedDependents())
+        {
+            delete node;
             return false;
+        }
+
+        if (Dependents.compare_exchange_weak(node->Next, node, std::memory_order_release, std::memory_order_acquire))
+            return true;
     }
+}
 
-    Dependencies.clear();
-    return true;
+void Worker::Task::OnDependencyFinished()
+{
+    if (PendingDependencies.fetch_sub(1) == 1)
+        Worker::Enqueue(shared_from_this());
+}
+
+std::vector<std::shared_ptr<Worker::Task>> Worker::Task::GetDependencies()
+{
+    std::lock_guard lock(DependenciesMutex);
+    return Dependencies;
+}
+
+Worker::Task::DependentNode* Worker::Task::GetClosedDependents()
+{
+    static DependentNode closedDependents{};
+    return &closedDependents;
 }
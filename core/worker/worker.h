@@ -1,12 +1,17 @@
 #ifndef RENDER_ENGINE_WORKER_H
 #define RENDER_ENGINE_WORKER_H
 
+#include "work_stealing_deque.h"
+#include "bounded_queue.h"
+
 #include <thread>
 #include <mutex>
+#include <deque>
 #include <queue>
 #include <vector>
 #include <functional>
 #include <atomic>
+#include <memory>
 #include <unordered_map>
 
 class Worker
@@ -25,22 +30,52 @@ public:
     public:
         std::atomic<bool> IsFinished = false;
 
+        Task() = default;
+        ~Task();
+
         void Schedule();
         void Execute();
         void Wait();
         void AddDependency(const std::shared_ptr<Task>& task);
 
     private:
+        // dependent is held weakly, so dependency that is never scheduled does not keep it alive,
+        // scheduled dependent keeps itself alive through QueuedReference until it is queued
+        struct DependentNode
+        {
+            std::weak_ptr<Task> Dependent;
+            DependentNode* Next;
+        };
+
         std::function<void()> Func;
+        // released when task is finished, guarded because waiting threads traverse dependencies of other tasks
         std::vector<std::shared_ptr<Task>> Dependencies;
-        Priority Priority;
+        std::mutex DependenciesMutex;
+        Priority Priority = TASK;
+
+        // one extra dependency is held until Schedule, so task is never queued before it is scheduled
+        std::atomic<int32_t> PendingDependencies = 1;
+        std::atomic<DependentNode*> Dependents = nullptr;
+        std::atomic<bool> IsScheduled = false;
+        std::atomic<bool> IsStarted = false;
+        std::atomic<int32_t> Waiters = 0;
+
+        // keeps task alive while it is referenced only by raw pointer from the queues
+        std::shared_ptr<Task> QueuedReference;
 
-        bool DependenciesFinished();
+        bool TryRun();
+        bool TryRunReadyDependency();
+        std::vector<std::shared_ptr<Task>> GetDependencies();
+        void Finish();
+        bool AddDependent(const std::shared_ptr<Task>& task);
+        void OnDependencyFinished();
+
+        static DependentNode* GetClosedDependents();
 
         friend class Worker;
     };
 
-    Worker();
+    Worker(int32_t id, uint32_t priorityMask, int32_t core);
     ~Worker();
 
     static void Init();
@@ -50,17 +85,38 @@ public:
     static std::shared_ptr<Task> Noop();
 
     static int32_t GetWorkerId();
+    static int32_t GetWorkersCount();
 
 private:
-    static std::unordered_map<std::thread::id, int32_t> s_WorkerIds;
     static std::vector<std::shared_ptr<Worker>> s_Workers;
-    static std::vector<std::shared_ptr<Task>> s_Tasks[Priority::COUNT];
-    static std::mutex s_TasksMutex;
-
-    std::thread m_Thread;
+    static BoundedQueue<Task> s_InjectionQueues[Priority::COUNT];
+    // long tasks that didn't fit into full injection queue, they must not be run in place on the pushing thread
+    static std::mutex s_OverflowMutex;
+    static std::deque<Task*> s_OverflowQueues[Priority::COUNT];
+    static std::atomic<int32_t> s_OverflowCounts[Priority::COUNT];
+    static std::atomic<uint32_t> s_WakeEpoch;
+    static std::atomic<int32_t> s_SleepingWorkers;
+    // sleeping workers that do not run tasks of the priority, single wake up could land on one of them
+    static std::atomic<int32_t> s_SleepingWorkersWithoutPriority[Priority::COUNT];
+    static thread_local Worker* s_CurrentWorker;
+
+    int32_t m_Id;
+    uint32_t m_PriorityMask;
+    int32_t m_Core;
+    WorkStealingDeque<Task> m_Deques[Priority::COUNT];
     std::atomic<bool> m_Running;
+    std::thread m_Thread;
 
     void Run();
+    void Park(const Task* awaitedTask);
+
+    static Task* FindTask(Worker* worker, uint32_t priorityMask);
+    static Task* TryPopOverflow(Priority priority);
+    static void Enqueue(const std::shared_ptr<Task>& task);
+    static void RunTask(Task* task);
+    static bool TryRunAnyTask();
+    static void Block(Task& task);
+    static void WakeWorker(Priority priority);
 };
 
 #endif //RENDER_ENGINE_WORKER_H
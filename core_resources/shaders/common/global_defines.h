@@ -24,7 +24,7 @@
 #define POINTLIGHT_SHADOW_MAP           t7
 #define POINTLIGHT_SHADOW_MAP_SAMPLER   s7
 
-#define MATRICES_DATA   b4
+#define PER_DRAW_DATA   b4
 #define LIGHTING_DATA   b5
 #define CAMERA_DATA     b6
 #define SHADOW_DATA     b7
@@ -11,14 +11,21 @@ struct PerDrawDataStruct
 
 StructuredBuffer<PerDrawDataStruct> TransformMatricesBuffer : register(TRANSFORM_MATRICES_DATA);
 
+// Keep in-sync with core/graphics/data_structs/per_draw_data.h
+cbuffer PerDrawData : register(PER_DRAW_DATA)
+{
+    // matrices entry for single draws, offset of the first instance entry for instanced draws
+    uint _MatricesEntry;
+};
+
 #ifdef _INSTANCING
 
     static uint _InstanceID;
 
     Buffer<uint> InstanceMatricesEntriesBuffer : register(INSTANCING_MATRICES_ENTRIES_DATA);
     
-    #define _ModelMatrix            TransformMatricesBuffer[InstanceMatricesEntriesBuffer[_InstanceID]]._ModelMatrix
-    #define _ModelNormalMatrix      TransformMatricesBuffer[InstanceMatricesEntriesBuffer[_InstanceID]]._ModelNormalMatrix
+    #define _ModelMatrix            TransformMatricesBuffer[InstanceMatricesEntriesBuffer[_MatricesEntry + _InstanceID]]._ModelMatrix
+    #define _ModelNormalMatrix      TransformMatricesBuffer[InstanceMatricesEntriesBuffer[_MatricesEntry + _InstanceID]]._ModelNormalMatrix
 
     #define DECLARE_INSTANCE_ID_ATTRIBUTE() uint InstanceID : SV_InstanceID;
     #define DECLARE_INSTANCE_ID_VARYING(varID) nointerpolation uint InstanceID : TEXCOORD##varID;
@@ -28,8 +35,8 @@ StructuredBuffer<PerDrawDataStruct> TransformMatricesBuffer : register(TRANSFORM
 
 #else
 
-    #define _ModelMatrix            TransformMatricesBuffer[0]._ModelMatrix
-    #define _ModelNormalMatrix      TransformMatricesBuffer[0]._ModelNormalMatrix
+    #define _ModelMatrix            TransformMatricesBuffer[_MatricesEntry]._ModelMatrix
+    #define _ModelNormalMatrix      TransformMatricesBuffer[_MatricesEntry]._ModelNormalMatrix
 
     #define DECLARE_INSTANCE_ID_ATTRIBUTE()
     #define DECLARE_INSTANCE_ID_VARYING(varID)
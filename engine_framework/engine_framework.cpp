@@ -15,6 +15,8 @@
 #include "worker/worker.h"
 #include "ui/ui_manager.h"
 #include "developer_console/developer_console.h"
+#include "shader/pipeline_cache/pipeline_cache.h"
+#include "texture_streamer/texture_streamer.h"
 
 GameWindow* window = nullptr;
 
@@ -58,6 +60,8 @@ void EngineFramework::Initialize(void* fileSystemData, void* graphicsBackendInit
     window = new GameWindow();
 
     Graphics::Init();
+    PipelineCache::Load();
+    TextureStreamer::Init();
     Time::Init();
 
 #if RENDER_ENGINE_WINDOWS
@@ -138,7 +142,9 @@ void EngineFramework::Shutdown()
     delete window;
 
     Scene::Unload();
+    TextureStreamer::Shutdown();
     Resources::UnloadAllResources();
+    PipelineCache::Shutdown();
 
     Worker::Shutdown();
     ImGuiWrapper::Shutdown();
@@ -25,6 +25,8 @@ namespace TopMenuBarLocal
                 return "Metal";
             case GraphicsBackendName::DX12:
                 return "DX12";
+            case GraphicsBackendName::NULL_BACKEND:
+                return "Null";
         }
     }
 }
@@ -105,6 +105,18 @@ void ProfilerWindow::DrawTopBar()
         m_IsEnabled = !m_IsEnabled;
         Profiler::SetEnabled(m_IsEnabled);
     }
+
+    // current frame is still being recorded, so counters are shown for the previous one
+    const std::map<uint64_t, Profiler::FrameInfo>& mainThreadFrames = Profiler::GetContextFrames(Profiler::MarkerContext::MAIN_THREAD);
+    if (mainThreadFrames.size() < 2)
+        return;
+
+    const Profiler::FrameInfo& frameInfo = std::prev(mainThreadFrames.end(), 2)->second;
+    for (const auto& [name, value] : frameInfo.Counters)
+    {
+        ImGui::SameLine();
+        ImGui::Text("%s: %llu", name, static_cast<unsigned long long>(value));
+    }
 }
 
 void ProfilerWindow::DrawInternal()
@@ -122,7 +134,7 @@ void ProfilerWindow::DrawInternal()
 
     const double rangeToWidth = ImGui::GetWindowContentRegionMax().x / static_cast<double>(m_CurrentRange.count());
 
-    auto GetContextLabel = [](Profiler::MarkerContext context) -> const char*
+    auto GetContextLabel = [](Profiler::MarkerContext context) -> std::string
     {
         switch (context)
         {
@@ -132,22 +144,14 @@ void ProfilerWindow::DrawInternal()
                 return "GPU Render";
             case Profiler::MarkerContext::GPU_COPY:
                 return "GPU Copy";
-            case Profiler::MarkerContext::WORKER_1:
-                return "Worker 1";
-            case Profiler::MarkerContext::WORKER_2:
-                return "Worker 2";
-            case Profiler::MarkerContext::WORKER_3:
-                return "Worker 3";
-            case Profiler::MarkerContext::WORKER_4:
-                return "Worker 4";
-            case Profiler::MarkerContext::WORKER_5:
-                return "Worker 5";
+            default:
+                return "Worker " + std::to_string(static_cast<int>(context) - static_cast<int>(Profiler::MarkerContext::WORKER) + 1);
         }
     };
 
     DraggableContentRegion region("Content", rangeToWidth, 0, 0, this);
     {
-        for (int i = 0; i < static_cast<int>(Profiler::MarkerContext::MAX); ++i)
+        for (int i = 0; i < Profiler::GetContextCount(); ++i)
         {
             const Profiler::MarkerContext context = static_cast<Profiler::MarkerContext>(i);
             DrawMarkers(GetContextLabel(context), context, rangeBegin, rangeEnd, rangeToWidth);
@@ -196,7 +200,9 @@ void ProfilerWindow::AddOffset(int offset)
 
 void ProfilerWindow::DrawMarkers(const std::string& label, Profiler::MarkerContext context, const std::chrono::system_clock::time_point& rangeBegin, const std::chrono::system_clock::time_point& rangeEnd, double rangeToWidth)
 {
-    static int maxDepths[static_cast<int>(Profiler::MarkerContext::MAX)];
+    static std::vector<int> maxDepths;
+    if (maxDepths.size() < Profiler::GetContextCount())
+        maxDepths.resize(Profiler::GetContextCount(), 0);
 
     std::lock_guard<std::mutex> lock(Profiler::GetContextMutex(context));
     const std::map<uint64_t, Profiler::FrameInfo>& profilerFrames = Profiler::GetContextFrames(context);
@@ -7,6 +7,7 @@ enum class GraphicsBackendName
     GLES    = 1,
     METAL   = 2,
     DX12    = 3,
+    NULL_BACKEND = 4,
 };
 
 #endif //RENDER_ENGINE_BACKEND_TYPE_H
@@ -2,6 +2,7 @@
 #include "graphics_backend_api_opengl.h"
 #include "graphics_backend_api_metal.h"
 #include "graphics_backend_api_dx12.h"
+#include "graphics_backend_api_null.h"
 #include "enums/texture_internal_format.h"
 #include "enums/texture_type.h"
 #include "enums/framebuffer_attachment.h"
@@ -17,6 +18,7 @@
 #include "arguments.h"
 #include "hash.h"
 
+#include <bit>
 #include <functional>
 
 namespace BaseBackendLocal
@@ -45,6 +47,9 @@ GraphicsBackendBase *GraphicsBackendBase::Create()
     const bool dx12 = Arguments::Contains("-dx12");
     const bool metal = Arguments::Contains("-metal");
 
+    if (Arguments::Contains("-null"))
+        return new GraphicsBackendNull();
+
 #ifdef RENDER_BACKEND_OPENGL
 #if RENDER_ENGINE_WINDOWS
     if (openGL && !dx12)
@@ -62,7 +67,7 @@ GraphicsBackendBase *GraphicsBackendBase::Create()
     return new GraphicsBackendDX12();
 #endif
 
-    return nullptr;
+    return new GraphicsBackendNull();
 }
 
 void GraphicsBackendBase::Init(void* data)
@@ -73,6 +78,7 @@ void GraphicsBackendBase::Init(void* data)
 void GraphicsBackendBase::InitNewFrame()
 {
     m_DrawCallCount = 0;
+    m_BindingStats = {};
 
     BaseBackendLocal::DeleteResources<GraphicsBackendTexture>(m_DeletedTextures, [this](GraphicsBackendTexture& texture){ DeleteTexture_Internal(texture); });
     BaseBackendLocal::DeleteResources<GraphicsBackendSampler>(m_DeletedSamplers, [this](GraphicsBackendSampler& sampler){ DeleteSampler_Internal(sampler); });
@@ -99,13 +105,13 @@ void GraphicsBackendBase::DeleteTexture(const GraphicsBackendTexture& texture)
 
     m_DeletedTextures.emplace_back(texture, BaseBackendLocal::k_DeleteResourceDelay);
 
-    auto Predicate = [&texture](const std::pair<uint32_t, GraphicsBackendTexture>& pair)
+    auto Predicate = [&texture](const GraphicsBackendTexture& boundTexture)
     {
-        return pair.second.Texture == texture.Texture;
+        return boundTexture.Texture == texture.Texture;
     };
 
-    std::erase_if(m_BoundTextures, Predicate);
-    std::erase_if(m_BoundRWTextures, Predicate);
+    ClearBindings(m_BoundTextures, Predicate);
+    ClearBindings(m_BoundRWTextures, Predicate);
 }
 
 void GraphicsBackendBase::DeleteSampler(const GraphicsBackendSampler& sampler)
@@ -114,9 +120,9 @@ void GraphicsBackendBase::DeleteSampler(const GraphicsBackendSampler& sampler)
 
     m_DeletedSamplers.emplace_back(sampler, BaseBackendLocal::k_DeleteResourceDelay);
 
-    std::erase_if(m_BoundSamplers, [&sampler](const auto& pair)
+    ClearBindings(m_BoundSamplers, [&sampler](const GraphicsBackendSampler& boundSampler)
     {
-        return pair.second.Sampler == sampler.Sampler;
+        return boundSampler.Sampler == sampler.Sampler;
     });
 }
 
@@ -126,12 +132,10 @@ void GraphicsBackendBase::DeleteBuffer(const GraphicsBackendBuffer& buffer)
 
     m_DeletedBuffers.emplace_back(buffer, BaseBackendLocal::k_DeleteResourceDelay);
 
-    auto Predicate = [&buffer](const std::pair<uint32_t, BufferBindInfo>& pair)
+    ClearBindings(m_BoundConstantBuffers, [&buffer](const BufferBindInfo& info)
     {
-        return pair.second.Buffer.Buffer == buffer.Buffer;
-    };
-
-    std::erase_if(m_BoundConstantBuffers, Predicate);
+        return info.Buffer.Buffer == buffer.Buffer;
+    });
 }
 
 void GraphicsBackendBase::DeleteBufferView(const GraphicsBackendBufferView& bufferView)
@@ -140,13 +144,13 @@ void GraphicsBackendBase::DeleteBufferView(const GraphicsBackendBufferView& buff
 
     m_DeletedBufferViews.emplace_back(bufferView, BaseBackendLocal::k_DeleteResourceDelay);
 
-    auto Predicate = [&bufferView](const std::pair<uint32_t, GraphicsBackendBufferView>& pair)
+    auto Predicate = [&bufferView](const GraphicsBackendBufferView& boundView)
 	{
-	    return pair.second.BufferView == bufferView.BufferView;
+	    return boundView.BufferView == bufferView.BufferView;
 	};
 
-	std::erase_if(m_BoundBuffers, Predicate);
-	std::erase_if(m_BoundRWBuffers, Predicate);
+	ClearBindings(m_BoundBuffers, Predicate);
+	ClearBindings(m_BoundRWBuffers, Predicate);
 }
 
 void GraphicsBackendBase::DeleteGeometry(const GraphicsBackendGeometry &geometry)
@@ -172,84 +176,110 @@ void GraphicsBackendBase::UseProgram(const GraphicsBackendProgram& program)
     m_CurrentProgram = program;
 }
 
-void GraphicsBackendBase::BindResources()
+template<typename T, typename Equal>
+void GraphicsBackendBase::SetBinding(BindingTable<T>& table, const T& resource, uint32_t index, Equal equal)
 {
-    auto RequiresBinding = [](uint32_t bindingMask, uint32_t dirtyMask, uint32_t binding)
-        {
-            const uint32_t bindingBit = 1 << binding;
-            return (bindingMask & bindingBit) != 0 && (dirtyMask & bindingBit) != 0;
-        };
-
-    const GraphicsBackendProgram& program = m_CurrentProgram;
+    const uint32_t bindingBit = 1 << index;
 
-    for (const auto& pair: m_BoundTextures)
+    // resource is already bound or waits to be bound
+    if ((table.BoundMask & bindingBit) != 0 && equal(table.Slots[index], resource))
     {
-        if (RequiresBinding(program.TextureBindings, m_BoundTexturesDirtyMask, pair.first))
-        {
-            BindTexture_Internal(pair.second, pair.first);
-            m_BoundTexturesDirtyMask &= ~(1 << pair.first);
-        }
+        ++m_BindingStats.Skipped;
+        return;
     }
 
-    for (const auto& pair : m_BoundRWTextures)
+    table.Slots[index] = resource;
+    table.BoundMask |= bindingBit;
+    table.DirtyMask |= bindingBit;
+}
+
+template<typename T, typename Predicate>
+void GraphicsBackendBase::ClearBindings(BindingTable<T>& table, Predicate predicate)
+{
+    for (uint32_t mask = table.BoundMask; mask != 0; mask &= mask - 1)
     {
-        if (RequiresBinding(program.RWTextureBindings, m_BoundRWTexturesDirtyMask, pair.first))
+        const uint32_t index = std::countr_zero(mask);
+        if (predicate(table.Slots[index]))
         {
-            BindRWTexture_Internal(pair.second, pair.first);
-            m_BoundRWTexturesDirtyMask &= ~(1 << pair.first);
+            table.BoundMask &= ~(1 << index);
+            table.DirtyMask &= ~(1 << index);
         }
     }
+}
 
-    for (const auto& pair: m_BoundSamplers)
+template<typename T, typename Bind>
+void GraphicsBackendBase::BindTable(BindingTable<T>& table, uint32_t programBindings, Bind bind)
+{
+    const uint32_t bindMask = table.DirtyMask & programBindings;
+    for (uint32_t mask = bindMask; mask != 0; mask &= mask - 1)
     {
-        if (RequiresBinding(program.SamplerBindings, m_BoundSamplersDirtyMask, pair.first))
-        {
-            BindSampler_Internal(pair.second, pair.first);
-            m_BoundSamplersDirtyMask &= ~(1 << pair.first);
-        }
+        const uint32_t index = std::countr_zero(mask);
+        bind(table.Slots[index], index);
     }
 
-    for (const auto& pair: m_BoundBuffers)
+    table.DirtyMask &= ~bindMask;
+    m_BindingStats.Issued += std::popcount(bindMask);
+}
+
+void GraphicsBackendBase::BindResources()
+{
+    const GraphicsBackendProgram& program = m_CurrentProgram;
+
+    BindTable(m_BoundTextures, program.TextureBindings, [this](const GraphicsBackendTexture& texture, uint32_t index)
     {
-        const GraphicsBackendBufferView& view = pair.second;
-        if (RequiresBinding(program.BufferBindings, m_BoundBuffersDirtyMask, pair.first))
-        {
-            BindBuffer_Internal(view, pair.first);
-            m_BoundBuffersDirtyMask &= ~(1 << pair.first);
-        }
-    }
+        BindTexture_Internal(texture, index);
+    });
 
-    for (const auto& pair: m_BoundConstantBuffers)
+    BindTable(m_BoundRWTextures, program.RWTextureBindings, [this](const GraphicsBackendTexture& texture, uint32_t index)
     {
-        const BufferBindInfo& info = pair.second;
-        if (RequiresBinding(program.ConstantBufferBindings, m_BoundConstantBuffersDirtyMask, pair.first))
-        {
-            BindConstantBuffer_Internal(info.Buffer, pair.first, info.Offset, info.Size);
-            m_BoundConstantBuffersDirtyMask &= ~(1 << pair.first);
-        }
-    }
+        BindRWTexture_Internal(texture, index);
+    });
 
-    for (const auto& pair : m_BoundRWBuffers)
+    BindTable(m_BoundSamplers, program.SamplerBindings, [this](const GraphicsBackendSampler& sampler, uint32_t index)
     {
-        const GraphicsBackendBufferView& view = pair.second;
-        if (RequiresBinding(program.RWBufferBindings, m_BoundRWBuffersDirtyMask, pair.first))
-        {
-            BindRWBuffer_Internal(view, pair.first);
-            m_BoundRWBuffersDirtyMask &= ~(1 << pair.first);
-        }
-    }
+        BindSampler_Internal(sampler, index);
+    });
+
+    BindTable(m_BoundBuffers, program.BufferBindings, [this](const GraphicsBackendBufferView& view, uint32_t index)
+    {
+        BindBuffer_Internal(view, index);
+    });
+
+    BindTable(m_BoundConstantBuffers, program.ConstantBufferBindings, [this](const BufferBindInfo& info, uint32_t index)
+    {
+        BindConstantBuffer_Internal(info.Buffer, index, info.Offset, info.Size);
+    });
+
+    BindTable(m_BoundRWBuffers, program.RWBufferBindings, [this](const GraphicsBackendBufferView& view, uint32_t index)
+    {
+        BindRWBuffer_Internal(view, index);
+    });
+}
+
+void GraphicsBackendBase::InvalidateBindings()
+{
+    m_BoundTextures.DirtyMask = m_BoundTextures.BoundMask;
+    m_BoundRWTextures.DirtyMask = m_BoundRWTextures.BoundMask;
+    m_BoundSamplers.DirtyMask = m_BoundSamplers.BoundMask;
+    m_BoundBuffers.DirtyMask = m_BoundBuffers.BoundMask;
+    m_BoundConstantBuffers.DirtyMask = m_BoundConstantBuffers.BoundMask;
+    m_BoundRWBuffers.DirtyMask = m_BoundRWBuffers.BoundMask;
 }
 
 void GraphicsBackendBase::BindTexture(const GraphicsBackendTexture& texture, uint32_t index)
 {
-    m_BoundTextures[index] = texture;
-    m_BoundTexturesDirtyMask |= 1 << index;
+    SetBinding(m_BoundTextures, texture, index, [](const GraphicsBackendTexture& a, const GraphicsBackendTexture& b)
+    {
+        return a.Texture == b.Texture;
+    });
 }
 
 void GraphicsBackendBase::BindSampler(const GraphicsBackendSampler& sampler, uint32_t index)
 {
-    m_BoundSamplers[index] = sampler;
-    m_BoundSamplersDirtyMask |= 1 << index;
+    SetBinding(m_BoundSamplers, sampler, index, [](const GraphicsBackendSampler& a, const GraphicsBackendSampler& b)
+    {
+        return a.Sampler == b.Sampler;
+    });
 }
 
 void GraphicsBackendBase::BindTextureSampler(const GraphicsBackendTexture& texture, const GraphicsBackendSampler& sampler, uint32_t index)
@@ -260,8 +290,10 @@ void GraphicsBackendBase::BindTextureSampler(const GraphicsBackendTexture& textu
 
 void GraphicsBackendBase::BindRWTexture(const GraphicsBackendTexture& texture, uint32_t index)
 {
-    m_BoundRWTextures[index] = texture;
-    m_BoundRWTexturesDirtyMask |= 1 << index;
+    SetBinding(m_BoundRWTextures, texture, index, [](const GraphicsBackendTexture& a, const GraphicsBackendTexture& b)
+    {
+        return a.Texture == b.Texture;
+    });
 }
 
 void GraphicsBackendBase::UploadImagePixels(const GraphicsBackendTexture& texture, int level, int width, int height, int depth, int imageSize, const void* pixelsData)
@@ -271,20 +303,26 @@ void GraphicsBackendBase::UploadImagePixels(const GraphicsBackendTexture& textur
 
 void GraphicsBackendBase::BindBuffer(const GraphicsBackendBufferView& bufferView, uint32_t index)
 {
-    m_BoundBuffers[index] = bufferView;
-    m_BoundBuffersDirtyMask |= 1 << index;
+    SetBinding(m_BoundBuffers, bufferView, index, [](const GraphicsBackendBufferView& a, const GraphicsBackendBufferView& b)
+    {
+        return a.BufferView == b.BufferView;
+    });
 }
 
 void GraphicsBackendBase::BindConstantBuffer(const GraphicsBackendBuffer& buffer, uint32_t index, int offset, int size)
 {
-    m_BoundConstantBuffers[index] = BufferBindInfo{buffer, BufferType::CONSTANT_BUFFER, offset, size};
-    m_BoundConstantBuffersDirtyMask |= 1 << index;
+    SetBinding(m_BoundConstantBuffers, BufferBindInfo{buffer, BufferType::CONSTANT_BUFFER, offset, size}, index, [](const BufferBindInfo& a, const BufferBindInfo& b)
+    {
+        return a.Buffer.Buffer == b.Buffer.Buffer && a.Offset == b.Offset && a.Size == b.Size;
+    });
 }
 
 void GraphicsBackendBase::BindRWBuffer(const GraphicsBackendBufferView& bufferView, uint32_t index)
 {
-    m_BoundRWBuffers[index] = bufferView;
-    m_BoundRWBuffersDirtyMask |= 1 << index;
+    SetBinding(m_BoundRWBuffers, bufferView, index, [](const GraphicsBackendBufferView& a, const GraphicsBackendBufferView& b)
+    {
+        return a.BufferView == b.BufferView;
+    });
 }
 
 GraphicsBackendProgram GraphicsBackendBase::CreateProgram(uint64_t programPtr, const GraphicsBackendProgramDescriptor& descriptor)
@@ -327,6 +365,8 @@ GraphicsBackendProgram GraphicsBackendBase::CreateProgram(uint64_t programPtr, c
 
 void GraphicsBackendBase::EndRenderPass()
 {
+    InvalidateBindings();
+
     m_StencilDescriptor = {};
     m_DepthDescriptor = {};
     m_RasterizerDescriptor = {};
@@ -542,12 +582,12 @@ bool GraphicsBackendBase::IsMainThread()
 
 bool GraphicsBackendBase::IsBoundResourcesDirty() const
 {
-	return (m_BoundTexturesDirtyMask & m_CurrentProgram.TextureBindings) != 0 || 
-        (m_BoundRWTexturesDirtyMask & m_CurrentProgram.RWTextureBindings) != 0 || 
-        (m_BoundSamplersDirtyMask & m_CurrentProgram.SamplerBindings) != 0 ||
-		(m_BoundBuffersDirtyMask & m_CurrentProgram.BufferBindings) != 0 ||
-        (m_BoundRWBuffersDirtyMask & m_CurrentProgram.RWBufferBindings) != 0 || 
-        (m_BoundConstantBuffersDirtyMask & m_CurrentProgram.ConstantBufferBindings) != 0;
+	return (m_BoundTextures.DirtyMask & m_CurrentProgram.TextureBindings) != 0 ||
+        (m_BoundRWTextures.DirtyMask & m_CurrentProgram.RWTextureBindings) != 0 ||
+        (m_BoundSamplers.DirtyMask & m_CurrentProgram.SamplerBindings) != 0 ||
+		(m_BoundBuffers.DirtyMask & m_CurrentProgram.BufferBindings) != 0 ||
+        (m_BoundRWBuffers.DirtyMask & m_CurrentProgram.RWBufferBindings) != 0 ||
+        (m_BoundConstantBuffers.DirtyMask & m_CurrentProgram.ConstantBufferBindings) != 0;
 }
 
 size_t GraphicsBackendBase::GetDepthDescriptorHash(const GraphicsBackendDepthDescriptor& depthDescriptor)
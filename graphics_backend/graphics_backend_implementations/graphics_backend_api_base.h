@@ -12,11 +12,14 @@
 #include "types/graphics_backend_rasterizer_descriptor.h"
 #include "types/graphics_backend_blend_descriptor.h"
 #include "types/graphics_backend_program.h"
+#include "types/graphics_backend_texture.h"
+#include "types/graphics_backend_sampler.h"
+#include "types/graphics_backend_buffer_view.h"
 
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
-#include <unordered_map>
 #include <thread>
 #include <mutex>
 
@@ -58,6 +61,12 @@ struct GraphicsBackendBufferView;
 class GraphicsBackendBase
 {
 public:
+    struct BindingStats
+    {
+        uint32_t Issued;
+        uint32_t Skipped;
+    };
+
 	virtual ~GraphicsBackendBase() = default;
 
 	static GraphicsBackendBase *Create();
@@ -186,6 +195,11 @@ public:
         return m_DrawCallCount;
     }
 
+    const BindingStats& GetBindingStats() const
+    {
+        return m_BindingStats;
+    }
+
     static size_t GetDepthDescriptorHash(const GraphicsBackendDepthDescriptor& depthDescriptor);
     static size_t GetStencilOperationDescriptorHash(const GraphicsBackendStencilOperationDescriptor& stencilOperationDescriptor);
     static size_t GetStencilDescriptorHash(const GraphicsBackendStencilDescriptor& stencilDescriptor);
@@ -198,6 +212,8 @@ protected:
     bool IsMainThread();
     bool IsBoundResourcesDirty() const;
     void BindResources();
+    // marks all bound resources to be bound again, for backends that lose bindings when pass ends
+    void InvalidateBindings();
 
     virtual void DeleteTexture_Internal(const GraphicsBackendTexture &texture) = 0;
     virtual void DeleteSampler_Internal(const GraphicsBackendSampler &sampler) = 0;
@@ -249,19 +265,30 @@ private:
     std::mutex m_DeletedShadersMutex;
     std::mutex m_DeletedProgramsMutex;
 
-    std::unordered_map<uint32_t, GraphicsBackendTexture> m_BoundTextures;
-    std::unordered_map<uint32_t, GraphicsBackendTexture> m_BoundRWTextures;
-    std::unordered_map<uint32_t, GraphicsBackendSampler> m_BoundSamplers;
-    std::unordered_map<uint32_t, GraphicsBackendBufferView> m_BoundBuffers;
-    std::unordered_map<uint32_t, BufferBindInfo> m_BoundConstantBuffers;
-    std::unordered_map<uint32_t, GraphicsBackendBufferView> m_BoundRWBuffers;
-
-    uint32_t m_BoundTexturesDirtyMask = 0;
-    uint32_t m_BoundRWTexturesDirtyMask = 0;
-    uint32_t m_BoundSamplersDirtyMask = 0;
-    uint32_t m_BoundBuffersDirtyMask = 0;
-    uint32_t m_BoundConstantBuffersDirtyMask = 0;
-    uint32_t m_BoundRWBuffersDirtyMask = 0;
+    // binding indices are limited by 32 bit masks of programs
+    template<typename T>
+    struct BindingTable
+    {
+        std::array<T, 32> Slots;
+        uint32_t BoundMask = 0;
+        uint32_t DirtyMask = 0;
+    };
+
+    BindingTable<GraphicsBackendTexture> m_BoundTextures;
+    BindingTable<GraphicsBackendTexture> m_BoundRWTextures;
+    BindingTable<GraphicsBackendSampler> m_BoundSamplers;
+    BindingTable<GraphicsBackendBufferView> m_BoundBuffers;
+    BindingTable<BufferBindInfo> m_BoundConstantBuffers;
+    BindingTable<GraphicsBackendBufferView> m_BoundRWBuffers;
+
+    BindingStats m_BindingStats{};
+
+    template<typename T, typename Equal>
+    void SetBinding(BindingTable<T>& table, const T& resource, uint32_t index, Equal equal);
+    template<typename T, typename Predicate>
+    static void ClearBindings(BindingTable<T>& table, Predicate predicate);
+    template<typename T, typename Bind>
+    void BindTable(BindingTable<T>& table, uint32_t programBindings, Bind bind);
 
     GraphicsBackendStencilDescriptor m_StencilDescriptor;
     GraphicsBackendDepthDescriptor m_DepthDescriptor;
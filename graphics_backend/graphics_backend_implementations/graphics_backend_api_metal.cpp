@@ -1093,6 +1093,8 @@ void GraphicsBackendMetal::EndComputePass()
 
     m_ComputeCommandEncoder->endEncoding();
     m_ComputeCommandEncoder = nullptr;
+
+    InvalidateBindings();
 }
 
 GraphicsBackendFence GraphicsBackendMetal::CreateFence(FenceType fenceType, const std::string& name)
@@ -0,0 +1,502 @@
+#include "graphics_backend_api.h"
+#include "graphics_backend_api_null.h"
+#include "enums/fence_type.h"
+#include "types/graphics_backend_texture.h"
+#include "types/graphics_backend_sampler.h"
+#include "types/graphics_backend_buffer.h"
+#include "types/graphics_backend_program.h"
+#include "types/graphics_backend_shader_object.h"
+#include "types/graphics_backend_geometry.h"
+#include "types/graphics_backend_render_target_descriptor.h"
+#include "types/graphics_backend_fence.h"
+#include "types/graphics_backend_program_descriptor.h"
+#include "types/graphics_backend_texture_descriptor.h"
+#include "types/graphics_backend_buffer_descriptor.h"
+#include "types/graphics_backend_buffer_view_descriptor.h"
+#include "types/graphics_backend_buffer_view.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace NullLocal
+{
+    std::atomic<uint64_t> s_NextHandle = 1;
+
+    struct TextureData
+    {
+        TextureType Type;
+        GraphicsBackendTextureDescriptor Descriptor;
+    };
+
+    struct BufferData
+    {
+        std::vector<uint8_t> Data;
+    };
+
+    struct BufferViewData
+    {
+        BufferData* Buffer;
+        GraphicsBackendBufferViewDescriptor Descriptor;
+    };
+
+    uint64_t GetNextHandle()
+    {
+        return s_NextHandle.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    TextureInternalFormat GetBackbufferFormat(FramebufferAttachment attachment, bool& outIsLinear)
+    {
+        switch (attachment)
+        {
+            case FramebufferAttachment::COLOR_ATTACHMENT0:
+                outIsLinear = false;
+                return TextureInternalFormat::RGBA8;
+            case FramebufferAttachment::DEPTH_ATTACHMENT:
+            case FramebufferAttachment::STENCIL_ATTACHMENT:
+            case FramebufferAttachment::DEPTH_STENCIL_ATTACHMENT:
+                outIsLinear = true;
+                return TextureInternalFormat::DEPTH_24_STENCIL_8;
+            default:
+                outIsLinear = false;
+                return TextureInternalFormat::INVALID;
+        }
+    }
+}
+
+void GraphicsBackendNull::Init(void* data)
+{
+    GraphicsBackendBase::Init(data);
+
+    ResetRenderTargets();
+}
+
+GraphicsBackendName GraphicsBackendNull::GetName()
+{
+    return GraphicsBackendName::NULL_BACKEND;
+}
+
+void GraphicsBackendNull::InitNewFrame()
+{
+    GraphicsBackendBase::InitNewFrame();
+}
+
+void GraphicsBackendNull::WaitForPreviousFrame()
+{
+}
+
+void GraphicsBackendNull::FillImGuiInitData(void* data)
+{
+}
+
+void GraphicsBackendNull::FillImGuiFrameData(void* data)
+{
+}
+
+GraphicsBackendTexture GraphicsBackendNull::CreateTexture(TextureType type, const GraphicsBackendTextureDescriptor& descriptor, const std::string& name)
+{
+    NullLocal::TextureData* textureData = new NullLocal::TextureData();
+    textureData->Type = type;
+    textureData->Descriptor = descriptor;
+
+    GraphicsBackendTexture texture{};
+    texture.Texture = reinterpret_cast<uint64_t>(textureData);
+    texture.Type = type;
+    texture.Format = descriptor.Format;
+    texture.IsLinear = descriptor.Linear;
+    texture.ReadWrite = descriptor.ReadWrite;
+    return texture;
+}
+
+GraphicsBackendSampler GraphicsBackendNull::CreateSampler(const GraphicsBackendSamplerDescriptor& descriptor, const std::string& name)
+{
+    GraphicsBackendSampler sampler{};
+    sampler.Sampler = NullLocal::GetNextHandle();
+    return sampler;
+}
+
+void GraphicsBackendNull::DeleteTexture_Internal(const GraphicsBackendTexture& texture)
+{
+    delete reinterpret_cast<NullLocal::TextureData*>(texture.Texture);
+}
+
+void GraphicsBackendNull::DeleteSampler_Internal(const GraphicsBackendSampler& sampler)
+{
+}
+
+void GraphicsBackendNull::BindTexture_Internal(const GraphicsBackendTexture& texture, uint32_t index)
+{
+}
+
+void GraphicsBackendNull::BindRWTexture_Internal(const GraphicsBackendTexture& texture, uint32_t index)
+{
+}
+
+void GraphicsBackendNull::BindSampler_Internal(const GraphicsBackendSampler& sampler, uint32_t index)
+{
+}
+
+void GraphicsBackendNull::GenerateMipmaps(const GraphicsBackendTexture& texture)
+{
+}
+
+void GraphicsBackendNull::UploadImagePixels(const GraphicsBackendTexture& texture, int level, CubemapFace cubemapFace, int width, int height, int depth, int imageSize, const void* pixelsData)
+{
+}
+
+void GraphicsBackendNull::AttachRenderTarget(const GraphicsBackendRenderTargetDescriptor& descriptor)
+{
+    const NullLocal::TextureData* textureData = reinterpret_cast<NullLocal::TextureData*>(descriptor.Texture.Texture);
+
+    RenderTargetInfo& info = m_RenderTargets[static_cast<int>(descriptor.Attachment)];
+    if (descriptor.IsBackbuffer)
+    {
+        info.Format = NullLocal::GetBackbufferFormat(descriptor.Attachment, info.IsLinear);
+    }
+    else if (textureData)
+    {
+        info.Format = textureData->Descriptor.Format;
+        info.IsLinear = textureData->Descriptor.Linear;
+    }
+    else
+    {
+        info.Format = TextureInternalFormat::INVALID;
+        info.IsLinear = false;
+    }
+}
+
+TextureInternalFormat GraphicsBackendNull::GetRenderTargetFormat(FramebufferAttachment attachment, bool* outIsLinear)
+{
+    const RenderTargetInfo& info = m_RenderTargets[static_cast<int>(attachment)];
+    if (outIsLinear)
+        *outIsLinear = info.IsLinear;
+    return info.Format;
+}
+
+GraphicsBackendBuffer GraphicsBackendNull::CreateBuffer(const GraphicsBackendBufferDescriptor& descriptor, const std::string& name, const void* data)
+{
+    NullLocal::BufferData* bufferData = new NullLocal::BufferData();
+    bufferData->Data.resize(descriptor.Size);
+    if (data)
+        memcpy(bufferData->Data.data(), data, descriptor.Size);
+
+    GraphicsBackendBuffer buffer{};
+    buffer.Buffer = reinterpret_cast<uint64_t>(bufferData);
+    buffer.Size = descriptor.Size;
+    return buffer;
+}
+
+GraphicsBackendBufferView GraphicsBackendNull::CreateBufferView(const GraphicsBackendBufferViewDescriptor& descriptor, const GraphicsBackendBuffer& buffer, const std::string& name)
+{
+    NullLocal::BufferViewData* viewData = new NullLocal::BufferViewData();
+    viewData->Buffer = reinterpret_cast<NullLocal::BufferData*>(buffer.Buffer);
+    viewData->Descriptor = descriptor;
+
+    GraphicsBackendBufferView bufferView{};
+    bufferView.BufferView = viewData;
+    return bufferView;
+}
+
+void GraphicsBackendNull::DeleteBuffer_Internal(const GraphicsBackendBuffer& buffer)
+{
+    delete reinterpret_cast<NullLocal::BufferData*>(buffer.Buffer);
+}
+
+void GraphicsBackendNull::DeleteBufferView_Internal(const GraphicsBackendBufferView& bufferView)
+{
+    delete static_cast<NullLocal::BufferViewData*>(bufferView.BufferView);
+}
+
+void GraphicsBackendNull::BindBuffer_Internal(const GraphicsBackendBufferView& bufferView, uint32_t index)
+{
+}
+
+void GraphicsBackendNull::BindConstantBuffer_Internal(const GraphicsBackendBuffer& buffer, uint32_t index, int offset, int size)
+{
+}
+
+void GraphicsBackendNull::BindRWBuffer_Internal(const GraphicsBackendBufferView& bufferView, uint32_t index)
+{
+}
+
+void GraphicsBackendNull::SetBufferData(const GraphicsBackendBuffer& buffer, long offset, long size, const void* data)
+{
+    NullLocal::BufferData* bufferData = reinterpret_cast<NullLocal::BufferData*>(buffer.Buffer);
+    assert(offset + size <= bufferData->Data.size());
+    memcpy(bufferData->Data.data() + offset, data, size);
+}
+
+void GraphicsBackendNull::CopyBufferSubData(const GraphicsBackendBuffer& source, const GraphicsBackendBuffer& destination, int sourceOffset, int destinationOffset, int size)
+{
+    const NullLocal::BufferData* sourceData = reinterpret_cast<NullLocal::BufferData*>(source.Buffer);
+    NullLocal::BufferData* destinationData = reinterpret_cast<NullLocal::BufferData*>(destination.Buffer);
+    assert(sourceOffset + size <= sourceData->Data.size());
+    assert(destinationOffset + size <= destinationData->Data.size());
+    memmove(destinationData->Data.data() + destinationOffset, sourceData->Data.data() + sourceOffset, size);
+}
+
+uint64_t GraphicsBackendNull::GetMaxConstantBufferSize()
+{
+    return std::numeric_limits<uint32_t>::max();
+}
+
+int GraphicsBackendNull::GetConstantBufferOffsetAlignment()
+{
+    return 4;
+}
+
+GraphicsBackendGeometry GraphicsBackendNull::CreateGeometry(const GraphicsBackendBuffer& vertexBuffer, const GraphicsBackendBuffer& indexBuffer, const std::vector<GraphicsBackendVertexAttributeDescriptor>& vertexAttributes, const std::string& name)
+{
+    GraphicsBackendGeometry geometry{};
+    geometry.Geometry = NullLocal::GetNextHandle();
+    geometry.VertexBuffer = vertexBuffer;
+    geometry.IndexBuffer = indexBuffer;
+    return geometry;
+}
+
+void GraphicsBackendNull::DeleteGeometry_Internal(const GraphicsBackendGeometry& geometry)
+{
+}
+
+void GraphicsBackendNull::SetViewport(int x, int y, int width, int height, float near, float far)
+{
+}
+
+void GraphicsBackendNull::SetScissorRect(int x, int y, int width, int height)
+{
+}
+
+GraphicsBackendShaderObject GraphicsBackendNull::CompileShader(ShaderType shaderType, const std::string& source, const std::string& name)
+{
+    GraphicsBackendShaderObject shaderObject{};
+    shaderObject.ShaderObject = NullLocal::GetNextHandle();
+    shaderObject.Type = shaderType;
+    return shaderObject;
+}
+
+GraphicsBackendShaderObject GraphicsBackendNull::CompileShaderBinary(ShaderType shaderType, const std::vector<uint8_t>& shaderBinary, const std::string& name)
+{
+    GraphicsBackendShaderObject shaderObject{};
+    shaderObject.ShaderObject = NullLocal::GetNextHandle();
+    shaderObject.Type = shaderType;
+    return shaderObject;
+}
+
+GraphicsBackendProgram GraphicsBackendNull::CreateProgram(const GraphicsBackendProgramDescriptor& descriptor)
+{
+    return GraphicsBackendBase::CreateProgram(NullLocal::GetNextHandle(), descriptor);
+}
+
+void GraphicsBackendNull::DeleteShader_Internal(GraphicsBackendShaderObject shader)
+{
+}
+
+void GraphicsBackendNull::DeleteProgram_Internal(GraphicsBackendProgram program)
+{
+}
+
+void GraphicsBackendNull::SetClearColor(float r, float g, float b, float a)
+{
+}
+
+void GraphicsBackendNull::SetClearDepth(double depth)
+{
+}
+
+void GraphicsBackendNull::SetStencilValue(uint8_t value)
+{
+}
+
+void GraphicsBackendNull::DrawArrays(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int firstIndex, int indicesCount)
+{
+    assert(m_RenderPassActive);
+
+    ++m_DrawCallCount;
+
+    BindResources();
+}
+
+void GraphicsBackendNull::DrawArraysInstanced(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int firstIndex, int indicesCount, int instanceCount)
+{
+    assert(m_RenderPassActive);
+
+    ++m_DrawCallCount;
+
+    BindResources();
+}
+
+void GraphicsBackendNull::DrawElements(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int elementsCount, IndicesDataType dataType)
+{
+    assert(m_RenderPassActive);
+
+    ++m_DrawCallCount;
+
+    BindResources();
+}
+
+void GraphicsBackendNull::DrawElementsInstanced(const GraphicsBackendGeometry& geometry, PrimitiveType primitiveType, int elementsCount, IndicesDataType dataType, int instanceCount)
+{
+    assert(m_RenderPassActive);
+
+    ++m_DrawCallCount;
+
+    BindResources();
+}
+
+void GraphicsBackendNull::Dispatch(uint32_t x, uint32_t y, uint32_t z)
+{
+    assert(m_ComputePassActive);
+
+    BindResources();
+}
+
+void GraphicsBackendNull::CopyTextureToTexture(const GraphicsBackendTexture& source, const GraphicsBackendRenderTargetDescriptor& destinationDescriptor, unsigned int sourceX, unsigned int sourceY, unsigned int destinationX, unsigned int destinationY, unsigned int width, unsigned int height)
+{
+}
+
+void GraphicsBackendNull::PushDebugGroup(const std::string& name, GPUQueue queue)
+{
+}
+
+void GraphicsBackendNull::PopDebugGroup(GPUQueue queue)
+{
+}
+
+GraphicsBackendProfilerMarker GraphicsBackendNull::PushProfilerMarker(GPUQueue queue)
+{
+    GraphicsBackendProfilerMarker marker{};
+    marker.Frame = GetFrameNumber();
+    marker.Queue = queue;
+    return marker;
+}
+
+void GraphicsBackendNull::PopProfilerMarker(GraphicsBackendProfilerMarker& marker)
+{
+}
+
+bool GraphicsBackendNull::ResolveProfilerMarker(const GraphicsBackendProfilerMarker& marker, ProfilerMarkerResolveResult& outResults)
+{
+    outResults.IsActive = false;
+    return true;
+}
+
+void GraphicsBackendNull::BeginRenderPass(const std::string& name)
+{
+    assert(!m_RenderPassActive && !m_ComputePassActive);
+    m_RenderPassActive = true;
+}
+
+void GraphicsBackendNull::EndRenderPass()
+{
+    GraphicsBackendBase::EndRenderPass();
+
+    assert(m_RenderPassActive);
+    m_RenderPassActive = false;
+
+    ResetRenderTargets();
+}
+
+void GraphicsBackendNull::BeginCopyPass(const std::string& name)
+{
+}
+
+void GraphicsBackendNull::EndCopyPass()
+{
+}
+
+void GraphicsBackendNull::BeginComputePass(const std::string& name)
+{
+    assert(!m_RenderPassActive && !m_ComputePassActive);
+    m_ComputePassActive = true;
+}
+
+void GraphicsBackendNull::EndComputePass()
+{
+    assert(m_ComputePassActive);
+    m_ComputePassActive = false;
+}
+
+GraphicsBackendFence GraphicsBackendNull::CreateFence(FenceType fenceType, const std::string& name)
+{
+    GraphicsBackendFence fence{};
+    fence.Fence = NullLocal::GetNextHandle();
+    fence.Type = fenceType;
+    return fence;
+}
+
+void GraphicsBackendNull::DeleteFence(const GraphicsBackendFence& fence)
+{
+}
+
+void GraphicsBackendNull::SignalFence(const GraphicsBackendFence& fence)
+{
+}
+
+void GraphicsBackendNull::WaitForFence(const GraphicsBackendFence& fence)
+{
+}
+
+void GraphicsBackendNull::Flush()
+{
+}
+
+void GraphicsBackendNull::Present()
+{
+}
+
+void GraphicsBackendNull::TransitionRenderTarget(const GraphicsBackendRenderTargetDescriptor& descriptor, ResourceState state, GPUQueue queue)
+{
+}
+
+void GraphicsBackendNull::TransitionTexture(const GraphicsBackendTexture& texture, ResourceState state, GPUQueue queue)
+{
+}
+
+void GraphicsBackendNull::TransitionBuffer(const GraphicsBackendBuffer& buffer, ResourceState state, GPUQueue queue)
+{
+}
+
+bool GraphicsBackendNull::RequireVertexAttributesForPSO() const
+{
+    return false;
+}
+
+bool GraphicsBackendNull::RequirePrimitiveTypeForPSO() const
+{
+    return false;
+}
+
+bool GraphicsBackendNull::RequireRTFormatsForPSO() const
+{
+    return false;
+}
+
+bool GraphicsBackendNull::RequireStencilStateForPSO() const
+{
+    return false;
+}
+
+bool GraphicsBackendNull::RequireDepthStateForPSO() const
+{
+    return false;
+}
+
+bool GraphicsBackendNull::RequireRasterizerStateForPSO() const
+{
+    return false;
+}
+
+bool GraphicsBackendNull::RequireBlendStateForPSO() const
+{
+    return false;
+}
+
+void GraphicsBackendNull::ResetRenderTargets()
+{
+    for (int i = 0; i < static_cast<int>(FramebufferAttachment::MAX); ++i)
+    {
+        RenderTargetInfo& info = m_RenderTargets[i];
+        info.Format = NullLocal::GetBackbufferFormat(static_cast<FramebufferAttachment>(i), info.IsLinear);
+    }
+}
@@ -350,6 +350,7 @@ GraphicsBackendTexture GraphicsBackendOpenGL::CreateTexture(TextureType type, co
 
     const GLenum textureType = OpenGLHelpers::ToTextureType(type);
     glBindTexture(textureType, texture.Texture);
+    InvalidateTextureBindings();
     glTexParameteri(textureType, GL_TEXTURE_BASE_LEVEL, 0);
     glTexParameteri(textureType, GL_TEXTURE_MAX_LEVEL, descriptor.MipLevels - 1);
     if (!name.empty())
@@ -437,6 +438,7 @@ void GraphicsBackendOpenGL::GenerateMipmaps(const GraphicsBackendTexture &textur
 {
     GLenum textureType = OpenGLHelpers::ToTextureType(texture.Type);
     glBindTexture(textureType, texture.Texture);
+    InvalidateTextureBindings();
     glGenerateMipmap(textureType);
 }
 
@@ -450,6 +452,7 @@ void GraphicsBackendOpenGL::UploadImagePixels(const GraphicsBackendTexture &text
     const bool isTexture3D = IsTexture3D(texture.Type);
 
     glBindTexture(type, texture.Texture);
+    InvalidateTextureBindings();
     if (IsCompressedTextureFormat(texture.Format) && imageSize != 0)
     {
         if (isTexture3D)
@@ -584,6 +587,7 @@ GraphicsBackendBufferView GraphicsBackendOpenGL::CreateBufferView(const Graphics
         glGenTextures(1, &viewData->GLView);
         glBindBuffer(GL_TEXTURE_BUFFER, bufferData->GLBuffer);
         glBindTexture(GL_TEXTURE_BUFFER, viewData->GLView);
+        InvalidateTextureBindings();
         glTexBufferRange(GL_TEXTURE_BUFFER, OpenGLHelpers::ToTextureInternalFormat(descriptor.Format, true), bufferData->GLBuffer, descriptor.Offset, descriptor.Size);
         if (!name.empty())
             glObjectLabel(GL_TEXTURE, viewData->GLView, name.length(), name.c_str());
@@ -1336,6 +1340,13 @@ void GraphicsBackendOpenGL::InitContext()
     }
 }
 
+void GraphicsBackendOpenGL::InvalidateTextureBindings()
+{
+    // other threads have their own contexts
+    if (IsMainThread())
+        InvalidateBindings();
+}
+
 void GraphicsBackendOpenGL::CreatePendingContexts()
 {
     std::unique_lock lock(m_ThreadContextsMutex);
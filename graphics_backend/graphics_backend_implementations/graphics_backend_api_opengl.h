@@ -117,6 +117,9 @@ private:
     void InitContext();
     void CreatePendingContexts();
 
+    // resources are created and updated by binding them to the active texture unit, so texture of that unit has to be bound again
+    void InvalidateTextureBindings();
+
     static void LogContextError(const std::string& tag);
 };
 
@@ -14,6 +14,7 @@ private:
     friend class GraphicsBackendOpenGL;
     friend class GraphicsBackendMetal;
     friend class GraphicsBackendDX12;
+    friend class GraphicsBackendNull;
 };
 
 #endif //RENDER_ENGINE_GRAPHICS_BACKEND_GEOMETRY_H
@@ -20,6 +20,7 @@ private:
     friend class GraphicsBackendOpenGL;
     friend class GraphicsBackendMetal;
     friend class GraphicsBackendDX12;
+    friend class GraphicsBackendNull;
 };
 
 struct ProfilerMarkerResolveResult
@@ -11,6 +11,7 @@ private:
     friend class GraphicsBackendOpenGL;
     friend class GraphicsBackendMetal;
     friend class GraphicsBackendDX12;
+    friend class GraphicsBackendNull;
     friend class GraphicsBackendBase;
 };
 
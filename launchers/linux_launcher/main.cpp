@@ -0,0 +1,48 @@
+#include "engine_framework.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace LinuxMain_Local
+{
+    constexpr int k_Width = 1920;
+    constexpr int k_Height = 1080;
+
+    // runs until window is closed by the engine, or for the number of frames passed with -frames
+    int GetFramesCount(char** argv, int argc)
+    {
+        for (int i = 0; i < argc - 1; ++i)
+        {
+            if (strcmp(argv[i], "-frames") == 0)
+            {
+                int frames = -1;
+                std::from_chars(argv[i + 1], argv[i + 1] + strlen(argv[i + 1]), frames);
+                return frames;
+            }
+        }
+        return -1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // skip executable path, engine expects only arguments
+    char** arguments = argv + 1;
+    int argumentsCount = argc - 1;
+
+    // there is no window and no gpu backend on linux, frames are rendered with null backend
+    EngineFramework::Initialize(nullptr, nullptr, arguments, argumentsCount);
+
+    int frames = LinuxMain_Local::GetFramesCount(arguments, argumentsCount);
+    for (int i = 0; frames < 0 || i < frames; ++i)
+    {
+        if (EngineFramework::ShouldCloseWindow())
+            break;
+
+        EngineFramework::TickMainLoop(LinuxMain_Local::k_Width, LinuxMain_Local::k_Height);
+    }
+
+    EngineFramework::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "math_simd.h"
+#include "matrix4x4/matrix4x4.h"
+#include "quaternion/quaternion.h"
+#include "vector3/vector3.h"
+#include "vector4/vector4.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// built against SIMD and scalar math, so both outputs can be compared
+namespace MathBenchmarkLocal
+{
+    constexpr size_t k_ValuesCount = 4096;
+    constexpr size_t k_Iterations = 10000000;
+
+#if RENDER_ENGINE_MATH_SSE
+    constexpr const char* k_Implementation = "sse";
+#elif RENDER_ENGINE_MATH_NEON
+    constexpr const char* k_Implementation = "neon";
+#else
+    constexpr const char* k_Implementation = "scalar";
+#endif
+
+    volatile float s_Sink = 0;
+
+    template<typename Func>
+    double MeasureNsPerOp(Func func)
+    {
+        // warm up caches and branch predictors before measuring
+        for (size_t i = 0; i < k_ValuesCount; ++i)
+            func(i);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < k_Iterations; ++i)
+            func(i % k_ValuesCount);
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(k_Iterations);
+    }
+}
+
+int main()
+{
+    using namespace MathBenchmarkLocal;
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> values(-3, 3);
+
+    std::vector<Vector3> positions(k_ValuesCount);
+    std::vector<Quaternion> rotations(k_ValuesCount);
+    std::vector<Vector3> scales(k_ValuesCount);
+    std::vector<Matrix4x4> matrices(k_ValuesCount);
+    std::vector<Vector4> vectors(k_ValuesCount);
+    for (size_t i = 0; i < k_ValuesCount; ++i)
+    {
+        positions[i] = Vector3{values(random), values(random), values(random)};
+        rotations[i] = Quaternion::AngleAxis(values(random) * 60, Vector3{values(random), values(random), values(random)}.Normalize());
+        scales[i] = Vector3{1 + values(random) * 0.2f, 1 + values(random) * 0.2f, 1 + values(random) * 0.2f};
+        matrices[i] = Matrix4x4::TRS(positions[i], rotations[i], scales[i]);
+        vectors[i] = Vector4{values(random), values(random), values(random), 1};
+    }
+
+    const double multiply = MeasureNsPerOp([&](size_t i)
+    {
+        s_Sink = (matrices[i] * matrices[(i + 1) % k_ValuesCount]).m00;
+    });
+    const double invert = MeasureNsPerOp([&](size_t i)
+    {
+        s_Sink = matrices[i].Invert().m00;
+    });
+    const double trs = MeasureNsPerOp([&](size_t i)
+    {
+        s_Sink = Matrix4x4::TRS(positions[i], rotations[i], scales[i]).m00;
+    });
+    const double transform = MeasureNsPerOp([&](size_t i)
+    {
+        s_Sink = (matrices[i] * vectors[i]).x;
+    });
+
+    printf("%-8s %12s %12s %12s %12s\n", "math", "multiply ns", "invert ns", "trs ns", "transform ns");
+    printf("%-8s %12.2f %12.2f %12.2f %12.2f\n", k_Implementation, multiply, invert, trs, transform);
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef RENDER_ENGINE_MATH_SIMD_H
+#define RENDER_ENGINE_MATH_SIMD_H
+
+// Minimal 4-wide float vector used by math types internally.
+// Define RENDER_ENGINE_MATH_SCALAR to use scalar reference implementations instead
+#if RENDER_ENGINE_MATH_SCALAR
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RENDER_ENGINE_MATH_SSE 1
+#elif (defined(__aarch64__) || defined(__ARM_NEON)) && defined(__clang__)
+#include <arm_neon.h>
+#define RENDER_ENGINE_MATH_NEON 1
+#endif
+
+#define RENDER_ENGINE_MATH_SIMD (RENDER_ENGINE_MATH_SSE || RENDER_ENGINE_MATH_NEON)
+
+#if RENDER_ENGINE_MATH_SIMD
+namespace MathSimd
+{
+#if RENDER_ENGINE_MATH_SSE
+    using float4 = __m128;
+
+    inline float4 Load(const float* values) { return _mm_loadu_ps(values); }
+    inline void Store(float* values, float4 v) { _mm_storeu_ps(values, v); }
+    inline float4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+    inline float4 Splat(float value) { return _mm_set1_ps(value); }
+    inline float4 Add(float4 a, float4 b) { return _mm_add_ps(a, b); }
+    inline float4 Sub(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+    inline float4 Mul(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+    inline float4 Div(float4 a, float4 b) { return _mm_div_ps(a, b); }
+    inline float GetX(float4 v) { return _mm_cvtss_f32(v); }
+
+    // result is (a[X], a[Y], b[Z], b[W])
+    template<int X, int Y, int Z, int W>
+    float4 Shuffle(float4 a, float4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+#elif RENDER_ENGINE_MATH_NEON
+    using float4 = float32x4_t;
+
+    inline float4 Load(const float* values) { return vld1q_f32(values); }
+    inline void Store(float* values, float4 v) { vst1q_f32(values, v); }
+    inline float4 Set(float x, float y, float z, float w) { return float4{x, y, z, w}; }
+    inline float4 Splat(float value) { return vdupq_n_f32(value); }
+    inline float4 Add(float4 a, float4 b) { return vaddq_f32(a, b); }
+    inline float4 Sub(float4 a, float4 b) { return vsubq_f32(a, b); }
+    inline float4 Mul(float4 a, float4 b) { return vmulq_f32(a, b); }
+    inline float4 Div(float4 a, float4 b) { return vdivq_f32(a, b); }
+    inline float GetX(float4 v) { return vgetq_lane_f32(v, 0); }
+
+    // result is (a[X], a[Y], b[Z], b[W])
+    template<int X, int Y, int Z, int W>
+    float4 Shuffle(float4 a, float4 b) { return __builtin_shufflevector(a, b, X, Y, Z + 4, W + 4); }
+#endif
+
+    template<int X, int Y, int Z, int W>
+    float4 Swizzle(float4 v) { return Shuffle<X, Y, Z, W>(v, v); }
+
+    template<int I>
+    float4 SplatLane(float4 v) { return Shuffle<I, I, I, I>(v, v); }
+}
+#endif
+
+#endif //RENDER_ENGINE_MATH_SIMD_H
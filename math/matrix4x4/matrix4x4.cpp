@@ -1,10 +1,36 @@
 #include "matrix4x4.h"
 #include "math_utils.h"
+#include "math_simd.h"
 #include "quaternion/quaternion.h"
 #include "vector3/vector3.h"
 #include "vector4/vector4.h"
 #include <cmath>
 
+#if RENDER_ENGINE_MATH_SIMD
+namespace Matrix4x4Local
+{
+    using namespace MathSimd;
+
+    // 2x2 matrices are stored in a single vector as (m00, m01, m10, m11)
+    float4 Mat2Mul(float4 a, float4 b)
+    {
+        return Add(Mul(a, Swizzle<0, 3, 0, 3>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    }
+
+    // adjugate(a) * b
+    float4 Mat2AdjMul(float4 a, float4 b)
+    {
+        return Sub(Mul(Swizzle<3, 3, 0, 0>(a), b), Mul(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+    }
+
+    // a * adjugate(b)
+    float4 Mat2MulAdj(float4 a, float4 b)
+    {
+        return Sub(Mul(a, Swizzle<3, 0, 3, 0>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    }
+}
+#endif
+
 const Matrix4x4 &Matrix4x4::Zero()
 {
     static const Matrix4x4 zero {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
@@ -60,7 +86,21 @@ Matrix4x4 Matrix4x4::Scale(const Vector3 &_scale)
 
 Matrix4x4 Matrix4x4::TRS(const Vector3 &_translation, const Quaternion &_rotation, const Vector3 &_scale)
 {
-    return Translation(_translation) * Rotation(_rotation) * Scale(_scale);
+    // same as Translation * Rotation * Scale, without two full matrix multiplications
+    Matrix4x4 result = Rotation(_rotation);
+    result.m00 *= _scale.x;
+    result.m01 *= _scale.x;
+    result.m02 *= _scale.x;
+    result.m10 *= _scale.y;
+    result.m11 *= _scale.y;
+    result.m12 *= _scale.y;
+    result.m20 *= _scale.z;
+    result.m21 *= _scale.z;
+    result.m22 *= _scale.z;
+    result.m30 = _translation.x;
+    result.m31 = _translation.y;
+    result.m32 = _translation.z;
+    return result;
 }
 
 Matrix4x4 Matrix4x4::TBN(const Vector3 &tangent, const Vector3 &bitangent, const Vector3 &normal)
@@ -92,6 +132,28 @@ void Matrix4x4::SetElement(int _column, int _row, float _value)
 
 Matrix4x4 Matrix4x4::operator*(const Matrix4x4 &_matrix) const
 {
+#if RENDER_ENGINE_MATH_SIMD
+    using namespace MathSimd;
+
+    const float4 column0 = Load(&m00);
+    const float4 column1 = Load(&m10);
+    const float4 column2 = Load(&m20);
+    const float4 column3 = Load(&m30);
+
+    Matrix4x4 result;
+    const float* other = &_matrix.m00;
+    float* resultValues = &result.m00;
+    for (int i = 0; i < 4; ++i)
+    {
+        const float4 otherColumn = Load(other + i * 4);
+        float4 resultColumn = Mul(column0, SplatLane<0>(otherColumn));
+        resultColumn = Add(resultColumn, Mul(column1, SplatLane<1>(otherColumn)));
+        resultColumn = Add(resultColumn, Mul(column2, SplatLane<2>(otherColumn)));
+        resultColumn = Add(resultColumn, Mul(column3, SplatLane<3>(otherColumn)));
+        Store(resultValues + i * 4, resultColumn);
+    }
+    return result;
+#else
     auto result = Matrix4x4::Zero();
     for (int i = 0; i < 4; ++i)
     {
@@ -104,20 +166,90 @@ Matrix4x4 Matrix4x4::operator*(const Matrix4x4 &_matrix) const
         }
     }
     return result;
+#endif
 }
 
 Vector4 Matrix4x4::operator*(const Vector4 &_vector) const
 {
+#if RENDER_ENGINE_MATH_SIMD
+    using namespace MathSimd;
+
+    const float4 vector = Load(&_vector.x);
+    float4 result = Mul(Load(&m00), SplatLane<0>(vector));
+    result = Add(result, Mul(Load(&m10), SplatLane<1>(vector)));
+    result = Add(result, Mul(Load(&m20), SplatLane<2>(vector)));
+    result = Add(result, Mul(Load(&m30), SplatLane<3>(vector)));
+
+    Vector4 resultVector;
+    Store(&resultVector.x, result);
+    return resultVector;
+#else
     return {
             m00 * _vector.x + m10 * _vector.y + m20 * _vector.z + m30 * _vector.w,
             m01 * _vector.x + m11 * _vector.y + m21 * _vector.z + m31 * _vector.w,
             m02 * _vector.x + m12 * _vector.y + m22 * _vector.z + m32 * _vector.w,
             m03 * _vector.x + m13 * _vector.y + m23 * _vector.z + m33 * _vector.w,
     };
+#endif
 }
 
 Matrix4x4 Matrix4x4::Invert() const
 {
+#if RENDER_ENGINE_MATH_SIMD
+    using namespace MathSimd;
+    using namespace Matrix4x4Local;
+
+    // block inversion with 2x2 sub-matrices, result is the same for row and column major storage
+    const float4 row0 = Load(&m00);
+    const float4 row1 = Load(&m10);
+    const float4 row2 = Load(&m20);
+    const float4 row3 = Load(&m30);
+
+    const float4 A = Shuffle<0, 1, 0, 1>(row0, row1);
+    const float4 B = Shuffle<2, 3, 2, 3>(row0, row1);
+    const float4 C = Shuffle<0, 1, 0, 1>(row2, row3);
+    const float4 D = Shuffle<2, 3, 2, 3>(row2, row3);
+
+    // determinants of sub-matrices as (|A|, |B|, |C|, |D|)
+    const float4 subDeterminants = Sub(
+            Mul(Shuffle<0, 2, 0, 2>(row0, row2), Shuffle<1, 3, 1, 3>(row1, row3)),
+            Mul(Shuffle<1, 3, 1, 3>(row0, row2), Shuffle<0, 2, 0, 2>(row1, row3)));
+    const float4 detA = SplatLane<0>(subDeterminants);
+    const float4 detB = SplatLane<1>(subDeterminants);
+    const float4 detC = SplatLane<2>(subDeterminants);
+    const float4 detD = SplatLane<3>(subDeterminants);
+
+    const float4 adjDC = Mat2AdjMul(D, C);
+    const float4 adjAB = Mat2AdjMul(A, B);
+
+    float4 X = Sub(Mul(detD, A), Mat2Mul(B, adjDC));
+    float4 W = Sub(Mul(detA, D), Mat2Mul(C, adjAB));
+    float4 Y = Sub(Mul(detB, C), Mat2MulAdj(D, adjAB));
+    float4 Z = Sub(Mul(detC, B), Mat2MulAdj(A, adjDC));
+
+    // |M| = |A| * |D| + |B| * |C| - tr(adj(A) * B * adj(D) * C)
+    float4 trace = Mul(adjAB, Swizzle<0, 2, 1, 3>(adjDC));
+    trace = Add(trace, Swizzle<2, 3, 0, 1>(trace));
+    trace = Add(trace, Swizzle<1, 0, 3, 2>(trace));
+    const float4 det = Sub(Add(Mul(detA, detD), Mul(detB, detC)), trace);
+
+    if (GetX(det) == 0)
+        return Zero();
+
+    const float4 invDet = Div(Set(1, -1, -1, 1), det);
+    X = Mul(X, invDet);
+    Y = Mul(Y, invDet);
+    Z = Mul(Z, invDet);
+    W = Mul(W, invDet);
+
+    Matrix4x4 inverted;
+    float* invertedValues = &inverted.m00;
+    Store(invertedValues, Shuffle<3, 1, 3, 1>(X, Y));
+    Store(invertedValues + 4, Shuffle<2, 0, 2, 0>(X, Y));
+    Store(invertedValues + 8, Shuffle<3, 1, 3, 1>(Z, W));
+    Store(invertedValues + 12, Shuffle<2, 0, 2, 0>(Z, W));
+    return inverted;
+#else
     auto A2323 = m22 * m33 - m23 * m32;
     auto A1323 = m21 * m33 - m23 * m31;
     auto A1223 = m21 * m32 - m22 * m31;
@@ -164,9 +296,32 @@ Matrix4x4 Matrix4x4::Invert() const
     inverted.m32  = det * -(m00 * A1213 - m01 * A0213 + m02 * A0113);
     inverted.m33  = det * (m00 * A1212 - m01 * A0212 + m02 * A0112);
     return inverted;
+#endif
 }
+
 Matrix4x4 Matrix4x4::Transpose() const
 {
+#if RENDER_ENGINE_MATH_SIMD
+    using namespace MathSimd;
+
+    const float4 column0 = Load(&m00);
+    const float4 column1 = Load(&m10);
+    const float4 column2 = Load(&m20);
+    const float4 column3 = Load(&m30);
+
+    const float4 low01 = Shuffle<0, 1, 0, 1>(column0, column1);
+    const float4 low23 = Shuffle<0, 1, 0, 1>(column2, column3);
+    const float4 high01 = Shuffle<2, 3, 2, 3>(column0, column1);
+    const float4 high23 = Shuffle<2, 3, 2, 3>(column2, column3);
+
+    Matrix4x4 transposed;
+    float* transposedValues = &transposed.m00;
+    Store(transposedValues, Shuffle<0, 2, 0, 2>(low01, low23));
+    Store(transposedValues + 4, Shuffle<1, 3, 1, 3>(low01, low23));
+    Store(transposedValues + 8, Shuffle<0, 2, 0, 2>(high01, high23));
+    Store(transposedValues + 12, Shuffle<1, 3, 1, 3>(high01, high23));
+    return transposed;
+#else
     auto transposed = Zero();
 
     transposed.m00 = m00;
@@ -190,6 +345,7 @@ Matrix4x4 Matrix4x4::Transpose() const
     transposed.m33 = m33;
 
     return transposed;
+#endif
 }
 
 Matrix4x4 Matrix4x4::Perspective(float _fov, float _aspect, float _nearZ, float _farZ)
@@ -1,5 +1,6 @@
 #include "quaternion.h"
 #include "vector3/vector3.h"
+#include "math_simd.h"
 #include <cmath>
 
 Quaternion::Quaternion() :
@@ -31,11 +32,27 @@ Quaternion Quaternion::Inverse() const
 
 Quaternion Quaternion::operator*(const Quaternion &_quaternion) const
 {
+#if RENDER_ENGINE_MATH_SIMD
+    using namespace MathSimd;
+
+    const float4 a = Load(&x);
+    const float4 b = Load(&_quaternion.x);
+
+    float4 result = Mul(SplatLane<3>(a), b);
+    result = Add(result, Mul(Mul(SplatLane<0>(a), Swizzle<3, 2, 1, 0>(b)), Set(1, -1, 1, -1)));
+    result = Add(result, Mul(Mul(SplatLane<1>(a), Swizzle<2, 3, 0, 1>(b)), Set(1, 1, -1, -1)));
+    result = Add(result, Mul(Mul(SplatLane<2>(a), Swizzle<1, 0, 3, 2>(b)), Set(-1, 1, 1, -1)));
+
+    Quaternion resultQuaternion;
+    Store(&resultQuaternion.x, result);
+    return resultQuaternion;
+#else
     return {
             x * _quaternion.w + y * _quaternion.z - z * _quaternion.y + w * _quaternion.x,
             -x * _quaternion.z + y * _quaternion.w + z * _quaternion.x + w * _quaternion.y,
             x * _quaternion.y - y * _quaternion.x + z * _quaternion.w + w * _quaternion.z,
             -x * _quaternion.x - y * _quaternion.y - z * _quaternion.z + w * _quaternion.w};
+#endif
 }
 
 Vector3 Quaternion::operator*(const Vector3 &_vector) const
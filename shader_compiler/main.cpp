@@ -1,6 +1,7 @@
 #include "reflection_spirv.h"
 #include "reflection_dxc.h"
 #include "serialization.h"
+#include "package.h"
 #include "graphics_backend.h"
 #include "defines.h"
 #include "arguments.h"
@@ -233,7 +234,9 @@ int main(int argc, char **argv)
 {
     Arguments::Init(argv, argc);
 
-    if (!Arguments::Contains("-backend") || !Arguments::Contains("-output") || !Arguments::Contains("-input"))
+    // -package only collects already compiled variants, so it is run once per shader after all its variants are compiled
+    const bool packageOnly = Arguments::Contains("-package");
+    if (!Arguments::Contains("-backend") || !Arguments::Contains("-output") || (!packageOnly && !Arguments::Contains("-input")))
     {
         std::cout << "No HLSL path or no target backend are specified" << std::endl;
         return 1;
@@ -251,6 +254,9 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    if (packageOnly)
+        return WritePackage(std::filesystem::path(Arguments::Get("-output")) / GetBackendLiteral(backend)) ? 0 : 1;
+
     std::filesystem::path hlslPath = std::filesystem::absolute(std::filesystem::path(Arguments::Get("-input")));
     std::cout << "Compiling shader at path: " << hlslPath << std::endl;
 
@@ -0,0 +1,159 @@
+#ifndef RENDER_ENGINE_SHADER_COMPILER_PACKAGE_H
+#define RENDER_ENGINE_SHADER_COMPILER_PACKAGE_H
+
+#include "reflection_common.h"
+#include "serialization.h"
+#include "graphics_backend.h"
+#include "../core/shader/shader_package/shader_package_format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace Package_Local
+{
+    struct VariantData
+    {
+        uint64_t KeywordsHash;
+        Reflection Reflection;
+        std::string Stages[ShaderPackageFormat::StagesCount];
+    };
+
+    std::string ReadFileContent(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    ShaderPackageFormat::Range Append(std::vector<uint8_t>& bytes, const void* data, size_t size)
+    {
+        const size_t offset = (bytes.size() + ShaderPackageFormat::Alignment - 1) / ShaderPackageFormat::Alignment * ShaderPackageFormat::Alignment;
+        bytes.resize(offset + size);
+        if (size > 0)
+            memcpy(bytes.data() + offset, data, size);
+        return {static_cast<uint32_t>(offset), static_cast<uint32_t>(size)};
+    }
+
+    ShaderPackageFormat::Range Append(std::vector<uint8_t>& bytes, const std::string& string)
+    {
+        return Append(bytes, string.data(), string.size());
+    }
+
+    template<typename T>
+    ShaderPackageFormat::Range Append(std::vector<uint8_t>& bytes, const std::vector<T>& table)
+    {
+        return Append(bytes, table.data(), table.size() * sizeof(T));
+    }
+
+    ShaderPackageFormat::Resource CreateResource(std::vector<uint8_t>& bytes, const std::string& name, ShaderPackageFormat::ResourceType type, uint32_t binding, bool readWrite)
+    {
+        ShaderPackageFormat::Resource resource{};
+        resource.Name = Append(bytes, name);
+        resource.Type = type;
+        resource.Binding = binding;
+        resource.ReadWrite = readWrite ? 1 : 0;
+        return resource;
+    }
+}
+
+// collects all variants compiled for the backend into a single package, variant directories are kept as intermediate output.
+// Must be called once after all variants of the shader are compiled
+inline bool WritePackage(const std::filesystem::path& backendOutputPath)
+{
+    using namespace Package_Local;
+
+    if (!std::filesystem::is_directory(backendOutputPath))
+    {
+        std::cout << "No compiled variants at path: " << backendOutputPath << std::endl;
+        return false;
+    }
+
+    std::vector<VariantData> variants;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(backendOutputPath))
+    {
+        const std::filesystem::path reflectionPath = entry.path() / "reflection.json";
+        if (!entry.is_directory() || !std::filesystem::exists(reflectionPath))
+            continue;
+
+        VariantData& variant = variants.emplace_back();
+        variant.KeywordsHash = std::stoull(entry.path().filename().string());
+        nlohmann::json::parse(ReadFileContent(reflectionPath)).get_to(variant.Reflection);
+
+        for (int i = 0; i < ShaderType::COUNT; ++i)
+        {
+            const std::filesystem::path stagePath = entry.path() / GetShaderOutputFilename(static_cast<ShaderType>(i));
+            if (std::filesystem::exists(stagePath))
+                variant.Stages[i] = ReadFileContent(stagePath);
+        }
+    }
+
+    std::sort(variants.begin(), variants.end(), [](const VariantData& a, const VariantData& b){ return a.KeywordsHash < b.KeywordsHash; });
+
+    std::vector<uint8_t> bytes(sizeof(ShaderPackageFormat::Header));
+    std::vector<ShaderPackageFormat::Variant> variantsTable(variants.size());
+
+    for (size_t i = 0; i < variants.size(); ++i)
+    {
+        const VariantData& data = variants[i];
+        ShaderPackageFormat::Variant& variant = variantsTable[i];
+        variant.KeywordsHash = data.KeywordsHash;
+
+        for (uint32_t stage = 0; stage < ShaderPackageFormat::StagesCount; ++stage)
+            variant.Stages[stage] = Append(bytes, data.Stages[stage]);
+
+        std::vector<ShaderPackageFormat::Resource> resources;
+        for (const auto& [name, texture] : data.Reflection.Textures)
+            resources.push_back(CreateResource(bytes, name, ShaderPackageFormat::ResourceType::TEXTURE, texture.Binding, texture.ReadWrite));
+        for (const auto& [name, sampler] : data.Reflection.Samplers)
+            resources.push_back(CreateResource(bytes, name, ShaderPackageFormat::ResourceType::SAMPLER, sampler.Binding, false));
+        for (const auto& [name, buffer] : data.Reflection.Buffers)
+        {
+            std::vector<ShaderPackageFormat::Variable> variables;
+            for (const auto& [variableName, offset] : buffer.Variables)
+                variables.push_back({Append(bytes, variableName), offset});
+
+            ShaderPackageFormat::Resource resource = CreateResource(bytes, name, ShaderPackageFormat::ResourceType::BUFFER, buffer.Binding, buffer.ReadWrite);
+            resource.BufferType = buffer.BufferType;
+            resource.Size = buffer.Size;
+            resource.Variables = Append(bytes, variables);
+            resources.push_back(resource);
+        }
+        variant.Resources = Append(bytes, resources);
+
+        variant.ThreadGroupSize[0] = data.Reflection.ThreadGroupSize.X;
+        variant.ThreadGroupSize[1] = data.Reflection.ThreadGroupSize.Y;
+        variant.ThreadGroupSize[2] = data.Reflection.ThreadGroupSize.Z;
+    }
+
+    ShaderPackageFormat::Header header{};
+    header.Magic = ShaderPackageFormat::Magic;
+    header.Version = ShaderPackageFormat::Version;
+    header.VariantsCount = static_cast<uint32_t>(variantsTable.size());
+    header.VariantsOffset = Append(bytes, variantsTable).Offset;
+    memcpy(bytes.data(), &header, sizeof(header));
+
+    const std::filesystem::path outputPath = backendOutputPath / ShaderPackageFormat::Filename;
+    FILE* fp = fopen(outputPath.string().c_str(), "wb");
+    if (!fp)
+    {
+        std::cout << "Can't open package file: " << outputPath << std::endl;
+        return false;
+    }
+
+    const bool written = fwrite(bytes.data(), bytes.size(), 1, fp) == 1;
+    fclose(fp);
+
+    if (!written)
+    {
+        std::cout << "Can't write package file: " << outputPath << std::endl;
+        return false;
+    }
+
+    std::cout << "Packaged " << variants.size() << " variants to " << outputPath << std::endl;
+    return true;
+}
+
+#endif //RENDER_ENGINE_SHADER_COMPILER_PACKAGE_H
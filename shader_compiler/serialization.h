@@ -53,6 +53,41 @@ void to_json(nlohmann::json& json, const Reflection& reflection)
     };
 }
 
+void from_json(const nlohmann::json& json, BufferDescriptor& bufferDesc)
+{
+    json.at("Size").get_to(bufferDesc.Size);
+    json.at("BufferType").get_to(bufferDesc.BufferType);
+    json.at("ReadWrite").get_to(bufferDesc.ReadWrite);
+    json.at("Binding").get_to(bufferDesc.Binding);
+    json.at("Variables").get_to(bufferDesc.Variables);
+}
+
+void from_json(const nlohmann::json& json, TextureDescriptor& desc)
+{
+    json.at("Binding").get_to(desc.Binding);
+    json.at("ReadWrite").get_to(desc.ReadWrite);
+}
+
+void from_json(const nlohmann::json& json, ResourceDescriptor& desc)
+{
+    json.at("Binding").get_to(desc.Binding);
+}
+
+void from_json(const nlohmann::json& json, ThreadGroupSize& threadGroupSize)
+{
+    json.at("X").get_to(threadGroupSize.X);
+    json.at("Y").get_to(threadGroupSize.Y);
+    json.at("Z").get_to(threadGroupSize.Z);
+}
+
+void from_json(const nlohmann::json& json, Reflection& reflection)
+{
+    json.at("Buffers").get_to(reflection.Buffers);
+    json.at("Textures").get_to(reflection.Textures);
+    json.at("Samplers").get_to(reflection.Samplers);
+    json.at("ThreadGroupSize").get_to(reflection.ThreadGroupSize);
+}
+
 inline void WriteReflection(const std::filesystem::path& outputDirPath, const Reflection& reflection)
 {
     const std::string json = nlohmann::json(reflection).dump();
@@ -156,49 +156,49 @@ namespace TextureCompressorBackend
         return true;
     }
 
-    std::vector<uint32_t> ExtractSizes(const cuttlefish::Texture* texture, const TextureHeader& header, bool isCubemap, uint32_t& outTotalSize)
+    const void* GetPixels(const cuttlefish::Texture* texture, int slice, int mip, bool isCubemap)
     {
+        if (isCubemap)
+            return texture->data(static_cast<cuttlefish::Texture::CubeFace>(slice), mip, 0);
+        return texture->data(mip, 0);
+    }
+
+    uint32_t GetPixelsSize(const cuttlefish::Texture* texture, int slice, int mip, bool isCubemap)
+    {
+        if (isCubemap)
+            return texture->dataSize(static_cast<cuttlefish::Texture::CubeFace>(slice), mip, 0);
+        return texture->dataSize(mip, 0);
+    }
+
+    std::vector<TextureMipRange> ExtractRanges(const cuttlefish::Texture* texture, const TextureHeader& header, bool isCubemap, uint32_t& outTotalSize)
+    {
+        // pixels are placed from the smallest mip to the largest, offsets are counted from the start of the file
+        std::vector<TextureMipRange> ranges(header.Depth * header.MipCount);
+        uint32_t offset = sizeof(TextureHeader) + ranges.size() * sizeof(TextureMipRange);
+
         outTotalSize = 0;
-        std::vector<uint32_t> sizes(header.Depth * header.MipCount);
-        for (int i = 0; i < header.Depth; ++i)
+        for (int j = header.MipCount - 1; j >= 0; --j)
         {
-            for (int j = 0; j < header.MipCount; ++j)
+            for (int i = 0; i < header.Depth; ++i)
             {
-                uint32_t size;
-                if (isCubemap)
-                {
-                    auto face = static_cast<cuttlefish::Texture::CubeFace>(i);
-                    size = texture->dataSize(face, j, 0);
-                }
-                else
-                    size = texture->dataSize(j, 0);
-
-                sizes[i * header.MipCount + j] = size;
+                const uint32_t size = GetPixelsSize(texture, i, j, isCubemap);
+                ranges[i * header.MipCount + j] = {offset, size};
+                offset += size;
                 outTotalSize += size;
             }
         }
-        return sizes;
+        return ranges;
     }
 
-    void ExtractPixelsAndWriteToFile(const cuttlefish::Texture* texture, const std::vector<uint32_t>& sizes, const TextureHeader& header, bool isCubemap, std::ofstream& fout)
+    void ExtractPixelsAndWriteToFile(const cuttlefish::Texture* texture, const std::vector<TextureMipRange>& ranges, const TextureHeader& header, bool isCubemap, std::ofstream& fout)
     {
-        for (int i = 0; i < header.Depth; ++i)
+        for (int j = header.MipCount - 1; j >= 0; --j)
         {
-            for (int j = 0; j < header.MipCount; ++j)
+            for (int i = 0; i < header.Depth; ++i)
             {
-                const void* data;
-                if (isCubemap)
-                {
-                    auto face = static_cast<cuttlefish::Texture::CubeFace>(i);
-                    data = texture->data(face, j, 0);
-                }
-                else
-                {
-                    data = texture->data(j, 0);
-                }
-
-                int size = sizes[i * header.MipCount + j];
-                fout.write(static_cast<const char *>(data), size);
+                const void* data = GetPixels(texture, i, j, isCubemap);
+                const TextureMipRange& range = ranges[i * header.MipCount + j];
+                fout.write(static_cast<const char *>(data), range.Size);
             }
         }
     }
@@ -268,6 +268,7 @@ namespace TextureCompressorBackend
         }
 
         TextureHeader header{};
+        header.Version = TextureHeader::CurrentVersion;
         header.Depth = typeInfo.Count;
         header.Width = images[0]->width();
         header.Height = images[0]->height();
@@ -279,16 +280,16 @@ namespace TextureCompressorBackend
         cuttlefish::Texture* texture = CreateTexture(typeInfo, formatInfo, header, images, data.Mips, isCubemap);
 
         uint32_t totalCompressedSize;
-        std::vector<uint32_t> compressedSizes = ExtractSizes(texture, header, isCubemap, totalCompressedSize);
+        std::vector<TextureMipRange> mipRanges = ExtractRanges(texture, header, isCubemap, totalCompressedSize);
 
         std::filesystem::create_directories(outputPath.parent_path());
 
         std::ofstream fout;
         fout.open(outputPath, std::ios::binary | std::ios::out);
         fout.write(reinterpret_cast<char*>(&header), headerSize);
-        fout.write(reinterpret_cast<char*>(&compressedSizes[0]), compressedSizes.size() * sizeof(uint32_t));
+        fout.write(reinterpret_cast<char*>(&mipRanges[0]), mipRanges.size() * sizeof(TextureMipRange));
 
-        ExtractPixelsAndWriteToFile(texture, compressedSizes, header, isCubemap, fout);
+        ExtractPixelsAndWriteToFile(texture, mipRanges, header, isCubemap, fout);
         fout.close();
 
         Debug::LogInfoFormat("Compressed: {} {} {}", outputPath.string(), formatInfo.Name, GetReadableSize(headerSize + totalCompressedSize));